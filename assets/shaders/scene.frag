@@ -0,0 +1,13 @@
+#version 130
+
+uniform sampler2D f_texture;
+uniform float f_textured; // 0 for untextured geometry
+
+in vec4 colour;
+in vec2 uv;
+
+out vec4 fColor;
+
+void main() {
+	fColor = colour * mix(vec4(1.0f), texture2D(f_texture, uv), f_textured);
+}
@@ -0,0 +1,17 @@
+#version 130
+
+in vec3 sv_position;
+in vec4 sv_colour;
+in vec2 sv_uv;
+
+out vec4 colour;
+out vec2 uv;
+
+uniform mat4 sv_mvp;
+uniform vec4 sv_uvRect; // Atlas rectangle (u0, v0, u1, v1) the mesh UVs are mapped into
+
+void main() {
+	colour = sv_colour;
+	uv = mix(sv_uvRect.xy, sv_uvRect.zw, sv_uv);
+	gl_Position = sv_mvp * vec4(sv_position, 1);
+}
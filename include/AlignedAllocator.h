@@ -0,0 +1,68 @@
+#ifndef ALIGNED_ALLOCATOR_H // If the macro ALIGNED_ALLOCATOR_H is not defined
+#define ALIGNED_ALLOCATOR_H // Define the macro ALIGNED_ALLOCATOR_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For uintptr_t
+#include <new>		// For std::bad_alloc
+
+/**
+ * @file AlignedAllocator.h
+ * @brief Header file for the AlignedAllocator class, a standard allocator honouring over-aligned types.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class AlignedAllocator
+	 * @brief Allocator for standard containers whose elements need more alignment than operator new gives.
+	 *
+	 * Before C++17, std::allocator only guarantees the alignment of max_align_t (usually 16 bytes), so an
+	 * alignas(64) element in a std::vector may still straddle two cache lines. This allocator asks for
+	 * Alignment - 1 extra bytes plus room for the pointer operator new returned, rounds the address up and
+	 * keeps that pointer just before the block to free it.
+	 */
+	template <typename T, size_t Alignment = alignof(T)>
+	class AlignedAllocator
+	{
+	public:
+		typedef T value_type;
+
+		template <typename U>
+		struct rebind
+		{
+			typedef AlignedAllocator<U, Alignment> other;
+		};
+
+		AlignedAllocator() {}
+
+		template <typename U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+		T* allocate(size_t count)
+		{
+			if (count > ((size_t)-1 - Alignment - sizeof(void*)) / sizeof(T))
+				throw std::bad_alloc();
+
+			void* block = ::operator new(count * sizeof(T) + Alignment - 1 + sizeof(void*));
+			const uintptr_t start = (uintptr_t)block + sizeof(void*);
+			void** aligned = (void**)((start + Alignment - 1) & ~(uintptr_t)(Alignment - 1));
+			aligned[-1] = block;
+			return (T*)aligned;
+		}
+
+		void deallocate(T* pointer, size_t)
+		{
+			if (pointer != NULL)
+				::operator delete(((void**)pointer)[-1]);
+		}
+	};
+
+	template <typename T, typename U, size_t Alignment>
+	bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return true; }
+
+	template <typename T, typename U, size_t Alignment>
+	bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return false; }
+}
+
+#endif // ALIGNED_ALLOCATOR_H
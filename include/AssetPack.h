@@ -0,0 +1,116 @@
+#ifndef ASSET_PACK_H // If the macro ASSET_PACK_H is not defined
+#define ASSET_PACK_H // Define the macro ASSET_PACK_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <string>	// For asset paths
+#include <vector>	// For the file list
+
+// Include custom headers
+#include <./include/MappedFile.h> // Pack mapping
+
+/**
+ * @file AssetPack.h
+ * @brief Header file for the AssetPack class, a memory-mapped archive of every game asset.
+ */
+
+namespace gpp
+{
+	/**
+	 * @struct AssetView
+	 * @brief Read-only bytes of one asset, pointing straight into the mapped pack.
+	 */
+	struct AssetView
+	{
+		const unsigned char* data; // First byte, 16 byte aligned
+		size_t size;			   // Size in bytes
+		uint64_t stamp;			   // getFileStamp() of the source file when it was packed
+	};
+
+	/**
+	 * @class AssetPack
+	 * @brief Maps a pack file built by write() and hands out views of its assets without copying.
+	 *
+	 * Layout: header, hash table of (path hash, entry) slots, entry table, path strings, then the
+	 * asset data. Paths are stored as given to write() ("assets/textures/grid.tga"); lookups
+	 * ignore a leading "./".
+	 */
+	class AssetPack
+	{
+	public:
+		AssetPack();
+
+		/**
+		 * @brief Destructor for the AssetPack class, unmaps the pack. Views become invalid.
+		 */
+		~AssetPack();
+
+		/**
+		 * @brief Maps a pack file.
+		 *
+		 * @param filename Path of the pack.
+		 * @return true if the pack was mapped and its header is valid.
+		 */
+		bool open(const std::string& filename);
+
+		/**
+		 * @brief Unmaps the pack.
+		 */
+		void close();
+
+		bool isOpen() const;
+
+		/**
+		 * @brief Looks up an asset.
+		 *
+		 * @param path Path of the asset, e.g. "./assets/textures/grid.tga".
+		 * @param view Filled with the asset's bytes if found.
+		 * @return true if the pack contains the asset.
+		 */
+		bool find(const std::string& path, AssetView& view) const;
+
+		/**
+		 * @brief Writes a pack file.
+		 *
+		 * @param filename Path of the pack to write.
+		 * @param paths Files to add, stored under these paths.
+		 * @return true if every file was added.
+		 */
+		static bool write(const std::string& filename, const std::vector<std::string>& paths);
+
+		/**
+		 * @brief Identifies a version of a file by its modification time and size.
+		 *
+		 * Packed assets keep the stamp of their source file, so caches keyed on stamps
+		 * match whether an asset is read loose or from the pack.
+		 *
+		 * @param filename Path of the file.
+		 * @return The stamp, 0 if the file does not exist.
+		 */
+		static uint64_t getFileStamp(const std::string& filename);
+
+		/**
+		 * @brief Hashes a path (FNV-1a, 64-bit) after removing a leading "./".
+		 *
+		 * @param path Path of the asset.
+		 * @return The hash.
+		 */
+		static uint64_t hashPath(const std::string& path);
+
+		/**
+		 * @brief Getter method for the directory holding the running executable.
+		 *
+		 * @return The directory with a trailing separator, empty if unknown.
+		 */
+		static std::string getExecutableDirectory();
+
+	private:
+		AssetPack(const AssetPack&);
+		AssetPack& operator=(const AssetPack&);
+
+		MappedFile file; // Pack contents
+	};
+}
+
+#endif // ASSET_PACK_H
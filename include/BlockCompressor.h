@@ -0,0 +1,65 @@
+#ifndef BLOCK_COMPRESSOR_H // If the macro BLOCK_COMPRESSOR_H is not defined
+#define BLOCK_COMPRESSOR_H // Define the macro BLOCK_COMPRESSOR_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+
+/**
+ * @file BlockCompressor.h
+ * @brief Header file for the BlockCompressor class, a software BC1/BC3 (DXT1/DXT5) encoder.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class BlockCompressor
+	 * @brief Encodes RGBA8 images into 4x4 blocks of BC1 (opaque) or BC3 (with alpha).
+	 *
+	 * Colour endpoints start at the extremes along the principal axis of the block's colours and are
+	 * refined once by least squares against the chosen indices. Quality is aimed at offline cooking,
+	 * not real time.
+	 */
+	class BlockCompressor
+	{
+	public:
+		static const size_t BC1_BLOCK_BYTES = 8;  // Colour block
+		static const size_t BC3_BLOCK_BYTES = 16; // Alpha block then colour block
+
+		/**
+		 * @brief Getter method for the size of an encoded image.
+		 *
+		 * @param width Image width.
+		 * @param height Image height.
+		 * @param blockBytes BC1_BLOCK_BYTES or BC3_BLOCK_BYTES.
+		 * @return Size in bytes, images smaller than a block still take one.
+		 */
+		static size_t getEncodedSize(int width, int height, size_t blockBytes);
+
+		/**
+		 * @brief Encodes an image as BC1, alpha is ignored.
+		 *
+		 * @param rgba Pixels, 4 bytes per pixel.
+		 * @param width Image width.
+		 * @param height Image height.
+		 * @param out Destination, getEncodedSize(width, height, BC1_BLOCK_BYTES) bytes.
+		 */
+		static void encodeBC1(const unsigned char* rgba, int width, int height, unsigned char* out);
+
+		/**
+		 * @brief Encodes an image as BC3.
+		 *
+		 * @param rgba Pixels, 4 bytes per pixel.
+		 * @param width Image width.
+		 * @param height Image height.
+		 * @param out Destination, getEncodedSize(width, height, BC3_BLOCK_BYTES) bytes.
+		 */
+		static void encodeBC3(const unsigned char* rgba, int width, int height, unsigned char* out);
+
+	private:
+		static void fetchBlock(const unsigned char* rgba, int width, int height, int x, int y, unsigned char block[64]);
+		static void encodeColour(const unsigned char block[64], unsigned char out[8]);
+		static void encodeAlpha(const unsigned char block[64], unsigned char out[8]);
+	};
+}
+
+#endif // BLOCK_COMPRESSOR_H
@@ -0,0 +1,85 @@
+#ifndef CAMERA_H // If the macro CAMERA_H is not defined
+#define CAMERA_H // Define the macro CAMERA_H to prevent multiple inclusions of this header file
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp>					// OpenGL Mathematics
+#include <glm/gtc/matrix_transform.hpp> // Matrix transformations
+
+/**
+ * @file Camera.h
+ * @brief Header file for the Camera class, view and projection matrices rebuilt only when they change.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class Camera
+	 * @brief Caches the view, projection and view projection matrices.
+	 *
+	 * Setters only mark a matrix dirty when a value actually changes, the getters rebuild it on the next
+	 * call. getVersion() moves on whenever the view projection does, so users of it can tell whether
+	 * anything derived from it is stale.
+	 */
+	class Camera
+	{
+	public:
+		Camera();
+
+		/**
+		 * @brief Setter method for the view, as for glm::lookAt().
+		 *
+		 * @param eye Camera position.
+		 * @param target Point looked at.
+		 * @param up Up vector.
+		 */
+		void setLookAt(const glm::vec3& eye, const glm::vec3& target, const glm::vec3& up);
+
+		/**
+		 * @brief Setter method for the projection, as for glm::perspective().
+		 *
+		 * @param fieldOfView Vertical field of view in radians.
+		 * @param aspect Width over height.
+		 * @param zNear Near clip distance.
+		 * @param zFar Far clip distance.
+		 */
+		void setPerspective(float fieldOfView, float aspect, float zNear, float zFar);
+
+		/**
+		 * @brief Setter method for the aspect ratio from a window size, zero sizes are ignored.
+		 *
+		 * @param width Width in pixels.
+		 * @param height Height in pixels.
+		 */
+		void setViewport(unsigned width, unsigned height);
+
+		const glm::mat4& getView();
+		const glm::mat4& getProjection();
+		const glm::mat4& getViewProjection();
+
+		/**
+		 * @brief Getter method for the version of the view projection matrix.
+		 *
+		 * @return A number that changes whenever the view projection does.
+		 */
+		unsigned getVersion();
+
+		float getNear() const;
+		float getFar() const;
+
+	private:
+		void rebuild();
+
+		glm::vec3 eye, target, up;
+		float fieldOfView, aspect, zNear, zFar;
+
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::mat4 viewProjection;
+
+		bool viewDirty;		  // View inputs changed since the view was built
+		bool projectionDirty; // Projection inputs changed since the projection was built
+		unsigned version;	  // Incremented by every rebuild of the view projection
+	};
+}
+
+#endif // CAMERA_H
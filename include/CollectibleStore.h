@@ -0,0 +1,119 @@
+#ifndef COLLECTIBLE_STORE_H // If the macro COLLECTIBLE_STORE_H is not defined
+#define COLLECTIBLE_STORE_H // Define the macro COLLECTIBLE_STORE_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <vector>	// For component arrays
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+// Include custom headers
+#include <./include/SpatialHash.h> // Collectibles by maze cell
+
+/**
+ * @file CollectibleStore.h
+ * @brief Header file for the CollectibleStore class, the live collectibles as contiguous arrays.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class CollectibleStore
+	 * @brief Structure of arrays holding only the collectibles still in the level.
+	 *
+	 * Removing a collectible moves the last one into its place, so loops over the arrays never meet a
+	 * collected one. The store keeps a SpatialHash of its collectibles in step with the moves.
+	 */
+	class CollectibleStore
+	{
+	public:
+		CollectibleStore();
+
+		/**
+		 * @brief Removes every collectible.
+		 */
+		void clear();
+
+		/**
+		 * @brief Reserves room for collectibles about to be added.
+		 *
+		 * @param count Collectibles in total.
+		 */
+		void reserve(size_t count);
+
+		/**
+		 * @brief Adds a collectible, found by collect() after the next build().
+		 *
+		 * @param position Centre of the collectible.
+		 * @param size Half size of its bounding box.
+		 * @param type Level object type.
+		 */
+		void add(const glm::vec3& position, float size, uint32_t type);
+
+		/**
+		 * @brief Indexes the collectibles added since the last build.
+		 */
+		void build();
+
+		/**
+		 * @brief Removes a collectible, moving the last one into its place.
+		 *
+		 * @param index Index below size().
+		 */
+		void remove(uint32_t index);
+
+		/**
+		 * @brief Removes every built collectible whose box overlaps a box, looking only at nearby cells.
+		 *
+		 * @param position Centre of the box.
+		 * @param size Half size of the box.
+		 * @param removed Receives the indices passed to remove(), in order, appended. Replaying them on a
+		 * copy of the store keeps the copy identical. May be NULL.
+		 * @return Number of collectibles removed.
+		 */
+		size_t collect(const glm::vec3& position, float size, std::vector<uint32_t>* removed = NULL);
+
+		size_t size() const;
+		bool empty() const;
+
+		// Component arrays, size() elements each
+		const glm::vec3* getPositions() const;
+		const float* getSizes() const;
+		const uint32_t* getTypes() const;
+
+		/**
+		 * @brief Scatters positions over the free cells of a maze with a Poisson-disk (blue noise) distribution.
+		 *
+		 * Points are spread over the whole maze, across cell borders, so that no two are closer than a
+		 * radius picked for the count (Bridson's algorithm, with a background grid so each test looks at a
+		 * few neighbours only). The radius is measured on a strip of the maze for large counts and corrected
+		 * over at most four full passes, and any surplus of a few percent is dropped at random. Every pass is
+		 * linear in the number of points and maze cells; a million points take one full pass.
+		 * If the margin leaves no room in a cell, the points go to the cell centres.
+		 *
+		 * @param grid Maze cells, grid[x][z], 0 for free.
+		 * @param count Number of positions.
+		 * @param margin Distance kept from the cell borders, for example the half size of a collectible.
+		 * @param seed Seed of the generator, the same seed gives the same positions.
+		 * @param positions Receives the positions (y is 0), appended.
+		 * @return Number of positions appended, 0 if the maze has no free cell.
+		 */
+		static size_t scatter(const std::vector<std::vector<int>>& grid, size_t count, float margin, uint32_t seed,
+							  std::vector<glm::vec3>& positions);
+
+	private:
+		CollectibleStore(const CollectibleStore&);
+		CollectibleStore& operator=(const CollectibleStore&);
+
+		std::vector<glm::vec3> positions;
+		std::vector<float> sizes;
+		std::vector<uint32_t> types;
+
+		SpatialHash cells;			   // Index of each collectible, by maze cell
+		std::vector<uint32_t> nearby; // Scratch for cell queries
+	};
+}
+
+#endif // COLLECTIBLE_STORE_H
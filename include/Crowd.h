@@ -0,0 +1,153 @@
+#ifndef CROWD_H // If the macro CROWD_H is not defined
+#define CROWD_H // Define the macro CROWD_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <vector>	// For component arrays
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+// Include custom headers
+#include <./include/GameObject.h> // Game object types
+#include <./include/JobSystem.h>  // Parallel agent updates
+
+/**
+ * @file Crowd.h
+ * @brief Header file for the Crowd class, maze agents as contiguous arrays stepped across every core.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class Crowd
+	 * @brief Structure of arrays holding NPC and boss agents that head for a goal through the maze.
+	 *
+	 * A breadth first search from the goal cell gives every open cell its distance in steps, rebuilt
+	 * only when the goal moves to another cell. Each update first counts the agents in every cell and
+	 * sorts them by cell, then steps every agent independently, in parallel:
+	 *
+	 * - steering: the agent heads for the centre of the neighbouring cell one step closer to the goal,
+	 *   choosing the least crowded one when several are, and waits instead of entering a full cell;
+	 * - separation: agents in the 3x3 cells around push each other apart;
+	 * - walls: the move is swept through the grid by a GridCollider.
+	 *
+	 * Agents read the positions of the last update and write the next ones into a second array, so the
+	 * result does not depend on the number of workers. The previous positions stay available for
+	 * interpolation.
+	 */
+	class Crowd
+	{
+	public:
+		/**
+		 * @brief Constructor for the Crowd class.
+		 *
+		 * @param radius Half size of an agent, the distance agents keep from walls and half the one they keep from each other.
+		 * @param cellCapacity Agents a cell holds before others wait to enter it.
+		 */
+		explicit Crowd(float radius = 0.15f, unsigned cellCapacity = 4);
+
+		/**
+		 * @brief Setter method for the maze the agents move in. Clears the goal.
+		 *
+		 * @param grid Maze cells, grid[x][z], 1 for a wall. Must outlive the crowd or the next call.
+		 */
+		void setGrid(const std::vector<std::vector<int>>& grid);
+
+		/**
+		 * @brief Removes every agent.
+		 */
+		void clear();
+
+		/**
+		 * @brief Reserves room for agents about to be added.
+		 *
+		 * @param count Agents in total.
+		 */
+		void reserve(size_t count);
+
+		/**
+		 * @brief Adds an agent at rest.
+		 *
+		 * @param position Centre of the agent (y is kept).
+		 * @param type TYPE::NPC or TYPE::BOSS.
+		 * @param speed Top speed in units per second.
+		 * @return Index of the agent.
+		 */
+		uint32_t add(const glm::vec3& position, TYPE type, float speed);
+
+		/**
+		 * @brief Setter method for the point the agents head for, searching the maze when it moved to another cell.
+		 *
+		 * @param position The goal, outside the grid or in a wall to let the agents idle.
+		 */
+		void setGoal(const glm::vec3& position);
+
+		/**
+		 * @brief Steps every agent.
+		 *
+		 * @param step Seconds to advance.
+		 * @param jobs Workers to spread the agents over, NULL to update them on the calling thread.
+		 */
+		void update(float step, JobSystem* jobs = NULL);
+
+		size_t size() const;
+		bool empty() const;
+		unsigned getCellCapacity() const;
+
+		/**
+		 * @brief Getter method for the number of agents in a cell at the last update.
+		 *
+		 * @param x Cell column.
+		 * @param z Cell row.
+		 * @return Agents whose centre was in the cell, 0 outside the grid.
+		 */
+		unsigned getOccupancy(int x, int z) const;
+
+		/**
+		 * @brief Getter method for the distance of a cell from the goal.
+		 *
+		 * @param x Cell column.
+		 * @param z Cell row.
+		 * @return Steps through open cells, -1 for walls, unreachable cells and cells outside the grid.
+		 */
+		int getDistance(int x, int z) const;
+
+		// Component arrays, size() elements each
+		const glm::vec3* getPositions() const;
+		const glm::vec3* getPreviousPositions() const; // Before the last update
+		const glm::vec3* getVelocities() const;
+		const float* getSpeeds() const;
+		const TYPE* getTypes() const;
+
+	private:
+		Crowd(const Crowd&);
+		Crowd& operator=(const Crowd&);
+
+		int getCell(const glm::vec3& position) const;
+		void binAgents();
+		void stepAgents(size_t begin, size_t end, float step);
+
+		const float radius;
+		const unsigned cellCapacity;
+
+		// Components, indexed by agent
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec3> previousPositions;
+		std::vector<glm::vec3> velocities;
+		std::vector<float> speeds;
+		std::vector<TYPE> types;
+
+		// Maze, indexed by cell (x * depth + z)
+		const std::vector<std::vector<int>>* grid;
+		int width, depth;
+		int goal;						  // Goal cell, -1 for none
+		std::vector<int32_t> distances;	  // Steps to the goal, -1 if unreachable
+		std::vector<uint32_t> cellStarts; // First entry of each cell in order, one extra at the end
+		std::vector<uint32_t> order;	  // Agents sorted by cell
+		std::vector<int32_t> agentCells;  // Cell of each agent at the last binning, -1 outside the grid
+	};
+}
+
+#endif // CROWD_H
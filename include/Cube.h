@@ -206,8 +206,8 @@ static const GLfloat normals[] = {
  * Each UV coordinate is represented as a 2-element array.
  */
 
-static GLfloat uvs[2 * 4 * 6] = {
-	// Front Face (other faces populated in initialisation)
+static const GLfloat uvs[2 * 4] = {
+	// Front Face (every face is mapped the same)
 	0.0, 0.0,
 	1.0, 0.0,
 	1.0, 1.0,
@@ -0,0 +1,258 @@
+#ifndef ENTITY_STORE_H // If the macro ENTITY_STORE_H is not defined
+#define ENTITY_STORE_H // Define the macro ENTITY_STORE_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <vector>	// For component arrays
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp>					// OpenGL Mathematics
+#include <glm/gtc/matrix_transform.hpp> // Matrix transformations
+#include <glm/gtc/quaternion.hpp>		// Rotations
+
+// Include custom headers
+#include <./include/GameObject.h> // Game object types
+#include <./include/JobSystem.h>  // Parallel matrix updates
+
+/**
+ * @file EntityStore.h
+ * @brief Header file for the EntityStore class, game objects kept as contiguous component arrays.
+ */
+
+namespace gpp
+{
+	/**
+	 * @struct EntityHandle
+	 * @brief Identifies an entity across moves within the store. A destroyed entity's handle stays invalid
+	 * even after its slot is reused, as the slot's generation has moved on.
+	 */
+	struct EntityHandle
+	{
+		uint32_t slot;
+		uint32_t generation;
+
+		bool operator==(const EntityHandle& other) const { return slot == other.slot && generation == other.generation; }
+		bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+	};
+
+	/**
+	 * @class EntityStore
+	 * @brief Structure of arrays holding every entity's components, densely packed.
+	 *
+	 * Component i of each array belongs to the same entity, so a system touching positions or transforms
+	 * streams through exactly the arrays it uses. Destroying an entity moves the last one into its place;
+	 * handles find entities through a slot table and are unaffected, dense indices are not stable.
+	 *
+	 * Transforms are kept as translation, rotation and uniform scale rather than matrices, 92 bytes per
+	 * entity in all (local and world transforms 32 bytes each), so 100k entities take about 9 MB.
+	 *
+	 * Entities may have a parent, their world transform is then the parent's combined with their local
+	 * one. Changing a local transform only flags the entity, updateMatrices() recomputes the world
+	 * transforms and MVP matrices of flagged entities and their descendants and leaves the rest alone.
+	 * The MVP matrices live in an array of the caller's, not in the store.
+	 */
+	class EntityStore
+	{
+	public:
+		static const EntityHandle INVALID; // Never returned by create()
+
+		/**
+		 * @brief Constructor for the EntityStore class.
+		 *
+		 * @param capacity Entities to reserve room for.
+		 */
+		explicit EntityStore(size_t capacity = 0);
+
+		/**
+		 * @brief Creates a root entity, unrotated and unscaled.
+		 *
+		 * @param type Type of the entity.
+		 * @param position World position.
+		 * @param size Half size of the entity's bounding box.
+		 * @return Handle of the entity.
+		 */
+		EntityHandle create(TYPE type, const glm::vec3& position = glm::vec3(0.0f), float size = 0.5f);
+
+		/**
+		 * @brief Creates entities of one type at once, growing each array a single time.
+		 *
+		 * @param count Number of entities.
+		 * @param type Type of the entities.
+		 * @param positions count world positions.
+		 * @param size Half size shared by the entities.
+		 * @param handles Receives count handles, may be NULL.
+		 */
+		void create(size_t count, TYPE type, const glm::vec3* positions, float size, EntityHandle* handles);
+
+		/**
+		 * @brief Destroys an entity.
+		 *
+		 * @param handle Handle of the entity.
+		 * @return false if the handle was already invalid.
+		 */
+		bool destroy(EntityHandle handle);
+
+		/**
+		 * @brief Destroys entities at once, invalid handles are skipped.
+		 *
+		 * @param handles Handles of the entities.
+		 * @param count Number of handles.
+		 * @return Number of entities destroyed.
+		 */
+		size_t destroy(const EntityHandle* handles, size_t count);
+
+		/**
+		 * @brief Destroys every entity, invalidating all handles.
+		 */
+		void clear();
+
+		bool isAlive(EntityHandle handle) const;
+
+		/**
+		 * @brief Getter method for the dense index of an entity, valid until the next destroy.
+		 *
+		 * @param handle Handle of the entity.
+		 * @return Index into the component arrays, -1 if the handle is invalid.
+		 */
+		int getIndex(EntityHandle handle) const;
+
+		/**
+		 * @brief Getter method for the handle of the entity at a dense index.
+		 *
+		 * @param index Index below size().
+		 * @return Handle of the entity.
+		 */
+		EntityHandle getHandle(size_t index) const;
+
+		/**
+		 * @brief Setter method for the position of an entity, relative to its parent.
+		 *
+		 * @param handle Handle of the entity.
+		 * @param position New local translation.
+		 * @return false if the handle is invalid.
+		 */
+		bool setPosition(EntityHandle handle, const glm::vec3& position);
+
+		/**
+		 * @brief Setter method for the rotation of an entity, relative to its parent.
+		 *
+		 * @param handle Handle of the entity.
+		 * @param rotation New local rotation, normalised.
+		 * @return false if the handle is invalid.
+		 */
+		bool setRotation(EntityHandle handle, const glm::quat& rotation);
+
+		/**
+		 * @brief Setter method for the scale of an entity, relative to its parent.
+		 *
+		 * @param handle Handle of the entity.
+		 * @param scale New local uniform scale.
+		 * @return false if the handle is invalid.
+		 */
+		bool setScale(EntityHandle handle, float scale);
+
+		/**
+		 * @brief Setter method for the parent of an entity. A child whose parent is destroyed becomes a root.
+		 *
+		 * @param handle Handle of the entity.
+		 * @param parent Handle of the parent, INVALID to make the entity a root.
+		 * @return false if either handle is invalid or the parent is the entity or one of its descendants.
+		 */
+		bool setParent(EntityHandle handle, EntityHandle parent);
+
+		/**
+		 * @brief Getter method for the parent of an entity.
+		 *
+		 * @param handle Handle of the entity.
+		 * @return Handle of the parent, INVALID for a root or an invalid handle.
+		 */
+		EntityHandle getParent(EntityHandle handle) const;
+
+		/**
+		 * @brief Recomputes the world transforms and MVP matrices that are out of date.
+		 *
+		 * Only entities whose local transform or an ancestor's changed since the last call get a new
+		 * world transform. When the view projection changed, or mvps does not hold size() matrices, every
+		 * MVP matrix is rebuilt in batches spread over the workers of jobs. Otherwise only the MVP
+		 * matrices of entities whose world transform changed are, one MatrixBatch call per run of
+		 * neighbours.
+		 *
+		 * @param viewProjection Projection times view matrix.
+		 * @param viewProjectionChanged Whether viewProjection differs from the one of the last call.
+		 * @param mvps MVP matrix of each entity, by dense index, kept between calls.
+		 * @param jobs Workers to spread a full rebuild over, NULL to compute it on the calling thread.
+		 * @return Number of MVP matrices recomputed.
+		 */
+		size_t updateMatrices(const glm::mat4& viewProjection, bool viewProjectionChanged, std::vector<glm::mat4>& mvps,
+							  JobSystem* jobs = NULL);
+
+		/**
+		 * @brief Setter method for the shared mesh an entity is drawn with.
+		 *
+		 * Entities store a 2 byte id into a table of the store's distinct meshes, not the mesh itself.
+		 *
+		 * @param handle Handle of the entity.
+		 * @param mesh The mesh, empty for none.
+		 * @return false if the handle is invalid or the store already uses 65535 distinct meshes.
+		 */
+		bool setMesh(EntityHandle handle, const MeshRef& mesh);
+
+		/**
+		 * @brief Getter method for a mesh by id, see getMeshes().
+		 *
+		 * @param id Mesh id of an entity.
+		 * @return The mesh, empty for id 0.
+		 */
+		const MeshRef& getMesh(uint16_t id) const;
+
+		size_t size() const;
+		bool empty() const;
+
+		// Component arrays, size() elements each
+		const glm::vec3* getPositions() const; // Relative to the parent
+		const glm::quat* getRotations() const;
+		const float* getScales() const;
+		float* getSizes();
+		const float* getSizes() const;
+		const TYPE* getTypes() const;
+		const uint16_t* getMeshes() const;
+
+		// World transforms, as of the last updateMatrices()
+		const glm::vec3* getWorldPositions() const;
+		const glm::quat* getWorldRotations() const;
+		const float* getWorldScales() const;
+
+	private:
+		EntityStore(const EntityStore&);
+		EntityStore& operator=(const EntityStore&);
+
+		uint32_t allocateSlot(uint32_t index);
+		void remove(uint32_t index);
+		void updateWorldTransform(uint32_t index);
+		void writeMatrices(const glm::mat4& viewProjection, glm::mat4* out, size_t begin, size_t end) const;
+
+		// Components, indexed densely
+		std::vector<glm::vec3> positions; // Local transform
+		std::vector<glm::quat> rotations;
+		std::vector<float> scales;
+		std::vector<float> sizes;
+		std::vector<TYPE> types;
+		std::vector<glm::vec3> worldPositions; // World transform
+		std::vector<glm::quat> worldRotations;
+		std::vector<float> worldScales;
+		std::vector<EntityHandle> parents;
+		std::vector<uint8_t> flags; // Transform state, see EntityStore.cpp
+		std::vector<uint16_t> meshes; // Index into meshTable
+		std::vector<uint32_t> owners; // Slot of each entity
+
+		std::vector<MeshRef> meshTable; // Distinct meshes in use, 0 is no mesh
+
+		// Slot table, indexed by handle
+		std::vector<uint32_t> indices;	   // Dense index of a live slot
+		std::vector<uint32_t> generations; // Bumped when a slot's entity is destroyed
+		std::vector<uint32_t> freeSlots;   // Slots ready for reuse
+	};
+}
+
+#endif // ENTITY_STORE_H
@@ -0,0 +1,44 @@
+#ifndef FRUSTUM_H // If the macro FRUSTUM_H is not defined
+#define FRUSTUM_H // Define the macro FRUSTUM_H to prevent multiple inclusions of this header file
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+/**
+ * @file Frustum.h
+ * @brief Header file for the Frustum class, used to cull bounding boxes against the camera.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class Frustum
+	 * @brief Six clip planes extracted from a view projection matrix.
+	 */
+	class Frustum
+	{
+	public:
+		Frustum();
+
+		/**
+		 * @brief Constructor extracting the planes from a view projection matrix (Gribb/Hartmann).
+		 *
+		 * @param viewProjection Projection matrix multiplied by the view matrix.
+		 */
+		explicit Frustum(const glm::mat4& viewProjection);
+
+		/**
+		 * @brief Tests an axis aligned bounding box against the frustum.
+		 *
+		 * @param min Minimum corner of the box.
+		 * @param max Maximum corner of the box.
+		 * @return false if the box is completely outside, true otherwise.
+		 */
+		bool intersects(const glm::vec3& min, const glm::vec3& max) const;
+
+	private:
+		glm::vec4 planes[6]; // Left, right, bottom, top, near, far (normal xyz, distance w)
+	};
+}
+
+#endif // FRUSTUM_H
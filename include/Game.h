@@ -24,8 +24,24 @@ const int GAME_OBJECTS	= 2;	// Total Number of GamesObjects
 // Include custom headers
 #include <./include/Debug.h>      // Debugging utilities
 #include <./include/GameObject.h> // Game object class
+#include <./include/EntityStore.h> // Game object storage
+#include <./include/MeshLibrary.h> // Shared meshes
 #include <./include/Maze.h> //includes the maze header
 #include <./include/pointCube.h>//includes pointCubes header
+#include <./include/RenderQueue.h> // Sorted draw packets
+#include <./include/JobSystem.h> // Work-stealing scheduler
+#include <./include/Frustum.h> // View frustum culling
+#include <./include/Camera.h> // Cached view projection
+#include <./include/HUD.h> // Heads-up display
+#include <./include/TextureAtlas.h> // Scene texture atlas
+#include <./include/SceneTextures.h> // Atlas texture list
+#include <./include/AssetPack.h> // Memory-mapped assets
+#include <./include/TextureStreamer.h> // Background texture loading
+#include <./include/TaskGraph.h> // Startup tasks
+#include <./include/Level.h> // Mapped level file
+#include <./include/HotReload.h> // Asset reloading
+#include <./include/CollectibleStore.h> // Live collectibles
+#include <./include/Simulation.h> // Fixed rate gameplay thread
 
 // Using directives to avoid typing std::, sf::, and glm:: prefixes
 using namespace std; // Standard C++ namespace
@@ -62,20 +78,40 @@ public:
     void updateMVPMatrix();
 
 private:
-    std::vector<GameObject*> game_objects; // Declare a vector of GameObject pointers
+    sf::Clock startupClock;      // Started before the window is created, for the time-to-first-frame report
     sf::RenderWindow window;    // SFML RenderWindow for rendering graphics
+    MeshLibrary meshes; // Shared meshes, declared after the window so buffers go before the context
+    EntityStore entities; // Game objects as component arrays
+    std::vector<glm::mat4> entityMVPs; // MVP matrix of each entity, see EntityStore::updateMatrices()
+    EntityHandle player; // Player entity
+    MeshRef cubeMesh; // Shared by every cube shaped object
     Clock clock;                 // SFML Clock for timing
     Time time;                   // SFML Time for time-related operations
     bool isRunning = false;      // Flag to track game state
 
-    Maze maze;
-    glm::vec3 playerPosition;
+    Maze maze; // Generated by a startup task
+    int mazeWidth, mazeHeight;
+    glm::vec3 playerPosition; // Drawn position, interpolated between simulation states
     float playerSpeed;
     float playerSize;
-    void handleInput(float deltaTime);
+    void handleInput();
+
+    Simulation simulation; // Moves the player, the crowd and collects, declared after the maze it reads
+    CollectibleStore collectibles; // Drawn copy of the collectibles still in the level
+    std::vector<uint32_t> collectedIndices; // Removals taken from the simulation
+    std::vector<glm::vec3> agentPositions; // Drawn crowd positions, interpolated between simulation states
+    std::vector<gpp::TYPE> agentTypes; // Type of each crowd agent, fixed once spawned
+    void updateFromSimulation();
     void update(float deltaTime);
-    void renderMaze();
-    void renderPlayer();
+
+    JobSystem jobs; // Workers for startup tasks, culling and matrix updates
+    RenderQueue renderQueue; // Draw packets for the current frame
+    void buildRenderQueue(const glm::mat4& view, const glm::mat4& projection);
+    void executeRenderQueue();
+    void renderHUD();
+
+    Camera camera; // View and projection the scene is drawn with, rebuilt only when they change
+    unsigned cameraVersion; // Camera version the MVP matrices were computed with
 
     //setting up camera
     glm::mat4 viewMatrix; // Camera view matrix
@@ -98,6 +134,45 @@ private:
 
     int points;
 
+    AssetPack assets; // Packed assets, must outlive everything reading from it
+    Level level; // Maze, collectibles and spawns, mapped in place
+    HUD hud; // Retained heads-up display
+    int hudPoints; // Points value the HUD text was built from
+    double rateTime; // Simulation time the rates were last measured at
+    uint64_t rateTick; // Simulation tick the rates were last measured at
+    unsigned rateFrames; // Frames drawn since then
+
+    TextureAtlas atlas; // Every scene texture, selected by layer
+    int wallLayer; // Atlas layer used by the maze walls
+
+    TextureStreamer streamer; // Decodes and uploads textures in the background, declared after what it reads
+    unsigned atlasTexture; // Streamer handle of the atlas
+
+    string vertexSource, fragmentSource; // Scene shader sources in use
+    string reloadedVertexSource, reloadedFragmentSource; // Read by hot reload, used if they build
+    bool buildShaders(const string& vertexShaderSource, const string& fragmentShaderSource);
+
+    TaskGraph startup; // Startup tasks, kept for the report
+    double contextTime; // Milliseconds until the window and GL context were ready
+    double initialiseTime; // Milliseconds until the startup graph finished
+
+    // Startup tasks, see initialise()
+    void openAssets();
+    void openLevel();
+    void initialiseObjects();
+    void initialiseCrowd();
+    void initialiseCamera();
+    void logGpuInformation();
+    void initialiseBuffers();
+    static void buildCubeMesh(std::vector<MeshVertex>& meshVertices, std::vector<uint32_t>& meshIndices);
+    void initialiseShaders();
+    void initialiseTextures();
+    void initialiseRenderState();
+    void reportStartup();
+    void initialiseHotReload();
+
+    HotReload hotReload; // Declared last, its threads stop before what they reload is destroyed
+
     /**
      * @brief Method to initialize the game.
      *
@@ -105,13 +180,6 @@ private:
      */
     void initialise(); // Method to initialize the game
 
-    /**
-     * @brief Method to update the game state.
-     *
-     * This method updates the game logic, including handling user input and updating game objects.
-     */
-    void update(); // Method to update the game state
-
     /**
      * @brief Method to render the game.
      *
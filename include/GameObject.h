@@ -7,8 +7,7 @@
 #endif
 
 // Include necessary headers
-#include <stdio.h>	// For standard input and output operations
-#include <string.h> // For string manipulation (memcpy)
+#include <stdint.h> // For fixed width integer types
 #include <string> 	// For string manipulation
 
 // Include GLM headers for mathematics library
@@ -16,7 +15,7 @@
 #include <glm/gtc/matrix_transform.hpp> // Matrix transformations
 
 // Include custom header
-#include <./include/Cube.h> // Header for Cube class
+#include <./include/MeshLibrary.h> // Shared meshes
 
 // Using directives to avoid typing glm:: prefix
 using namespace glm;
@@ -24,48 +23,42 @@ using namespace std;
 
 namespace gpp
 {
-	// GameObject Type
-	enum class TYPE {
+	// GameObject Type, one byte per entity
+	enum class TYPE : uint8_t {
 		PLAYER,
+		NPC,  // Crowd agent
+		BOSS, // Slower crowd agent
 	};
 
 	/**
 	 * @class GameObject
-	 * @brief Represents a game object with vertex, color, and UV data.
+	 * @brief Represents a game object placed in the scene, drawn with a shared mesh.
+	 *
+	 * Geometry is not copied per object: every object of a kind references the same mesh,
+	 * which lives once in GPU buffers, so an object is a few tens of bytes.
 	 */
 	class GameObject
 	{
 	private:
-		// Cube Elements
-		GLfloat vertex[ARRAY_SIZE(vertices)]; // Array of vertex positions
-		GLfloat colour[ARRAY_SIZE(colours)];  // Array of vertex colours
-		GLfloat uv[ARRAY_SIZE(uvs)];		  // Array of texture coordinates
-		GLfloat index[ARRAY_SIZE(indices)];	  // Array of vertex indices
-
 		// GameObject Attributes
+		MeshRef mesh;  // Shared geometry, may be empty
 		vec3 position; // Position of the game object in 3D space
-		glm::mat4 model;	   // Model Matrix for GameObject
-		mat4 mvp;	   // Model View Project Matrix
+		float size;	   // Half size of the bounding box
 		TYPE type;	   // GameOject Type
 
-		glm::mat4 modelMatrix;
-		glm::mat4 mvpMatrix;
-		float size;
-
 	public:
 		/**
-		 * @brief Default constructor for the GameObject class.
+		 * @brief Constructor for the GameObject class.
 		 *
-		 * Initializes a GameObject by copying vertex, color, and UV data from the Cube class.
-		 * UV data is copied to all faces of the GameObject.
 		 * The position of the GameObject is set to the origin (0, 0, 0).
+		 *
+		 * @param type Type of the game object.
+		 * @param mesh Shared mesh the object is drawn with.
 		 */
-		GameObject(TYPE type);
+		GameObject(TYPE type, const MeshRef& mesh = MeshRef());
 
 		/**
-		 * @brief Destructor for the GameObject class.
-		 *
-		 * This is a default destructor and does not perform any specific cleanup tasks.
+		 * @brief Destructor for the GameObject class, drops the object's reference to its mesh.
 		 */
 		~GameObject();
 
@@ -93,81 +86,18 @@ namespace gpp
 		float getSize() const;
 
 		/**
-		 * @brief Setter method for setting the model of the game object.
-		 *
-		 * @param model The new model of the game object as a mat4 matrix.
-		 */
-		void setModelMatrix(mat4 model);
-
-		/**
-		 * @brief Getter method for retrieving the model view projection of the game object.
-		 *
-		 * @return The model view projection matrix of the game object as a mat4 matrix.
-		 */
-		mat4 getMVPMatrix();
-
-		/**
-		 * @brief Setter method for setting the model view projection of the game object.
-		 *
-		 * @param model The new model view projection of the game object as a mat4 matrix.
-		 */
-		void setMVPMatrix(glm::mat4 mvp);
-
-		/**
-		 * @brief Getter method for retrieving the first element of the vertex array.
-		 *
-		 * @return A pointer to the first element of the vertex array.
-		 */
-		GLfloat *getVertex();
-
-		/**
-		 * @brief Getter method for retrieving the count of vertices.
-		 *
-		 * @return The count of vertices in the vertex array.
-		 */
-		int getVertexCount();
-
-		/**
-		 * @brief Getter method for retrieving the first element of the color array.
-		 *
-		 * @return A pointer to the first element of the color array.
-		 */
-		GLfloat *getColor();
-
-		/**
-		 * @brief Getter method for retrieving the count of colours.
-		 *
-		 * @return The count of colours in the color array.
-		 */
-		int getColorCount();
-
-		/**
-		 * @brief Getter method for retrieving the first element of the UV array.
-		 *
-		 * @return A pointer to the first element of the UV array.
-		 */
-		GLfloat *getUV();
-
-		/**
-		 * @brief Getter method for retrieving the count of UVs.
-		 *
-		 * @return The count of UVs in the UV array.
-		 */
-		int getUVCount();
-
-		/**
-		 * @brief Getter method for retrieving the first element of the index array.
+		 * @brief Getter method for the shared mesh of the game object.
 		 *
-		 * @return A pointer to the first element of the index array.
+		 * @return The mesh, empty if none was set.
 		 */
-		GLfloat *getIndex();
+		const MeshRef& getMesh() const;
 
 		/**
-		 * @brief Getter method for retrieving the count of indices.
+		 * @brief Setter method for the shared mesh of the game object.
 		 *
-		 * @return The count of indices in the index array.
+		 * @param mesh The mesh, shared with every other object using it.
 		 */
-		int getIndexCount();
+		void setMesh(const MeshRef& mesh);
 
 		/**
 		 * @brief method for retrieving enum type as a string.
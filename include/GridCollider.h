@@ -0,0 +1,58 @@
+#ifndef GRID_COLLIDER_H // If the macro GRID_COLLIDER_H is not defined
+#define GRID_COLLIDER_H // Define the macro GRID_COLLIDER_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <vector> // For the grid
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+/**
+ * @file GridCollider.h
+ * @brief Header file for the GridCollider class, boxes swept against the maze walls.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class GridCollider
+	 * @brief Moves axis aligned boxes through the maze grid without passing through walls.
+	 *
+	 * Wall cells fill the unit square [x, x + 1) x [z, z + 1) at every height; cells outside the grid
+	 * are open. A move is swept one axis at a time, the longer first, visiting only the cells the box's
+	 * leading face crosses. The box stops against the first wall on an axis and keeps the other axis's
+	 * movement, so it slides along walls. The result does not depend on the step length: one long step
+	 * ends where many short ones would, and nothing is tunnelled through.
+	 */
+	class GridCollider
+	{
+	public:
+		/**
+		 * @brief Constructor for the GridCollider class.
+		 *
+		 * @param grid Maze cells, grid[x][z], 1 for a wall. Must outlive the collider.
+		 */
+		explicit GridCollider(const std::vector<std::vector<int>>& grid);
+
+		/**
+		 * @brief Moves a box as far as the walls let it, sliding along them.
+		 *
+		 * Walls the box already overlaps are ignored, so a box placed inside one can still leave it.
+		 *
+		 * @param position Centre of the box.
+		 * @param halfExtent Half size of the box on each axis (y is not used).
+		 * @param displacement Movement for this step.
+		 * @return The new centre.
+		 */
+		glm::vec3 move(const glm::vec3& position, const glm::vec3& halfExtent, const glm::vec3& displacement) const;
+
+		bool isWall(int x, int z) const;
+
+	private:
+		float sweep(const glm::vec3& position, const glm::vec3& halfExtent, int axis, float distance) const;
+
+		const std::vector<std::vector<int>>& grid;
+	};
+}
+
+#endif // GRID_COLLIDER_H
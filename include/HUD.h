@@ -0,0 +1,137 @@
+#ifndef HUD_H // If the macro HUD_H is not defined
+#define HUD_H // Define the macro HUD_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <memory> // For swapping fonts
+#include <string> // For string manipulation
+#include <vector> // For vertex storage
+
+// Include OpenGL headers
+#include <GL/glew.h> // OpenGL Extension Wrangler Library
+
+// Include custom headers
+#include <./include/AssetPack.h> // Memory-mapped assets
+#include <./include/SdfFont.h>	 // Distance field glyph atlas
+
+/**
+ * @file HUD.h
+ * @brief Header file for the HUD class, retained heads-up display text drawn from a distance field glyph atlas.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class HUD
+	 * @brief Draws a line of text at any size from one distance field glyph atlas.
+	 *
+	 * The text's vertices live in a buffer object that is only rebuilt when the text changes,
+	 * and the whole line is drawn with a single draw call. One shader thresholds the distance
+	 * field, so changing the size costs no glyph rasterisation.
+	 */
+	class HUD
+	{
+	public:
+		HUD();
+
+		/**
+		 * @brief Destructor for the HUD class, releases the vertex buffer and the shader.
+		 */
+		~HUD();
+
+		/**
+		 * @brief Loads the distance field atlas of the font (baked on first use) and builds the shader.
+		 *
+		 * @param filename Path of the font file.
+		 * @param characterSize Character size in pixels, see setCharacterSize().
+		 * @param pack Asset pack searched before the file system, must outlive the HUD.
+		 * @return true if the font was loaded.
+		 */
+		bool load(const std::string& filename, unsigned characterSize, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief CPU half of load(), reads or bakes the atlas without touching the GL context.
+		 *
+		 * @param filename Path of the font file.
+		 * @param characterSize Character size in pixels, see setCharacterSize().
+		 * @param pack Asset pack searched before the file system, must outlive the HUD.
+		 * @return true if the atlas is ready for upload().
+		 */
+		bool prepare(const std::string& filename, unsigned characterSize, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief GL half of load(), uploads the prepared atlas and builds the shader.
+		 *
+		 * @return true if the HUD can draw.
+		 */
+		bool upload();
+
+		/**
+		 * @brief Reads or bakes the font again into a spare atlas, the drawn atlas is left alone.
+		 *
+		 * Safe to call on a worker thread while the HUD draws, see applyReload().
+		 *
+		 * @param filename Path of the font file.
+		 * @param pack Asset pack searched before the file system.
+		 * @return true if the spare atlas is ready.
+		 */
+		bool prepareReload(const std::string& filename, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief Uploads the atlas from prepareReload() and draws with it from now on. Needs a GL context.
+		 */
+		void applyReload();
+
+		/**
+		 * @brief Setter method for the displayed text, the vertex buffer is rebuilt on the next draw if it changed.
+		 *
+		 * @param text The new text.
+		 */
+		void setText(const std::string& text);
+
+		/**
+		 * @brief Setter method for the character size, any size is drawn from the same atlas.
+		 *
+		 * @param characterSize Character size in pixels.
+		 */
+		void setCharacterSize(unsigned characterSize);
+
+		/**
+		 * @brief Setter method for the top left corner of the text in pixels.
+		 *
+		 * @param x Distance from the left edge of the window.
+		 * @param y Distance from the top edge of the window.
+		 */
+		void setPosition(float x, float y);
+
+		/**
+		 * @brief Draws the text in screen space on top of the scene.
+		 *
+		 * @param screenWidth Width of the window in pixels.
+		 * @param screenHeight Height of the window in pixels.
+		 */
+		void draw(unsigned screenWidth, unsigned screenHeight);
+
+	private:
+		HUD(const HUD&);
+		HUD& operator=(const HUD&);
+
+		void rebuild();
+		bool buildShader();
+
+		std::unique_ptr<SdfFont> font;	   // Distance field glyph atlas
+		std::unique_ptr<SdfFont> reloaded; // Atlas prepared by prepareReload(), waiting for applyReload()
+		unsigned characterSize;		// Character size in pixels
+		float x, y;					// Top left corner in pixels
+		std::string text;			// Displayed text
+		bool loaded;				// Font and atlas are ready
+		bool dirty;					// Text or position changed since the last rebuild
+		GLuint vbo;					// Vertex buffer (x, y, u, v per vertex)
+		GLsizei vertexCount;		// Vertices in the buffer
+		std::vector<GLfloat> vertices; // Staging storage reused between rebuilds
+		GLuint program;				// Distance field shader
+		GLint positionID, uvID;		// Vertex attributes
+		GLint screenID, textureID, colourID; // Uniforms
+	};
+}
+
+#endif // HUD_H
@@ -0,0 +1,116 @@
+#ifndef HOT_RELOAD_H // If the macro HOT_RELOAD_H is not defined
+#define HOT_RELOAD_H // Define the macro HOT_RELOAD_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h>			  // For size_t
+#include <atomic>			  // For stopping the watcher
+#include <condition_variable> // For waking the decode thread
+#include <deque>			  // For the decode and apply queues
+#include <functional>		  // For the reload functions
+#include <map>				  // For watched directories
+#include <memory>			  // For resource ownership
+#include <mutex>			  // For guarding the queues
+#include <string>			  // For paths
+#include <thread>			  // For the watcher and decode threads
+#include <vector>			  // For the resource list
+
+/**
+ * @file HotReload.h
+ * @brief Header file for the HotReload class, assets reloaded while the game runs when their files change.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class HotReload
+	 * @brief Watches asset directories (inotify) and reloads only the resources whose files changed.
+	 *
+	 * A watcher thread maps each written or renamed-over file to the resources registered for it and
+	 * queues them. A decode thread runs their decode functions (reading, baking, compiling on the CPU),
+	 * and update(), called by the render thread between frames, runs the apply function of each resource
+	 * that decoded. Changes arriving while a resource is queued are merged into one reload.
+	 *
+	 * Watching needs inotify (Linux); elsewhere start() fails and the game runs without reloading.
+	 */
+	class HotReload
+	{
+	public:
+		// Prepares the new version off the render thread, false keeps the current version
+		typedef std::function<bool()> DecodeFunction;
+
+		// Swaps the new version in, called on the render thread (may use GL)
+		typedef std::function<void()> ApplyFunction;
+
+		HotReload();
+
+		/**
+		 * @brief Destructor for the HotReload class, stops the threads and drops pending reloads.
+		 */
+		~HotReload();
+
+		/**
+		 * @brief Registers a resource, before start().
+		 *
+		 * @param path File the resource is read from, e.g. "./assets/textures/grid.tga".
+		 * @param decode Run on the decode thread when the file changes, may be empty.
+		 * @param apply Run by update() once decode succeeded.
+		 */
+		void add(const std::string& path, const DecodeFunction& decode, const ApplyFunction& apply);
+
+		/**
+		 * @brief Starts watching directories and their subdirectories.
+		 *
+		 * @param directories Directories to watch, e.g. "./assets".
+		 * @return true if at least one directory is watched.
+		 */
+		bool start(const std::vector<std::string>& directories);
+
+		/**
+		 * @brief Stops the threads, reloads still queued are dropped.
+		 */
+		void stop();
+
+		bool isRunning() const;
+
+		/**
+		 * @brief Applies every reload decoded since the last call. Call between frames.
+		 *
+		 * @return Number of resources swapped in.
+		 */
+		size_t update();
+
+	private:
+		HotReload(const HotReload&);
+		HotReload& operator=(const HotReload&);
+
+		struct Resource
+		{
+			std::string path; // Without a leading "./"
+			DecodeFunction decode;
+			ApplyFunction apply;
+			bool queued;   // Waiting for the decode thread
+			bool busy;	   // Being decoded or waiting for update(), never decoded twice at once
+			bool changed;  // Changed again while busy, queued once applied
+		};
+
+		void watchLoop();
+		void decodeLoop();
+		void addWatch(const std::string& directory);
+		void changed(const std::string& path);
+		void finish(Resource& resource);
+
+		std::vector<std::unique_ptr<Resource> > resources;
+		std::map<int, std::string> watches; // Watch descriptor to directory, watcher thread only once started
+		std::deque<Resource*> decodeQueue;	// Changed, waiting for the decode thread
+		std::deque<Resource*> applyQueue;	// Decoded, waiting for update()
+
+		std::thread watcher;
+		std::thread decoder;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::atomic<bool> stopping;
+		int descriptor; // inotify instance, -1 when not watching
+	};
+}
+
+#endif // HOT_RELOAD_H
@@ -0,0 +1,181 @@
+#ifndef JOB_SYSTEM_H // If the macro JOB_SYSTEM_H is not defined
+#define JOB_SYSTEM_H // Define the macro JOB_SYSTEM_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h>			  // For size_t
+#include <stdint.h>			  // For fixed width integer types
+#include <atomic>			  // For counters and the sleeper count
+#include <condition_variable> // For waking idle workers
+#include <deque>			  // For jobs from other threads
+#include <functional>		  // For job functions
+#include <memory>			  // For per-worker state
+#include <mutex>			  // For guarding sleep and waiting lists
+#include <thread>			  // For worker threads
+#include <vector>			  // For the worker list
+
+// Include custom headers
+#include <./include/WorkStealingDeque.h> // Per-worker job queues
+
+/**
+ * @file JobSystem.h
+ * @brief Header file for the JobSystem class, the engine's work-stealing scheduler.
+ */
+
+namespace gpp
+{
+	struct Job; // Defined in JobSystem.cpp
+
+	/**
+	 * @class JobCounter
+	 * @brief Counts the unfinished jobs of a group. Waiting for a group and starting jobs after it both go
+	 * through its counter.
+	 *
+	 * A counter must outlive its jobs and any job scheduled after it.
+	 */
+	class JobCounter
+	{
+	public:
+		JobCounter();
+
+		/**
+		 * @brief Whether every job counted so far has finished.
+		 *
+		 * @return true if no job is pending.
+		 */
+		bool isDone() const;
+
+	private:
+		JobCounter(const JobCounter&);
+		JobCounter& operator=(const JobCounter&);
+
+		friend class JobSystem;
+
+		std::atomic<size_t> pending; // Jobs scheduled but not finished
+		std::mutex mutex;			 // Guards waiting
+		Job* waiting;				 // Jobs to schedule once pending reaches zero
+	};
+
+	/**
+	 * @class JobSystem
+	 * @brief Runs jobs on a fixed set of workers, each taking work from its own deque and stealing from the
+	 * others' when it runs dry.
+	 *
+	 * Worker 0 is the thread that created the system (the main thread), which only runs jobs while it
+	 * waits in wait() or parallelFor(); the background workers sleep when there is nothing to steal.
+	 * Jobs a worker schedules go on its own deque, so related work stays on one core until another is
+	 * idle. Other threads may schedule and wait as well, their jobs go through a shared queue.
+	 *
+	 * Waiting never blocks a worker: it runs other jobs until the counter drops to zero, so jobs may
+	 * wait for jobs they scheduled. Job functions must not throw.
+	 */
+	class JobSystem
+	{
+	public:
+		// Job function, called with the index of the worker running it
+		typedef std::function<void(unsigned worker)> JobFunction;
+
+		// Range function, called with a half open range [begin, end) and the worker index
+		typedef std::function<void(size_t begin, size_t end, unsigned worker)> RangeFunction;
+
+		/**
+		 * @brief Constructor for the JobSystem class, the calling thread becomes worker 0.
+		 *
+		 * @param threads Number of background threads, 0 uses one less than the hardware thread count.
+		 */
+		explicit JobSystem(unsigned threads = 0);
+
+		/**
+		 * @brief Destructor for the JobSystem class, joins all worker threads. No job may still be pending.
+		 */
+		~JobSystem();
+
+		/**
+		 * @brief Getter method for the number of workers including the main thread.
+		 *
+		 * @return The number of workers, per-worker data needs this many slots.
+		 */
+		unsigned getWorkerCount() const;
+
+		/**
+		 * @brief Getter method for the worker index of the calling thread.
+		 *
+		 * @return The index, -1 if the thread is not a worker of this system.
+		 */
+		int getCurrentWorker() const;
+
+		/**
+		 * @brief Schedules a job.
+		 *
+		 * @param fn Work function, copied.
+		 * @param counter Counter the job is counted on until it finishes, may be NULL.
+		 * @param after Counter the job waits for, it starts once that one is done. May be NULL.
+		 */
+		void run(const JobFunction& fn, JobCounter* counter = NULL, JobCounter* after = NULL);
+
+		/**
+		 * @brief Schedules [0, count) in ranges of at most grain items without waiting.
+		 *
+		 * A range splits off halves onto the deque of the worker running it until it is no larger than
+		 * grain, so idle workers steal the largest pieces first.
+		 *
+		 * @param count Number of items.
+		 * @param grain Maximum number of items per call of fn.
+		 * @param fn Range function, not copied: it must outlive the counter.
+		 * @param counter Counter every range is counted on.
+		 */
+		void parallelFor(size_t count, size_t grain, const RangeFunction& fn, JobCounter& counter);
+
+		/**
+		 * @brief Runs [0, count) in ranges of at most grain items across every worker.
+		 *
+		 * Blocks until every range has been processed, running jobs meanwhile.
+		 *
+		 * @param count Number of items.
+		 * @param grain Maximum number of items per call of fn.
+		 * @param fn Range function.
+		 */
+		void parallelFor(size_t count, size_t grain, const RangeFunction& fn);
+
+		/**
+		 * @brief Runs jobs until every job counted on a counter has finished.
+		 *
+		 * @param counter The counter.
+		 */
+		void wait(JobCounter& counter);
+
+		/**
+		 * @brief Runs one scheduled job on the calling worker, if any can be found.
+		 *
+		 * @return false if there was none, or the calling thread is not a worker.
+		 */
+		bool runPendingJob();
+
+	private:
+		JobSystem(const JobSystem&);
+		JobSystem& operator=(const JobSystem&);
+
+		struct Worker
+		{
+			WorkStealingDeque<Job*> jobs;
+			uint32_t random; // Victim selection state
+		};
+
+		void schedule(Job* job);
+		bool findJob(unsigned worker, Job*& job);
+		void execute(Job* job, unsigned worker);
+		void finish(JobCounter* counter);
+		void workerLoop(unsigned worker);
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::vector<std::thread> threads; // Background threads (workers 1..n)
+
+		std::mutex mutex;
+		std::condition_variable wake; // Signals queued jobs or shutdown
+		std::deque<Job*> shared;	  // Jobs scheduled by threads that are not workers
+		std::atomic<size_t> queued;	  // Jobs in any queue, workers only sleep at zero
+		std::atomic<unsigned> sleepers;
+		bool stopping;
+	};
+}
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,166 @@
+#ifndef LEVEL_H // If the macro LEVEL_H is not defined
+#define LEVEL_H // Define the macro LEVEL_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <string>	// For file names
+#include <vector>	// For level contents when writing
+
+// Include custom headers
+#include <./include/AssetPack.h>  // Memory-mapped assets
+#include <./include/MappedFile.h> // Level mapping
+
+/**
+ * @file Level.h
+ * @brief Header file for the Level class, a memory-mapped level file holding the maze, collectibles and spawns.
+ */
+
+namespace gpp
+{
+	/**
+	 * @enum LEVEL_SECTION
+	 * @brief Sections of a level file, each located through the section table.
+	 */
+	enum class LEVEL_SECTION : uint32_t {
+		MAZE = 1,		  // uint8 cells, column major (cells[x * height + y]), 1 is a wall
+		OBJECT_TYPES = 2, // LevelObjectType
+		COLLECTIBLES = 3, // LevelCollectible
+		SPAWNS = 4,		  // LevelSpawn
+	};
+
+	/**
+	 * @struct LevelObjectType
+	 * @brief Kind of object placed in a level, referenced by index from collectibles and spawns.
+	 */
+	struct LevelObjectType
+	{
+		char name[24]; // Zero terminated, e.g. "player" or "point"
+		float size;	   // Half size of the object's bounding box
+		uint32_t reserved;
+	};
+
+	/**
+	 * @struct LevelCollectible
+	 * @brief Collectible placement.
+	 */
+	struct LevelCollectible
+	{
+		float position[3];
+		uint32_t type; // Index into the object types
+	};
+
+	/**
+	 * @struct LevelSpawn
+	 * @brief Start position of an object.
+	 */
+	struct LevelSpawn
+	{
+		float position[3];
+		uint32_t type; // Index into the object types
+	};
+
+	/**
+	 * @struct LevelData
+	 * @brief Contents of a level, as assembled by a tool before it is written.
+	 */
+	struct LevelData
+	{
+		uint32_t width, height;			   // Maze size in cells
+		std::vector<uint8_t> cells;		   // width * height cells, column major
+		std::vector<LevelObjectType> types;
+		std::vector<LevelCollectible> collectibles;
+		std::vector<LevelSpawn> spawns;
+	};
+
+	/**
+	 * @class Level
+	 * @brief Maps a level file built by write() and hands out its sections without copying.
+	 *
+	 * Layout: header, section table of (id, stride, count, offset), then each section's array at a
+	 * 16 byte aligned offset. Opening validates the table and the type indices, nothing is parsed,
+	 * so the cost does not depend on how many objects the level holds beyond that check.
+	 */
+	class Level
+	{
+	public:
+		static const uint32_t VERSION = 1;
+
+		Level();
+
+		/**
+		 * @brief Destructor for the Level class, unmaps the file. Section pointers become invalid.
+		 */
+		~Level();
+
+		/**
+		 * @brief Maps a level file, closing any level opened before.
+		 *
+		 * @param filename Path of the level.
+		 * @param pack Asset pack searched before the file system, must outlive the level.
+		 * @return true if the level was found and is valid.
+		 */
+		bool open(const std::string& filename, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief Unmaps the level.
+		 */
+		void close();
+
+		bool isOpen() const;
+
+		uint32_t getMazeWidth() const;
+		uint32_t getMazeHeight() const;
+		const uint8_t* getCells() const;
+
+		const LevelObjectType* getObjectTypes() const;
+		size_t getObjectTypeCount() const;
+
+		const LevelCollectible* getCollectibles() const;
+		size_t getCollectibleCount() const;
+
+		const LevelSpawn* getSpawns() const;
+		size_t getSpawnCount() const;
+
+		/**
+		 * @brief Looks up an object type by name.
+		 *
+		 * @param name Name of the type.
+		 * @return Index of the type, -1 if the level has none by that name.
+		 */
+		int findObjectType(const std::string& name) const;
+
+		/**
+		 * @brief Looks up the first spawn of an object type.
+		 *
+		 * @param name Name of the type.
+		 * @return The spawn, NULL if there is none.
+		 */
+		const LevelSpawn* findSpawn(const std::string& name) const;
+
+		/**
+		 * @brief Writes a level file.
+		 *
+		 * @param filename Path of the level to write.
+		 * @param data Contents, the cells must match the size and every type index must be valid.
+		 * @return true if the level was written.
+		 */
+		static bool write(const std::string& filename, const LevelData& data);
+
+	private:
+		Level(const Level&);
+		Level& operator=(const Level&);
+
+		MappedFile file;			// Loose level, unused when the level is packed
+		uint32_t width, height;		// Maze size
+		const uint8_t* cells;
+		const LevelObjectType* types;
+		size_t typeCount;
+		const LevelCollectible* collectibles;
+		size_t collectibleCount;
+		const LevelSpawn* spawns;
+		size_t spawnCount;
+	};
+}
+
+#endif // LEVEL_H
@@ -0,0 +1,59 @@
+#ifndef MAPPED_FILE_H // If the macro MAPPED_FILE_H is not defined
+#define MAPPED_FILE_H // Define the macro MAPPED_FILE_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <string>	// For file names
+
+/**
+ * @file MappedFile.h
+ * @brief Header file for the MappedFile class, a read-only memory mapping of a whole file.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class MappedFile
+	 * @brief Maps a file read-only so its contents can be parsed in place, without reading it into a buffer.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile();
+
+		/**
+		 * @brief Destructor for the MappedFile class, unmaps the file.
+		 */
+		~MappedFile();
+
+		/**
+		 * @brief Maps a file, closing any file mapped before.
+		 *
+		 * @param filename Path of the file.
+		 * @return true if the file exists, is not empty and was mapped.
+		 */
+		bool open(const std::string& filename);
+
+		/**
+		 * @brief Unmaps the file, pointers into it become invalid.
+		 */
+		void close();
+
+		bool isOpen() const;
+		const unsigned char* getData() const;
+		size_t getSize() const;
+
+	private:
+		MappedFile(const MappedFile&);
+		MappedFile& operator=(const MappedFile&);
+
+		const unsigned char* data; // Start of the mapping
+		size_t size;			   // Size of the mapping
+#if defined(_WIN32)
+		void* file;				   // File handle
+		void* mapping;			   // File mapping handle
+#endif
+	};
+}
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,111 @@
+#ifndef MATRIX_BATCH_H // If the macro MATRIX_BATCH_H is not defined
+#define MATRIX_BATCH_H // Define the macro MATRIX_BATCH_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+/**
+ * @file MatrixBatch.h
+ * @brief Header file for the MatrixBatch class, matrix products over whole arrays at once.
+ */
+
+namespace gpp
+{
+	/**
+	 * @enum MATRIX_KERNEL
+	 * @brief Instruction sets the batch kernels are written for.
+	 */
+	enum class MATRIX_KERNEL {
+		SCALAR,	  // glm operator*
+		SSE4,	  // One column per instruction
+		AVX2,	  // Two columns per instruction
+		AVX2_FMA, // Two columns per instruction, fused multiply-add
+	};
+
+	/**
+	 * @class MatrixBatch
+	 * @brief Multiplies arrays of matrices and vectors with the best kernel the CPU supports.
+	 *
+	 * The kernel is chosen once from CPUID (SSE4.1, AVX2, AVX2 with FMA, or glm as a fallback). The
+	 * arrays are read and written as packed column major floats, the layout glm uses, and need not be
+	 * aligned. Outputs must not overlap inputs.
+	 */
+	class MatrixBatch
+	{
+	public:
+		/**
+		 * @brief Multiplies one matrix by an array of matrices, out[i] = a * b[i].
+		 *
+		 * @param a Left hand matrix, for example a view projection.
+		 * @param b count right hand matrices, for example model matrices.
+		 * @param out Receives count products, may be b.
+		 * @param count Number of matrices.
+		 */
+		static void multiply(const glm::mat4& a, const glm::mat4* b, glm::mat4* out, size_t count);
+
+		/**
+		 * @brief Multiplies, in place, matrices spread through an array of structures, m[i] = a * m[i].
+		 *
+		 * @param a Left hand matrix, for example a view projection.
+		 * @param first First right hand matrix, for example &packets[0].mvp.
+		 * @param stride Bytes from one matrix to the next, for example sizeof(DrawPacket).
+		 * @param count Number of matrices.
+		 */
+		static void multiply(const glm::mat4& a, glm::mat4* first, size_t stride, size_t count);
+
+		/**
+		 * @brief Multiplies two arrays of matrices pairwise, out[i] = a[i] * b[i].
+		 *
+		 * @param a count left hand matrices.
+		 * @param b count right hand matrices.
+		 * @param out Receives count products.
+		 * @param count Number of matrices.
+		 */
+		static void multiply(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count);
+
+		/**
+		 * @brief Transforms an array of vectors by one matrix, out[i] = m * v[i].
+		 *
+		 * @param m Matrix.
+		 * @param v count vectors.
+		 * @param out Receives count vectors.
+		 * @param count Number of vectors.
+		 */
+		static void transform(const glm::mat4& m, const glm::vec4* v, glm::vec4* out, size_t count);
+
+		/**
+		 * @brief Getter method for the best kernel this CPU supports.
+		 *
+		 * @return The kernel chosen at startup.
+		 */
+		static MATRIX_KERNEL getBestKernel();
+
+		/**
+		 * @brief Selects the kernel used from now on, for benchmarks. Not safe while other threads multiply.
+		 *
+		 * @param kernel Kernel to use.
+		 * @return false if the CPU does not support it, the kernel is then unchanged.
+		 */
+		static bool setKernel(MATRIX_KERNEL kernel);
+
+		/**
+		 * @brief Getter method for the name of a kernel.
+		 *
+		 * @param kernel Kernel.
+		 * @return "AVX2+FMA", "AVX2", "SSE4" or "scalar".
+		 */
+		static const char* getKernelName(MATRIX_KERNEL kernel);
+
+		/**
+		 * @brief Getter method for the name of the kernel in use.
+		 *
+		 * @return "AVX2+FMA", "AVX2", "SSE4" or "scalar".
+		 */
+		static const char* getKernelName();
+	};
+}
+
+#endif // MATRIX_BATCH_H
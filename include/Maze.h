@@ -6,8 +6,15 @@
 
 class Maze {
 public:
+    Maze();
     Maze(int width, int height);
 
+    // Replaces the grid, safe to call off the render thread before the maze is used
+    void generate(int width, int height);
+
+    // Replaces the grid with cells read from a level file, column major (cells[x * height + y])
+    void load(const unsigned char* cells, int width, int height);
+
     const std::vector<std::vector<int>>& getMaze() const;
 
 
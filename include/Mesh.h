@@ -0,0 +1,102 @@
+#ifndef MESH_H // If the macro MESH_H is not defined
+#define MESH_H // Define the macro MESH_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <string> // For file names
+#include <vector> // For meshes built in code
+
+// Include OpenGL headers
+#include <GL/glew.h> // OpenGL Extension Wrangler Library
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+// Include custom headers
+#include <./include/AssetPack.h> // Memory-mapped assets
+#include <./include/MeshFile.h>	 // Mesh file layout
+
+/**
+ * @file Mesh.h
+ * @brief Header file for the Mesh class, GPU buffers filled straight from a mapped mesh file.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class Mesh
+	 * @brief Vertex and index buffers of one mesh file, drawn with a single call.
+	 *
+	 * The file is mapped (or found in the asset pack) and its streams are handed to glBufferData as
+	 * they are, nothing is parsed or converted at runtime. Positions stay quantized on the GPU, so the
+	 * dequantize matrix has to be applied before the model matrix (see getDequantizeMatrix()).
+	 */
+	class Mesh
+	{
+	public:
+		Mesh();
+
+		/**
+		 * @brief Destructor for the Mesh class, releases the buffers.
+		 */
+		~Mesh();
+
+		/**
+		 * @brief Loads a mesh file into GPU buffers. Needs a GL context.
+		 *
+		 * @param filename Path of the mesh file, see MeshFile::write().
+		 * @param pack Asset pack searched before the file system.
+		 * @return true if the file is valid and the buffers were created.
+		 */
+		bool load(const std::string& filename, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief Quantizes a mesh built in code and loads it into GPU buffers. Needs a GL context.
+		 *
+		 * @param vertices Vertices, only the streams in attributes are kept.
+		 * @param indices Triangle list.
+		 * @param attributes MESH_ATTRIBUTE bits, see MeshFile::encode().
+		 * @return true if the mesh is valid and the buffers were created.
+		 */
+		bool create(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, uint32_t attributes);
+
+		/**
+		 * @brief Draws the mesh with the given attribute locations, -1 skips a stream.
+		 *
+		 * @param positionID Location of a vec3 position.
+		 * @param normalID Location of a vec3 normal.
+		 * @param uvID Location of a vec2 texture coordinate.
+		 * @param colourID Location of a vec4 colour.
+		 */
+		void draw(GLint positionID, GLint normalID = -1, GLint uvID = -1, GLint colourID = -1) const;
+
+		/**
+		 * @brief Getter method for the matrix mapping quantized positions (-1 to 1) to model space.
+		 *
+		 * Normals are stored in model space and must not be transformed by it.
+		 *
+		 * @return Translation to the centre of the bounds times a scale by their half size.
+		 */
+		glm::mat4 getDequantizeMatrix() const;
+
+		bool isLoaded() const;
+		bool hasAttribute(MESH_ATTRIBUTE attribute) const;
+		glm::vec3 getBoundsMin() const;
+		glm::vec3 getBoundsMax() const;
+		unsigned getVertexCount() const;
+		unsigned getIndexCount() const;
+
+	private:
+		Mesh(const Mesh&);
+		Mesh& operator=(const Mesh&);
+
+		void release();
+		bool upload(const unsigned char* data, size_t size);
+		void enable(GLint location, MESH_ATTRIBUTE attribute, GLint size, GLenum type) const;
+
+		MeshHeader header;
+		GLuint vbo; // Interleaved vertices
+		GLuint ibo; // Indices
+	};
+}
+
+#endif // MESH_H
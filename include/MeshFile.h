@@ -0,0 +1,130 @@
+#ifndef MESH_FILE_H // If the macro MESH_FILE_H is not defined
+#define MESH_FILE_H // Define the macro MESH_FILE_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <string>	// For file names
+#include <vector>	// For vertex and index lists
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+/**
+ * @file MeshFile.h
+ * @brief Header file for the binary mesh format: interleaved quantized vertices, 16 or 32 bit indices and bounds.
+ */
+
+namespace gpp
+{
+	/**
+	 * @enum MESH_ATTRIBUTE
+	 * @brief Vertex streams present in a mesh file, combined as bits. Interleaved in this order.
+	 */
+	enum class MESH_ATTRIBUTE : uint32_t {
+		POSITION = 1, // 4 x int16, normalised within the bounds (w is padding)
+		NORMAL = 2,	  // 4 x int8, normalised (w is padding)
+		UV = 4,		  // 2 x half float
+		COLOUR = 8,	  // 4 x uint8, normalised RGBA
+	};
+
+	/**
+	 * @struct MeshHeader
+	 * @brief Header of a mesh file, followed by the vertices and the indices at 16 byte aligned offsets.
+	 */
+	struct MeshHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t attributes;   // MESH_ATTRIBUTE bits
+		uint32_t vertexStride; // Bytes per vertex
+		uint32_t vertexCount;
+		uint32_t indexCount;   // Triangles times 3
+		uint32_t indexSize;	   // 2 or 4 bytes
+		uint32_t reserved;
+		float boundsMin[3];	   // Model space bounds, positions are quantized within them
+		float boundsMax[3];
+		uint64_t vertexOffset; // From the start of the file
+		uint64_t indexOffset;
+	};
+
+	/**
+	 * @struct MeshVertex
+	 * @brief Full precision vertex, as read by an importer before it is written.
+	 */
+	struct MeshVertex
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 uv;
+		glm::vec4 colour;
+	};
+
+	/**
+	 * @class MeshFile
+	 * @brief Writes and validates mesh files. The layout is meant to be mapped and handed to GL as is.
+	 */
+	class MeshFile
+	{
+	public:
+		static const uint32_t VERSION = 1;
+
+		/**
+		 * @brief Quantizes and writes a mesh, 16 bit indices are used when the vertices allow it.
+		 *
+		 * @param filename Path of the mesh file.
+		 * @param vertices Vertices, only the streams in attributes are written.
+		 * @param indices Triangle list.
+		 * @param attributes MESH_ATTRIBUTE bits, POSITION is always written.
+		 * @return true if the file was written.
+		 */
+		static bool write(const std::string& filename, const std::vector<MeshVertex>& vertices,
+						  const std::vector<uint32_t>& indices, uint32_t attributes);
+
+		/**
+		 * @brief Quantizes a mesh into the file layout in memory, as write() would store it.
+		 *
+		 * @param vertices Vertices, only the streams in attributes are written.
+		 * @param indices Triangle list.
+		 * @param attributes MESH_ATTRIBUTE bits, POSITION is always written.
+		 * @param data Receives the file contents.
+		 * @return true if the mesh is valid.
+		 */
+		static bool encode(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+						   uint32_t attributes, std::vector<unsigned char>& data);
+
+		/**
+		 * @brief Checks a mapped mesh file.
+		 *
+		 * @param data Start of the file.
+		 * @param size Size of the file.
+		 * @param header Filled with the header if valid.
+		 * @return true if the header is valid and the streams lie within the file.
+		 */
+		static bool validate(const unsigned char* data, size_t size, MeshHeader& header);
+
+		/**
+		 * @brief Getter method for the bytes per vertex of a set of streams.
+		 *
+		 * @param attributes MESH_ATTRIBUTE bits.
+		 * @return Stride in bytes.
+		 */
+		static uint32_t getStride(uint32_t attributes);
+
+		/**
+		 * @brief Getter method for the offset of a stream within a vertex.
+		 *
+		 * @param attributes MESH_ATTRIBUTE bits of the file.
+		 * @param attribute Stream to locate.
+		 * @return Offset in bytes, or -1 if the stream is absent.
+		 */
+		static int getOffset(uint32_t attributes, MESH_ATTRIBUTE attribute);
+
+		/**
+		 * @brief Converts a float to IEEE half precision, rounding to nearest.
+		 */
+		static uint16_t toHalf(float value);
+	};
+}
+
+#endif // MESH_FILE_H
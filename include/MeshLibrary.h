@@ -0,0 +1,82 @@
+#ifndef MESH_LIBRARY_H // If the macro MESH_LIBRARY_H is not defined
+#define MESH_LIBRARY_H // Define the macro MESH_LIBRARY_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <map>		// For the name table
+#include <memory>	// For shared meshes
+#include <string>	// For mesh names
+#include <vector>	// For meshes built in code
+
+// Include custom headers
+#include <./include/AssetPack.h> // Memory-mapped assets
+#include <./include/Mesh.h>		 // GPU meshes
+
+/**
+ * @file MeshLibrary.h
+ * @brief Header file for the MeshLibrary class, one shared GPU copy of each mesh however many objects use it.
+ */
+
+namespace gpp
+{
+	// Reference to a shared, immutable mesh; the mesh is released with its last reference
+	typedef std::shared_ptr<const Mesh> MeshRef;
+
+	/**
+	 * @class MeshLibrary
+	 * @brief Hands out shared references to meshes by name, loading each only once.
+	 *
+	 * The library only keeps weak references, so a mesh's buffers are released as soon as no object
+	 * uses it and it is loaded again when next asked for. References must be dropped on the thread
+	 * owning the GL context.
+	 */
+	class MeshLibrary
+	{
+	public:
+		MeshLibrary();
+
+		/**
+		 * @brief Getter method for a mesh file, loaded on first use. Needs a GL context.
+		 *
+		 * @param filename Path of the mesh file, also its name.
+		 * @param pack Asset pack searched before the file system.
+		 * @return The shared mesh, empty if it could not be loaded.
+		 */
+		MeshRef load(const std::string& filename, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief Getter method for a mesh built in code, created on first use. Needs a GL context.
+		 *
+		 * @param name Name the mesh is shared under.
+		 * @param vertices Vertices, see Mesh::create().
+		 * @param indices Triangle list.
+		 * @param attributes MESH_ATTRIBUTE bits.
+		 * @return The shared mesh, empty if it is invalid.
+		 */
+		MeshRef create(const std::string& name, const std::vector<MeshVertex>& vertices,
+					   const std::vector<uint32_t>& indices, uint32_t attributes);
+
+		/**
+		 * @brief Getter method for a mesh already in use.
+		 *
+		 * @param name Name of the mesh.
+		 * @return The shared mesh, empty if no object uses it.
+		 */
+		MeshRef find(const std::string& name) const;
+
+		/**
+		 * @brief Getter method for the number of meshes in use, forgetting released ones.
+		 *
+		 * @return Meshes with at least one reference.
+		 */
+		size_t getMeshCount();
+
+	private:
+		MeshLibrary(const MeshLibrary&);
+		MeshLibrary& operator=(const MeshLibrary&);
+
+		std::map<std::string, std::weak_ptr<const Mesh> > meshes;
+	};
+}
+
+#endif // MESH_LIBRARY_H
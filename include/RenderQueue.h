@@ -0,0 +1,181 @@
+#ifndef RENDER_QUEUE_H // If the macro RENDER_QUEUE_H is not defined
+#define RENDER_QUEUE_H // Define the macro RENDER_QUEUE_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stdint.h> // For fixed width integer types
+#include <vector>	// For packet and scratch storage
+
+// Include OpenGL and GLM headers
+#include <GL/glew.h>   // OpenGL Extension Wrangler Library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+// Include custom headers
+#include <./include/AlignedAllocator.h> // Cache line aligned command buffers
+
+/**
+ * @file RenderQueue.h
+ * @brief Header file for the RenderQueue class, a sorted list of draw packets executed once per frame.
+ */
+
+namespace gpp
+{
+	// Render passes, executed in this order
+	enum class PASS : uint8_t {
+		GEOMETRY,	 // Opaque geometry, front-to-back
+		TRANSLUCENT, // Blended geometry, back-to-front
+		HUD,		 // Screen space overlay, submission order
+	};
+
+	// Meshes the renderer knows how to draw
+	enum class MESH : uint16_t {
+		NONE,
+		WALL,	  // Maze wall cell
+		CUBE,	  // Cube placed by DrawPacket::mvp
+		HUD_TEXT, // Heads-up display text
+	};
+
+	/**
+	 * @struct DrawPacket
+	 * @brief Everything needed to issue one draw call.
+	 *
+	 * The key orders packets so that state changes (pass, program, texture, mesh) are
+	 * grouped together and, within a group, opaque geometry is drawn front-to-back.
+	 */
+	struct DrawPacket
+	{
+		uint64_t key;	   // Sort key, see RenderQueue::makeKey()
+		GLuint program;	   // Shader program (0 = none, the packet binds its own)
+		GLuint texture;	   // Texture object (0 = untextured)
+		uint16_t layer;	   // Texture atlas layer
+		MESH mesh;		   // Mesh to draw
+		glm::vec3 colour;  // Vertex colour
+		glm::mat4 mvp;	   // Model view projection, built when recorded
+	};
+
+	/**
+	 * @struct CommandBuffer
+	 * @brief Packets recorded by one worker thread, aligned and padded to its own cache line.
+	 */
+	struct alignas(64) CommandBuffer
+	{
+		std::vector<DrawPacket> packets;
+	};
+
+	/**
+	 * @class RenderQueue
+	 * @brief Collects draw packets for a frame and radix sorts them by their 64-bit key.
+	 *
+	 * Packets are either submitted directly or recorded into per-worker command buffers
+	 * which merge() appends to the queue on the render thread.
+	 *
+	 * Key layout (most significant bit first):
+	 * | pass (2) | program (8) | texture (12) | mesh (12) | depth (24) | unused (6) |
+	 */
+	class RenderQueue
+	{
+	public:
+		static const int PASS_SHIFT = 62;
+		static const int PROGRAM_SHIFT = 54;
+		static const int TEXTURE_SHIFT = 42;
+		static const int MESH_SHIFT = 30;
+		static const int DEPTH_SHIFT = 6;
+		static const uint32_t DEPTH_MAX = (1u << 24) - 1;
+
+		/**
+		 * @brief Builds a sort key from render state and quantized depth.
+		 *
+		 * Program, texture and mesh are truncated to their field width. Truncation only
+		 * affects grouping; the packet keeps the full names for binding.
+		 *
+		 * @param pass Render pass.
+		 * @param program Shader program name.
+		 * @param texture Texture object name.
+		 * @param mesh Mesh to draw.
+		 * @param depth Quantized depth from quantizeDepth().
+		 * @return The 64-bit sort key.
+		 */
+		static uint64_t makeKey(PASS pass, GLuint program, GLuint texture, MESH mesh, uint32_t depth);
+
+		/**
+		 * @brief Quantizes a view space distance into the 24-bit depth field.
+		 *
+		 * Translucent packets invert the value so they sort back-to-front.
+		 *
+		 * @param pass Render pass of the packet.
+		 * @param distance Distance from the camera along the view direction.
+		 * @param zNear Near clip distance.
+		 * @param zFar Far clip distance.
+		 * @return Depth in the range [0, DEPTH_MAX].
+		 */
+		static uint32_t quantizeDepth(PASS pass, float distance, float zNear, float zFar);
+
+		RenderQueue();
+		~RenderQueue();
+
+		/**
+		 * @brief Removes all packets (including recorded ones), keeping the allocated storage for the next frame.
+		 */
+		void clear();
+
+		/**
+		 * @brief Adds a packet to the queue.
+		 *
+		 * @param packet The packet to add, its key must already be set.
+		 */
+		void submit(const DrawPacket& packet);
+
+		/**
+		 * @brief Sets the number of per-worker command buffers.
+		 *
+		 * @param count Number of workers that will record packets.
+		 */
+		void setBufferCount(unsigned count);
+
+		/**
+		 * @brief Getter method for a worker's command buffer.
+		 *
+		 * Each worker must only touch its own buffer while recording.
+		 *
+		 * @param worker Worker index.
+		 * @return The worker's command buffer.
+		 */
+		CommandBuffer& getBuffer(unsigned worker);
+
+		/**
+		 * @brief Appends every command buffer to the queue and empties the buffers.
+		 */
+		void merge();
+
+		/**
+		 * @brief Sorts the packets by key with an LSD radix sort (8 bits per pass).
+		 *
+		 * Passes where every key has the same byte are skipped.
+		 */
+		void sort();
+
+		/**
+		 * @brief Getter method for the number of packets in the queue.
+		 *
+		 * @return The number of packets.
+		 */
+		size_t size() const;
+
+		/**
+		 * @brief Access a packet in sorted order (valid after sort()).
+		 *
+		 * @param i Position in the sorted order.
+		 * @return The packet at that position.
+		 */
+		const DrawPacket& operator[](size_t i) const;
+
+	private:
+		std::vector<DrawPacket> packets; // Packets in submission order
+		std::vector<CommandBuffer, AlignedAllocator<CommandBuffer>> buffers; // Per-worker recorded packets
+		std::vector<uint64_t> keys;		 // Keys being sorted
+		std::vector<uint32_t> order;	 // Packet indices being sorted
+		std::vector<uint64_t> keysTemp;	 // Radix sort scratch
+		std::vector<uint32_t> orderTemp; // Radix sort scratch
+	};
+}
+
+#endif // RENDER_QUEUE_H
@@ -0,0 +1,29 @@
+#ifndef SCENE_TEXTURES_H // If the macro SCENE_TEXTURES_H is not defined
+#define SCENE_TEXTURES_H // Define the macro SCENE_TEXTURES_H to prevent multiple inclusions of this header file
+
+/**
+ * @file SceneTextures.h
+ * @brief Texture list of the scene atlas, shared by the game and the texture cooker.
+ */
+
+namespace gpp
+{
+	// Scene textures, packed into one atlas and selected by layer index (position in this list)
+	const char* const SCENE_TEXTURES[] = {
+		"./assets/textures/grid.tga",
+		"./assets/textures/coordinates.tga",
+		"./assets/textures/cube.tga",
+		"./assets/textures/grid_wip.tga",
+		"./assets/textures/minecraft.tga",
+		"./assets/textures/texture.tga",
+		"./assets/textures/texture_2.tga",
+		"./assets/textures/uvtemplate.tga",
+	};
+
+	const int SCENE_TEXTURE_COUNT = sizeof(SCENE_TEXTURES) / sizeof(SCENE_TEXTURES[0]);
+
+	// Cache of the packed atlas and its mip chain, written by the game or cooked offline
+	const char* const ATLAS_CACHE = "./assets/textures/atlas.mip";
+}
+
+#endif // SCENE_TEXTURES_H
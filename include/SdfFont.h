@@ -0,0 +1,132 @@
+#ifndef SDF_FONT_H // If the macro SDF_FONT_H is not defined
+#define SDF_FONT_H // Define the macro SDF_FONT_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <string>	// For file names
+#include <vector>	// For glyph, kerning and pixel storage
+
+// Include OpenGL headers
+#include <GL/glew.h> // OpenGL Extension Wrangler Library
+
+// Include custom headers
+#include <./include/AssetPack.h> // Memory-mapped assets
+
+/**
+ * @file SdfFont.h
+ * @brief Header file for the SdfFont class, a signed distance field glyph atlas baked once and cached on disk.
+ */
+
+namespace gpp
+{
+	/**
+	 * @struct SdfGlyph
+	 * @brief Metrics of one glyph at the font's base size, the quad includes the distance field padding.
+	 */
+	struct SdfGlyph
+	{
+		float advance;		   // Horizontal pen advance
+		float left, top;	   // Quad offset from the pen position on the baseline
+		float width, height;   // Quad size
+		float u0, v0, u1, v1;  // Quad texture coordinates in the atlas
+	};
+
+	/**
+	 * @class SdfFont
+	 * @brief Printable ASCII glyphs stored as distance to the outline, so one atlas serves every text size.
+	 *
+	 * The atlas is baked from the font (rasterised once by SFML at the base size) and cached next to it as
+	 * font + ".sdf". Later runs read the cache, or the copy in the asset pack, while the font is unchanged
+	 * and never rasterise a glyph. Texel value 128 is the outline, higher is inside; the full range covers
+	 * twice the spread in base size pixels.
+	 */
+	class SdfFont
+	{
+	public:
+		static const unsigned FIRST_GLYPH = 32;	 // Space
+		static const unsigned LAST_GLYPH = 126; // Tilde
+
+		/**
+		 * @brief Constructor for the SdfFont class.
+		 *
+		 * @param baseSize Character size in pixels the glyphs are baked at.
+		 * @param spread Distance in base size pixels covered by the field on either side of the outline.
+		 */
+		explicit SdfFont(unsigned baseSize = 48, unsigned spread = 6);
+
+		/**
+		 * @brief Destructor for the SdfFont class, releases the atlas texture.
+		 */
+		~SdfFont();
+
+		/**
+		 * @brief Reads the cached atlas or bakes it from the font, then uploads it. Needs a GL context.
+		 *
+		 * @param filename Path of the font file.
+		 * @param pack Asset pack searched before the file system.
+		 * @return true if the atlas is ready.
+		 */
+		bool load(const std::string& filename, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief Reads the cached atlas or bakes it from the font, without touching the GL context.
+		 *
+		 * Safe to call on a worker thread (SFML rasterises with a context of its own when baking).
+		 *
+		 * @param filename Path of the font file.
+		 * @param pack Asset pack searched before the file system.
+		 * @return true if the atlas is ready to upload.
+		 */
+		bool prepare(const std::string& filename, const AssetPack* pack = NULL);
+
+		/**
+		 * @brief Uploads the prepared atlas and releases its pixels. Needs a GL context.
+		 */
+		void upload();
+
+		bool isLoaded() const;
+
+		/**
+		 * @brief Getter method for the metrics of a glyph.
+		 *
+		 * @param character Character code.
+		 * @return The glyph, or NULL outside FIRST_GLYPH..LAST_GLYPH.
+		 */
+		const SdfGlyph* getGlyph(unsigned character) const;
+
+		/**
+		 * @brief Getter method for the kerning between two characters at the base size.
+		 *
+		 * @param first Character on the left.
+		 * @param second Character on the right.
+		 * @return Offset added to the pen position, 0 if either is out of range.
+		 */
+		float getKerning(unsigned first, unsigned second) const;
+
+		unsigned getBaseSize() const;
+		unsigned getSpread() const;
+		float getLineSpacing() const;
+		GLuint getTexture() const;
+
+	private:
+		SdfFont(const SdfFont&);
+		SdfFont& operator=(const SdfFont&);
+
+		bool bake(const std::string& filename, const AssetView* packed);
+		bool loadCache(const unsigned char* memory, size_t size, uint64_t stamp);
+		bool loadCache(const std::string& path, uint64_t stamp);
+		bool saveCache(const std::string& path, uint64_t stamp) const;
+
+		unsigned baseSize;
+		unsigned spread;
+		float lineSpacing;
+		int width, height;				   // Atlas size
+		std::vector<SdfGlyph> glyphs;	   // FIRST_GLYPH..LAST_GLYPH
+		std::vector<float> kerning;		   // Glyph count squared, row is the first character
+		std::vector<unsigned char> pixels; // Distance field, released once uploaded
+		GLuint texture;
+	};
+}
+
+#endif // SDF_FONT_H
@@ -0,0 +1,194 @@
+#ifndef SIMULATION_H // If the macro SIMULATION_H is not defined
+#define SIMULATION_H // Define the macro SIMULATION_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <atomic>	// For the stop flag and input
+#include <chrono>	// For the tick clock
+#include <mutex>	// For guarding the collected log
+#include <thread>	// For the simulation thread
+#include <vector>	// For the maze grid and collected log
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+// Include custom headers
+#include <./include/CollectibleStore.h> // Live collectibles
+#include <./include/Crowd.h>			// NPCs and bosses
+#include <./include/JobSystem.h>		// Parallel crowd updates
+#include <./include/TripleBuffer.h>		// Snapshot hand over
+
+/**
+ * @file Simulation.h
+ * @brief Header file for the Simulation class, the gameplay stepped at a fixed rate on its own thread.
+ */
+
+namespace gpp
+{
+	/**
+	 * @enum SIMULATION_INPUT
+	 * @brief Movement keys held, as bits passed to Simulation::setInput().
+	 */
+	enum class SIMULATION_INPUT : uint32_t
+	{
+		FORWARD = 1,
+		BACK = 2,
+		LEFT = 4,
+		RIGHT = 8
+	};
+
+	/**
+	 * @struct SimulationState
+	 * @brief Gameplay state after a tick.
+	 */
+	struct SimulationState
+	{
+		glm::vec3 playerPosition;
+		int points;
+	};
+
+	/**
+	 * @struct SimulationSnapshot
+	 * @brief The two latest states, published together so the render thread can interpolate between them.
+	 */
+	struct SimulationSnapshot
+	{
+		SimulationState previous; // State after tick - 1
+		SimulationState current;  // State after tick
+		uint64_t tick;			  // Ticks simulated
+		double time;			  // Seconds after start() that current belongs to, tick * step
+
+		std::vector<glm::vec3> previousAgents; // Crowd positions after tick - 1
+		std::vector<glm::vec3> agents;		   // Crowd positions after tick
+	};
+
+	/**
+	 * @class Simulation
+	 * @brief Moves the player and the crowd and collects collectibles at a fixed rate, however fast frames are drawn.
+	 *
+	 * The simulation thread owns the gameplay state and publishes an immutable snapshot through a
+	 * TripleBuffer after every batch of ticks; neither thread ever waits for the other. When the thread
+	 * falls behind it runs a few ticks back to back and then drops the rest of the backlog rather than
+	 * spiralling.
+	 *
+	 * The collectible store and the crowd belong to the simulation once started. The indices the store
+	 * removes are logged so the render thread can keep a copy of it in step, see takeCollected(). The
+	 * crowd chases the player and is stepped across the workers of a JobSystem.
+	 */
+	class Simulation
+	{
+	public:
+		/**
+		 * @brief Constructor for the Simulation class.
+		 *
+		 * @param rate Ticks per second.
+		 */
+		explicit Simulation(double rate = 60.0);
+
+		/**
+		 * @brief Destructor for the Simulation class, stops the thread.
+		 */
+		~Simulation();
+
+		/**
+		 * @brief Getter method for the simulated collectibles, filled and built before start().
+		 *
+		 * @return The store.
+		 */
+		CollectibleStore& getCollectibles();
+
+		/**
+		 * @brief Getter method for the crowd, filled before start().
+		 *
+		 * @return The crowd.
+		 */
+		Crowd& getCrowd();
+
+		/**
+		 * @brief Publishes the initial state and starts the simulation thread.
+		 *
+		 * @param grid Maze cells, grid[x][z], unchanged until stop().
+		 * @param playerPosition Initial player position.
+		 * @param playerSpeed Player speed in units per second.
+		 * @param playerSize Size of the player's cube.
+		 * @param jobs Workers to step the crowd on, NULL to step it on the simulation thread.
+		 */
+		void start(const std::vector<std::vector<int>>& grid, const glm::vec3& playerPosition, float playerSpeed,
+				   float playerSize, JobSystem* jobs = NULL);
+
+		/**
+		 * @brief Stops the simulation thread, the last snapshot stays readable.
+		 */
+		void stop();
+
+		bool isRunning() const;
+
+		/**
+		 * @brief Setter method for the movement keys held, read at the next tick. Any thread.
+		 *
+		 * @param input SIMULATION_INPUT bits.
+		 */
+		void setInput(uint32_t input);
+
+		/**
+		 * @brief Getter method for the latest snapshot. Render thread only.
+		 *
+		 * @return The snapshot, valid until the next call.
+		 */
+		const SimulationSnapshot& getSnapshot();
+
+		/**
+		 * @brief Takes the indices removed from the collectible store since the last call. Render thread only.
+		 *
+		 * @param indices Receives the indices in removal order, replaced.
+		 * @return Number of indices.
+		 */
+		size_t takeCollected(std::vector<uint32_t>& indices);
+
+		/**
+		 * @brief Getter method for the time on the snapshot clock.
+		 *
+		 * @return Seconds since start().
+		 */
+		double getTime() const;
+
+		/**
+		 * @brief Getter method for the tick length.
+		 *
+		 * @return Seconds per tick.
+		 */
+		double getStep() const;
+
+	private:
+		Simulation(const Simulation&);
+		Simulation& operator=(const Simulation&);
+
+		void simulationLoop();
+		void tick();
+
+		const double step; // Seconds per tick
+		std::chrono::steady_clock::time_point epoch; // Time of start()
+		std::thread thread;
+		std::atomic<bool> stopping;
+		std::atomic<uint32_t> input; // SIMULATION_INPUT bits
+
+		// Owned by the simulation thread while running
+		const std::vector<std::vector<int>>* grid;
+		float playerSpeed;
+		float playerSize;
+		SimulationState state;
+		uint64_t ticks;
+		CollectibleStore collectibles;
+		std::vector<uint32_t> removed; // Indices removed during the current tick
+		Crowd crowd;
+		JobSystem* jobs;
+
+		TripleBuffer<SimulationSnapshot> snapshots;
+
+		std::mutex mutex;				// Guards collected
+		std::vector<uint32_t> collected; // Removed indices not yet taken
+	};
+}
+
+#endif // SIMULATION_H
@@ -0,0 +1,112 @@
+#ifndef SPATIAL_HASH_H // If the macro SPATIAL_HASH_H is not defined
+#define SPATIAL_HASH_H // Define the macro SPATIAL_HASH_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <vector>	// For buckets
+
+// Include GLM headers for mathematics library
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+/**
+ * @file SpatialHash.h
+ * @brief Header file for the SpatialHash class, objects bucketed by the maze cell they are in.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class SpatialHash
+	 * @brief Finds the objects near a box by looking only at the cells the box overlaps.
+	 *
+	 * Objects are keyed on the maze cell (one unit square on the ground plane, cell x covering [x, x + 1))
+	 * their centre is in, hashed so cells outside the maze work too. insert() then build() lays the
+	 * entries out bucket by bucket in one array. A query visits a fixed number of cells for a given box
+	 * and object size, so its cost does not grow with the number of objects, only with how many share
+	 * those cells. Built objects can be removed or given a new id in place; objects do not move.
+	 */
+	class SpatialHash
+	{
+	public:
+		/**
+		 * @brief Constructor for the SpatialHash class.
+		 *
+		 * @param cellSize Side of a cell, the maze uses 1.
+		 */
+		explicit SpatialHash(float cellSize = 1.0f);
+
+		/**
+		 * @brief Removes every object.
+		 */
+		void clear();
+
+		/**
+		 * @brief Adds an object, found by queries after the next build().
+		 *
+		 * @param id Value handed back by queries, for example an index.
+		 * @param position Centre of the object.
+		 * @param size Half size of the object, queries are widened by the largest.
+		 */
+		void insert(uint32_t id, const glm::vec3& position, float size);
+
+		/**
+		 * @brief Sorts the inserted objects into their buckets.
+		 */
+		void build();
+
+		/**
+		 * @brief Removes a built object, by swapping it with the last object of its bucket.
+		 *
+		 * @param id Id of the object.
+		 * @param position Centre it was inserted with.
+		 * @return false if no built object has that id in that cell.
+		 */
+		bool remove(uint32_t id, const glm::vec3& position);
+
+		/**
+		 * @brief Changes the id of a built object, for owners that move their objects around in memory.
+		 *
+		 * @param id Current id of the object.
+		 * @param newId New id.
+		 * @param position Centre it was inserted with.
+		 * @return false if no built object has that id in that cell.
+		 */
+		bool rename(uint32_t id, uint32_t newId, const glm::vec3& position);
+
+		/**
+		 * @brief Finds the objects whose cell could hold an object overlapping a box on the ground plane.
+		 *
+		 * Candidates are only filtered by cell, the caller runs the exact overlap test.
+		 *
+		 * @param min Minimum corner of the box (y is ignored).
+		 * @param max Maximum corner of the box (y is ignored).
+		 * @param ids Receives the ids of the candidates, appended.
+		 * @return Number of ids appended.
+		 */
+		size_t query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& ids) const;
+
+		size_t size() const;
+
+	private:
+		struct Entry
+		{
+			int32_t x, z; // Cell
+			uint32_t id;
+		};
+
+		size_t bucketOf(int32_t x, int32_t z) const;
+		int32_t cellOf(float coordinate) const;
+		int find(uint32_t id, const glm::vec3& position) const;
+
+		float cellSize;
+		float largestSize;			  // Largest half size inserted, the reach of an object beyond its cell
+		std::vector<Entry> entries;	  // Grouped by bucket after build(), then inserted since
+		std::vector<uint32_t> starts; // First entry of each bucket, one extra where the inserted since begin
+		std::vector<uint32_t> counts; // Live entries of each bucket, removed ones are past the count
+		size_t mask;				  // Bucket count minus one, a power of two
+		size_t live;				  // Objects inserted and not removed
+	};
+}
+
+#endif // SPATIAL_HASH_H
@@ -0,0 +1,143 @@
+#ifndef TASK_GRAPH_H // If the macro TASK_GRAPH_H is not defined
+#define TASK_GRAPH_H // Define the macro TASK_GRAPH_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <chrono>			  // For task timing
+#include <condition_variable> // For waking the main thread
+#include <deque>			  // For the MAIN ready queue
+#include <exception>		  // For forwarding task failures
+#include <functional>		  // For the task function
+#include <mutex>			  // For guarding the graph state
+#include <string>			  // For task names
+#include <vector>			  // For the task list
+
+// Include custom headers
+#include <./include/JobSystem.h> // Worker threads
+
+/**
+ * @file TaskGraph.h
+ * @brief Header file for the TaskGraph class, dependent tasks spread over a thread pool and the main thread.
+ */
+
+namespace gpp
+{
+	/**
+	 * @enum AFFINITY
+	 * @brief Threads a task may run on.
+	 */
+	enum class AFFINITY {
+		ANY,  // Any worker, for CPU-only work
+		MAIN, // The thread calling run(), for work needing the GL context
+	};
+
+	/**
+	 * @struct TaskTiming
+	 * @brief When and where a task ran, in milliseconds since run() started.
+	 */
+	struct TaskTiming
+	{
+		double start;
+		double end;
+		unsigned worker; // JobSystem worker index, 0 is the main thread
+	};
+
+	/**
+	 * @class TaskGraph
+	 * @brief Runs tasks as soon as their dependencies have finished, across every worker of a JobSystem.
+	 *
+	 * Dependencies must be added before their dependents, so the graph cannot contain a cycle. ANY tasks
+	 * become jobs once ready. MAIN tasks are only picked up by the calling thread, which also runs jobs
+	 * while it has nothing else to do.
+	 */
+	class TaskGraph
+	{
+	public:
+		typedef std::function<void()> TaskFunction;
+
+		TaskGraph();
+
+		/**
+		 * @brief Adds a task.
+		 *
+		 * @param name Name shown in the report.
+		 * @param affinity Threads the task may run on.
+		 * @param fn Work function.
+		 * @param dependencies Tasks that must finish first.
+		 * @return Handle of the task, for use as a dependency.
+		 */
+		unsigned add(const std::string& name, AFFINITY affinity, const TaskFunction& fn,
+					 const std::vector<unsigned>& dependencies = std::vector<unsigned>());
+
+		/**
+		 * @brief Runs every task and blocks until all have finished.
+		 *
+		 * The first exception thrown by a task stops further tasks from starting and is rethrown here
+		 * once the running ones have finished. Must be called from worker 0, the main thread.
+		 *
+		 * @param jobs Workers to run ANY tasks on.
+		 */
+		void run(JobSystem& jobs);
+
+		/**
+		 * @brief Getter method for the number of tasks added.
+		 *
+		 * @return The number of tasks, handles run from 0 to this value.
+		 */
+		unsigned getTaskCount() const;
+
+		/**
+		 * @brief Getter method for the timing of a task in the last run().
+		 *
+		 * @param task Handle returned by add().
+		 * @return The timing, zero if the task did not run.
+		 */
+		const TaskTiming& getTiming(unsigned task) const;
+
+		/**
+		 * @brief Getter method for the duration of the last run().
+		 *
+		 * @return Milliseconds.
+		 */
+		double getElapsed() const;
+
+		/**
+		 * @brief Formats the timing of every task of the last run(), in start order.
+		 *
+		 * @return One line per task: name, thread, start, duration.
+		 */
+		std::string getReport() const;
+
+	private:
+		TaskGraph(const TaskGraph&);
+		TaskGraph& operator=(const TaskGraph&);
+
+		struct Task
+		{
+			std::string name;
+			AFFINITY affinity;
+			TaskFunction fn;
+			std::vector<unsigned> dependents; // Tasks waiting on this one
+			unsigned dependencies;			  // Number of tasks this one waits on
+			unsigned remaining;				  // Dependencies not finished in the current run
+			TaskTiming timing;
+		};
+
+		typedef std::chrono::steady_clock TaskClock;
+
+		void schedule(const std::vector<unsigned>& ready);
+		void runTask(unsigned handle, unsigned worker);
+		double millisecondsSince(const TaskClock::time_point& time) const;
+
+		std::vector<Task> tasks;
+		JobSystem* jobs;				// Workers of the current run
+		std::deque<unsigned> readyMain; // MAIN tasks whose dependencies have finished
+		size_t outstanding;				// Tasks ready or running in the current run
+		std::exception_ptr failure;		// First exception thrown in the current run
+		std::mutex mutex;
+		std::condition_variable wake;	// Signals new MAIN tasks or the end of the run
+		TaskClock::time_point started;
+		double elapsed;
+	};
+}
+
+#endif // TASK_GRAPH_H
@@ -0,0 +1,191 @@
+#ifndef TEXTURE_H // If the macro TEXTURE_H is not defined
+#define TEXTURE_H // Define the macro TEXTURE_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <string>	// For file names
+#include <vector>	// For level storage
+
+// Include OpenGL headers
+#include <GL/glew.h> // OpenGL Extension Wrangler Library
+
+/**
+ * @file Texture.h
+ * @brief Header file for the MipChain class, a gamma-correct mipmap chain built on the CPU at load time.
+ */
+
+namespace gpp
+{
+	// Downsampling filter used between mip levels
+	enum class MIP_FILTER {
+		BOX,	// 2x2 average
+		KAISER, // Separable Kaiser windowed sinc, sharper distant detail
+	};
+
+	// Storage format of every level of a mip chain
+	enum class TEXTURE_FORMAT : int32_t {
+		RGBA8, // Uncompressed, 4 bytes per pixel
+		BC1,   // DXT1, 8 bytes per 4x4 block, opaque
+		BC3,   // DXT5, 16 bytes per 4x4 block, with alpha
+	};
+
+	/**
+	 * @class MipChain
+	 * @brief Every mip level of an image, stored contiguously from level 0 down to 1x1.
+	 *
+	 * Colour channels are filtered in linear space (sRGB decoded), alpha is filtered as is.
+	 * The chain is cached next to the source image so later loads skip the filtering. Cached chains
+	 * may be block compressed by the texture cooker, they are uploaded without decompressing.
+	 */
+	class MipChain
+	{
+	public:
+		MipChain();
+
+		/**
+		 * @brief Loads an image, from its cached chain if it is up to date, otherwise decodes and filters it.
+		 *
+		 * A rebuilt chain is written back to the cache (filename + ".mip").
+		 *
+		 * @param filename Path of the source image.
+		 * @param filter Downsampling filter used if the chain has to be built.
+		 * @return true if the chain is ready to upload.
+		 */
+		bool load(const std::string& filename, MIP_FILTER filter = MIP_FILTER::BOX);
+
+		/**
+		 * @brief Builds the full chain from a level 0 image.
+		 *
+		 * @param rgba Level 0 pixels, 4 bytes per pixel.
+		 * @param width Width of level 0.
+		 * @param height Height of level 0.
+		 * @param filter Downsampling filter.
+		 * @param maxLevels Maximum number of levels including level 0, 0 builds down to 1x1.
+		 */
+		void build(const unsigned char* rgba, int width, int height, MIP_FILTER filter = MIP_FILTER::BOX, int maxLevels = 0);
+
+		/**
+		 * @brief Block compresses every level of an RGBA8 chain.
+		 *
+		 * @param format BC1 or BC3.
+		 * @return false if the chain is empty or already compressed.
+		 */
+		bool compress(TEXTURE_FORMAT format);
+
+		/**
+		 * @brief Checks level 0 of an RGBA8 chain for pixels that are not fully opaque.
+		 *
+		 * @return true if BC3 is needed to keep the alpha.
+		 */
+		bool hasAlpha() const;
+
+		/**
+		 * @brief Reads a cached chain.
+		 *
+		 * @param path Cache file.
+		 * @param stamp Stamp of the source image, see getFileStamp().
+		 * @return false if the cache is missing, corrupt or stale.
+		 */
+		bool loadCache(const std::string& path, uint64_t stamp);
+
+		/**
+		 * @brief Reads a cached chain in place, without copying the pixels.
+		 *
+		 * @param memory Cache file contents, must stay valid while the chain is used.
+		 * @param size Size of the contents in bytes.
+		 * @param stamp Stamp of the source image, see getFileStamp().
+		 * @return false if the cache is corrupt or stale.
+		 */
+		bool loadCache(const unsigned char* memory, size_t size, uint64_t stamp);
+
+		/**
+		 * @brief Writes the chain to a cache file.
+		 *
+		 * @param path Cache file.
+		 * @param stamp Stamp of the source image, see getFileStamp().
+		 * @return true if the file was written.
+		 */
+		bool saveCache(const std::string& path, uint64_t stamp) const;
+
+		/**
+		 * @brief Uploads every level into a texture object and enables trilinear filtering.
+		 *
+		 * Compressed levels go through glCompressedTexImage2D as stored.
+		 *
+		 * @param texture Texture object to fill, bound to GL_TEXTURE_2D on return.
+		 */
+		void upload(GLuint texture) const;
+
+		/**
+		 * @brief Releases every level.
+		 */
+		void clear();
+
+		int getLevelCount() const;
+		int getWidth(int level) const;
+		int getHeight(int level) const;
+		const unsigned char* getLevel(int level) const;
+		size_t getLevelSize(int level) const;
+		TEXTURE_FORMAT getFormat() const;
+
+		/**
+		 * @brief Getter method for the GL internal format of the levels.
+		 *
+		 * @return GL_RGBA or the matching S3TC format.
+		 */
+		GLenum getInternalFormat() const;
+
+		/**
+		 * @brief Getter method for the number of pixel rows stored together (1, or 4 for block formats).
+		 *
+		 * @return Rows per block.
+		 */
+		int getRowHeight() const;
+
+		/**
+		 * @brief Getter method for the size of one row of pixels, or of blocks for block formats.
+		 *
+		 * @param level Level index.
+		 * @return Size in bytes.
+		 */
+		size_t getRowBytes(int level) const;
+
+		/**
+		 * @brief Getter method for the total size of all levels in bytes.
+		 *
+		 * @return Size of the pixel data.
+		 */
+		size_t getByteSize() const;
+
+		/**
+		 * @brief Identifies a version of a file, see AssetPack::getFileStamp().
+		 *
+		 * @param filename Path of the file.
+		 * @return The stamp, 0 if the file does not exist.
+		 */
+		static uint64_t getFileStamp(const std::string& filename);
+
+	private:
+		struct Level
+		{
+			int width;
+			int height;
+			size_t offset; // Byte offset from data
+			size_t size;   // Size in bytes
+		};
+
+		static size_t getLevelSize(TEXTURE_FORMAT format, int width, int height);
+
+		void allocate(int width, int height, int maxLevels);
+		void filterLevels(MIP_FILTER filter);
+
+		std::vector<Level> levels;
+		std::vector<unsigned char> storage; // Owned pixels (built or read from a file)
+		const unsigned char* data;			// Level 0, in storage or in caller memory
+		size_t bytes;						// Size of all levels
+		TEXTURE_FORMAT format;				// Storage format of every level
+	};
+}
+
+#endif // TEXTURE_H
@@ -0,0 +1,93 @@
+#ifndef TEXTURE_ATLAS_H // If the macro TEXTURE_ATLAS_H is not defined
+#define TEXTURE_ATLAS_H // Define the macro TEXTURE_ATLAS_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <string> // For file names
+#include <vector> // For the layer list
+
+// Include GLM headers
+#include <glm/glm.hpp> // OpenGL Mathematics
+
+// Include custom headers
+#include <./include/Texture.h> // Mip chain of the packed atlas
+#include <./include/AssetPack.h> // Memory-mapped assets
+
+/**
+ * @file TextureAtlas.h
+ * @brief Header file for the TextureAtlas class, every scene texture packed into one GL texture.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class TextureAtlas
+	 * @brief Packs images into equal sized cells of a single texture, addressed by layer index.
+	 *
+	 * Each image is resampled to fill its cell minus a gutter of repeated edge texels, so the
+	 * mip levels that are kept (down to a gutter of one texel) never bleed between layers.
+	 * Meshes remap their 0..1 UVs into the rectangle returned by getRect().
+	 */
+	class TextureAtlas
+	{
+	public:
+		/**
+		 * @brief Constructor for the TextureAtlas class.
+		 *
+		 * @param cellSize Size of each cell in texels, including the gutter.
+		 * @param gutter Edge texels repeated around each image, a power of two.
+		 */
+		TextureAtlas(int cellSize = 256, int gutter = 8);
+
+		/**
+		 * @brief Assigns layers to images in the order given and lays out the cells.
+		 *
+		 * find() and getRect() are valid from here on, before the pixels are built.
+		 *
+		 * @param filenames Images to pack.
+		 */
+		void setLayers(const std::vector<std::string>& filenames);
+
+		/**
+		 * @brief Builds the atlas mip chain, or loads it from the cache when every image is unchanged.
+		 *
+		 * Images that fail to load keep their layer (filled magenta) so indices stay stable.
+		 * Does not modify the atlas, so it can run on a worker thread while the layout is in use.
+		 *
+		 * @param cache Cache file for the packed mip chain.
+		 * @param assets Asset pack searched before the file system, the cache is used in place when packed.
+		 * @param mips Filled with the atlas and its mip levels.
+		 * @param compress Block compress a rebuilt chain (BC1, or BC3 if any image has alpha) before caching it.
+		 * @return true if at least one image was packed.
+		 */
+		bool build(const std::string& cache, const AssetPack* assets, MipChain& mips, bool compress = false) const;
+
+		/**
+		 * @brief Finds the layer of an image.
+		 *
+		 * @param filename File name as passed to build().
+		 * @return The layer index, -1 if the image is not in the atlas.
+		 */
+		int find(const std::string& filename) const;
+
+		/**
+		 * @brief Getter method for the UV rectangle of a layer.
+		 *
+		 * @param layer Layer index.
+		 * @return (u0, v0, u1, v1) of the layer's image, excluding the gutter.
+		 */
+		glm::vec4 getRect(int layer) const;
+
+		int getLayerCount() const;
+
+	private:
+		static void pack(const unsigned char* rgba, int width, int height, unsigned char* cell, int cellSize, int gutter, int stride);
+
+		int cellSize;	// Cell size in texels
+		int gutter;		// Gutter in texels
+		int columns;	// Cells per atlas row
+		int rows;		// Cell rows
+		std::vector<std::string> names; // Layer file names
+	};
+}
+
+#endif // TEXTURE_ATLAS_H
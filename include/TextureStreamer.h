@@ -0,0 +1,213 @@
+#ifndef TEXTURE_STREAMER_H // If the macro TEXTURE_STREAMER_H is not defined
+#define TEXTURE_STREAMER_H // Define the macro TEXTURE_STREAMER_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h>			  // For size_t
+#include <condition_variable> // For waking decode threads
+#include <deque>			  // For the decode and upload queues
+#include <functional>		  // For the decode function
+#include <memory>			  // For entry ownership
+#include <mutex>			  // For guarding the queues
+#include <string>			  // For file names
+#include <thread>			  // For decode threads
+#include <vector>			  // For the entry list
+
+// Include OpenGL headers
+#include <GL/glew.h> // OpenGL Extension Wrangler Library
+
+// Include custom headers
+#include <./include/Texture.h> // Decoded mip chains
+
+/**
+ * @file TextureStreamer.h
+ * @brief Header file for the TextureStreamer class, textures decoded on worker threads and uploaded over several frames.
+ */
+
+namespace gpp
+{
+	/**
+	 * @struct TextureStats
+	 * @brief Residency counters of a TextureStreamer, for logging and dashboards.
+	 */
+	struct TextureStats
+	{
+		size_t textures;	  // Handles handed out
+		size_t resident;	  // Textures with GPU storage
+		size_t pending;		  // Textures being decoded or uploaded
+		size_t residentBytes; // GPU storage of every texture, including uploads in flight
+		size_t budgetBytes;	  // Configured budget
+		size_t evictions;	  // Textures released under pressure
+		size_t mipDrops;	  // Top mip levels dropped under pressure
+		size_t reloads;		  // Evicted textures requested again
+		size_t uploadedBytes; // Bytes transferred by the last update()
+	};
+
+	/**
+	 * @class TextureStreamer
+	 * @brief Streams textures in the background and keeps their GPU storage within a budget.
+	 *
+	 * request() returns immediately. Decode threads produce the mip chain, then update() copies at most
+	 * the upload budget per frame into pixel buffer objects and transfers it into the texture a band of
+	 * rows at a time. getTexture() returns the placeholder until every level has been transferred.
+	 *
+	 * getTexture() also records the frame a texture was last used. When the resident textures exceed the
+	 * memory budget, update() releases the least recently used texture that was not drawn in the last
+	 * frame, or if every texture is in use, drops the top mip level of the largest. Released textures are
+	 * decoded again the next time they are asked for, and dropped levels come back once there is room.
+	 */
+	class TextureStreamer
+	{
+	public:
+		// Fills the mip chain of a texture, called on a decode thread (possibly again after an eviction)
+		typedef std::function<bool(MipChain& mips)> DecodeFunction;
+
+		/**
+		 * @brief Constructor for the TextureStreamer class.
+		 *
+		 * @param threads Number of decode threads.
+		 * @param uploadBudget Bytes transferred to the GPU per update().
+		 * @param memoryBudget Bytes of GPU storage the textures should stay within.
+		 */
+		explicit TextureStreamer(unsigned threads = 2, size_t uploadBudget = 1 << 20, size_t memoryBudget = 256 << 20);
+
+		/**
+		 * @brief Destructor for the TextureStreamer class, abandons queued work and releases the textures.
+		 */
+		~TextureStreamer();
+
+		/**
+		 * @brief Creates the placeholder texture and the pixel buffer objects, needs a GL context.
+		 */
+		void initialise();
+
+		/**
+		 * @brief Queues a texture whose mip chain is produced by a decode function.
+		 *
+		 * @param decode Called on a decode thread, must be safe to run alongside the render thread.
+		 * @param wrap Wrap mode of the texture (GL_REPEAT, GL_CLAMP_TO_EDGE).
+		 * @return Handle of the texture.
+		 */
+		unsigned request(const DecodeFunction& decode, GLint wrap = GL_REPEAT);
+
+		/**
+		 * @brief Queues an image file, see MipChain::load().
+		 *
+		 * @param filename Path of the image.
+		 * @param filter Downsampling filter used if the chain has to be built.
+		 * @return Handle of the texture.
+		 */
+		unsigned request(const std::string& filename, MIP_FILTER filter = MIP_FILTER::BOX);
+
+		/**
+		 * @brief Transfers decoded textures within the upload budget and enforces the memory budget.
+		 *
+		 * Call once per frame, before the frame's getTexture() calls.
+		 */
+		void update();
+
+		/**
+		 * @brief Getter method for the texture object to bind for a handle, marks the texture as used.
+		 *
+		 * An evicted texture is queued to be decoded again.
+		 *
+		 * @param handle Handle returned by request().
+		 * @return The texture once it is resident, otherwise the placeholder.
+		 */
+		GLuint getTexture(unsigned handle);
+
+		/**
+		 * @brief Decodes and uploads a texture again, e.g. after its source file changed.
+		 *
+		 * The resident texture stays in use until the new one has been transferred. A texture still in
+		 * flight is queued again once it finishes, an evicted one is decoded when next asked for.
+		 *
+		 * @param handle Handle returned by request().
+		 */
+		void reload(unsigned handle);
+
+		bool isReady(unsigned handle) const;
+
+		/**
+		 * @brief Setter method for the GPU storage budget, applied by the next update().
+		 *
+		 * @param bytes Budget in bytes.
+		 */
+		void setMemoryBudget(size_t bytes);
+
+		/**
+		 * @brief Getter method for the number of textures still being decoded or uploaded.
+		 *
+		 * @return Textures that are queued or uploading.
+		 */
+		size_t getPendingCount() const;
+
+		/**
+		 * @brief Getter method for the residency counters.
+		 *
+		 * @return Counters as of the last update().
+		 */
+		TextureStats getStats() const;
+
+	private:
+		TextureStreamer(const TextureStreamer&);
+		TextureStreamer& operator=(const TextureStreamer&);
+
+		enum class STATE {
+			QUEUED,	   // Waiting for or on a decode thread
+			UPLOADING, // Decoded, levels being transferred
+			RESIDENT,  // Nothing in flight
+			EVICTED,   // Released under pressure, decoded again on the next getTexture()
+			FAILED,	   // Decode failed and nothing is resident, the placeholder stays
+		};
+
+		struct Entry
+		{
+			DecodeFunction decode;
+			GLint wrap;
+			MipChain mips;		   // Released once uploaded
+			bool decoded;		   // Result of decode, written by the decode thread
+			STATE state;		   // Render thread only from here on
+			GLuint texture;		   // Resident texture, 0 if none
+			size_t textureBytes;   // GPU storage of texture
+			GLuint uploading;	   // Texture being filled (replaces texture when done), 0 if none
+			size_t uploadingBytes; // GPU storage of uploading
+			int levelCount;		   // Levels of the decoded chain
+			int skipLevels;		   // Top levels left out to save memory
+			int level;			   // Next level to transfer
+			int row;			   // Next row of that level
+			unsigned lastUsed;	   // Frame of the last getTexture()
+			bool reloadPending;	   // reload() while in flight, queued again when done
+		};
+
+		static const int PBO_COUNT = 3; // Buffers cycled so a transfer never waits on the previous one
+
+		void decodeLoop();
+		void queue(Entry& entry);
+		void beginUpload(Entry& entry);
+		size_t uploadBand(Entry& entry, size_t budget);
+		void finishUpload(Entry& entry);
+		void enforceBudget();
+
+		std::vector<std::unique_ptr<Entry> > entries; // Indexed by handle
+		std::deque<Entry*> decodeQueue;				  // Waiting for a decode thread
+		std::deque<Entry*> decodedQueue;			  // Decoded, waiting for update()
+		std::deque<Entry*> uploadQueue;				  // Render thread only
+
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable wake;
+		bool stopping;
+
+		size_t uploadBudget;
+		size_t memoryBudget;
+		size_t residentBytes; // Sum of textureBytes and uploadingBytes
+		unsigned frame;		  // Incremented by update()
+		TextureStats stats;	  // Event counters
+
+		GLuint placeholder;
+		GLuint pbos[PBO_COUNT]; // Zero when pixel buffer objects are unsupported
+		int nextPbo;
+	};
+}
+
+#endif // TEXTURE_STREAMER_H
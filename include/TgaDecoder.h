@@ -0,0 +1,80 @@
+#ifndef TGA_DECODER_H // If the macro TGA_DECODER_H is not defined
+#define TGA_DECODER_H // Define the macro TGA_DECODER_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <string>	// For file names
+#include <vector>	// For decoded pixels
+
+/**
+ * @file TgaDecoder.h
+ * @brief Header file for the TgaDecoder class, a fast path for true colour TGA images.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class TgaDecoder
+	 * @brief Decodes 24 and 32-bit true colour TGA images (raw or RLE) straight from memory into RGBA8.
+	 *
+	 * BGR(A) to RGBA conversion uses SSSE3 or AVX2 shuffles when the CPU supports them. Rows are written
+	 * top to bottom whatever the image origin, matching stbi_load. Every other image (colour mapped,
+	 * greyscale, 16-bit, non-TGA) is handed to stb_image.
+	 */
+	class TgaDecoder
+	{
+	public:
+		/**
+		 * @brief Reads the header of an image the fast path can decode.
+		 *
+		 * @param file File contents.
+		 * @param size Size of the contents in bytes.
+		 * @param width Set to the image width.
+		 * @param height Set to the image height.
+		 * @return false if the image is not a true colour TGA the fast path supports.
+		 */
+		static bool readHeader(const unsigned char* file, size_t size, int& width, int& height);
+
+		/**
+		 * @brief Decodes an image accepted by readHeader().
+		 *
+		 * @param file File contents.
+		 * @param size Size of the contents in bytes.
+		 * @param rgba Destination, width * height * 4 bytes (e.g. a mapped upload buffer).
+		 * @return false if the image is truncated or unsupported.
+		 */
+		static bool decode(const unsigned char* file, size_t size, unsigned char* rgba);
+
+		/**
+		 * @brief Decodes any image in memory to RGBA8, through the fast path when possible.
+		 *
+		 * @param file File contents.
+		 * @param size Size of the contents in bytes.
+		 * @param rgba Resized to width * height * 4 and filled.
+		 * @param width Set to the image width.
+		 * @param height Set to the image height.
+		 * @return true if the image was decoded.
+		 */
+		static bool load(const unsigned char* file, size_t size, std::vector<unsigned char>& rgba, int& width, int& height);
+
+		/**
+		 * @brief Maps an image file and decodes it to RGBA8, through the fast path when possible.
+		 *
+		 * @param filename Path of the image.
+		 * @param rgba Resized to width * height * 4 and filled.
+		 * @param width Set to the image width.
+		 * @param height Set to the image height.
+		 * @return true if the image was decoded.
+		 */
+		static bool load(const std::string& filename, std::vector<unsigned char>& rgba, int& width, int& height);
+
+		/**
+		 * @brief Getter method for the name of the conversion kernel in use.
+		 *
+		 * @return "AVX2", "SSSE3" or "scalar".
+		 */
+		static const char* getKernelName();
+	};
+}
+
+#endif // TGA_DECODER_H
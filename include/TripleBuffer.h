@@ -0,0 +1,84 @@
+#ifndef TRIPLE_BUFFER_H // If the macro TRIPLE_BUFFER_H is not defined
+#define TRIPLE_BUFFER_H // Define the macro TRIPLE_BUFFER_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <atomic> // For the shared slot index
+
+/**
+ * @file TripleBuffer.h
+ * @brief Header file for the TripleBuffer class, lock-free hand over of values from one thread to another.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class TripleBuffer
+	 * @brief Passes the latest value from one writer thread to one reader thread without locks.
+	 *
+	 * The writer and reader each own a slot, the third is the one last published. Publishing swaps the
+	 * writer's slot with it, and so does the reader when a newer value is waiting. Neither side ever
+	 * waits for the other; the reader may skip values but always sees a complete one.
+	 */
+	template <typename T>
+	class TripleBuffer
+	{
+	public:
+		TripleBuffer()
+			: writing(0), middle(1), reading(2)
+		{
+		}
+
+		/**
+		 * @brief Getter method for the writer's slot, filled before publish(). Writer thread only.
+		 *
+		 * @return The slot, holding whatever the writer left in it last time it owned it.
+		 */
+		T& write() { return slots[writing]; }
+
+		/**
+		 * @brief Makes the writer's slot the latest value and hands the writer another one. Writer thread only.
+		 */
+		void publish()
+		{
+			writing = middle.exchange(writing | FRESH, std::memory_order_acq_rel) & INDEX;
+		}
+
+		/**
+		 * @brief Takes the latest value if one was published since the last call. Reader thread only.
+		 *
+		 * @return true if read() now returns a newer value.
+		 */
+		bool update()
+		{
+			if (!(middle.load(std::memory_order_relaxed) & FRESH))
+				return false;
+
+			reading = middle.exchange(reading, std::memory_order_acq_rel) & INDEX;
+			return true;
+		}
+
+		/**
+		 * @brief Getter method for the value taken by the last update(). Reader thread only.
+		 *
+		 * @return The value, default constructed until the first publish().
+		 */
+		const T& read() const { return slots[reading]; }
+
+	private:
+		TripleBuffer(const TripleBuffer&);
+		TripleBuffer& operator=(const TripleBuffer&);
+
+		enum : unsigned
+		{
+			INDEX = 3, // Slot index bits of middle
+			FRESH = 4  // Set while the middle slot has not been read
+		};
+
+		T slots[3];
+		unsigned writing;			 // Writer's slot
+		std::atomic<unsigned> middle; // Slot between the two, with FRESH
+		unsigned reading;			 // Reader's slot
+	};
+}
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,142 @@
+#ifndef WORK_STEALING_DEQUE_H // If the macro WORK_STEALING_DEQUE_H is not defined
+#define WORK_STEALING_DEQUE_H // Define the macro WORK_STEALING_DEQUE_H to prevent multiple inclusions of this header file
+
+// Include necessary standard library headers
+#include <stddef.h> // For size_t
+#include <stdint.h> // For fixed width integer types
+#include <atomic>	// For the ends and slots
+#include <memory>	// For the slot array
+
+/**
+ * @file WorkStealingDeque.h
+ * @brief Header file for the WorkStealingDeque class, a Chase-Lev deque of fixed capacity.
+ */
+
+namespace gpp
+{
+	/**
+	 * @class WorkStealingDeque
+	 * @brief Deque owned by one thread that other threads may steal from, without locks.
+	 *
+	 * The owner pushes and pops at the bottom, last in first out, so it keeps working on what it touched
+	 * last. Thieves take from the top, the oldest and usually largest pieces of work. Only a pop racing a
+	 * steal for the last item needs a compare and swap. This is the Chase-Lev deque with the memory
+	 * orders of Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models", without growth:
+	 * push() refuses items once the deque is full.
+	 *
+	 * T must be trivially copyable, a pointer in practice.
+	 */
+	template <typename T>
+	class WorkStealingDeque
+	{
+	public:
+		/**
+		 * @brief Constructor for the WorkStealingDeque class.
+		 *
+		 * @param capacity Items the deque holds, rounded up to a power of two.
+		 */
+		explicit WorkStealingDeque(size_t capacity = 4096)
+			: top(0), bottom(0)
+		{
+			size_t size = 1;
+			while (size < capacity)
+				size <<= 1;
+
+			mask = (int64_t)size - 1;
+			slots.reset(new std::atomic<T>[size]);
+		}
+
+		/**
+		 * @brief Adds an item at the bottom. Owner thread only.
+		 *
+		 * @param item The item.
+		 * @return false if the deque is full.
+		 */
+		bool push(T item)
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed);
+			const int64_t t = top.load(std::memory_order_acquire);
+			if (b - t > mask)
+				return false;
+
+			slots[b & mask].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		/**
+		 * @brief Takes the item at the bottom. Owner thread only.
+		 *
+		 * @param item Receives the item.
+		 * @return false if the deque is empty.
+		 */
+		bool pop(T& item)
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+			bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t t = top.load(std::memory_order_relaxed);
+
+			if (t > b)
+			{
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			item = slots[b & mask].load(std::memory_order_relaxed);
+			if (t == b)
+			{
+				// Last item, a thief may be taking it too
+				const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return won;
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Takes the item at the top. Any thread.
+		 *
+		 * @param item Receives the item.
+		 * @return false if the deque is empty or another thread took the item first.
+		 */
+		bool steal(T& item)
+		{
+			int64_t t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t b = bottom.load(std::memory_order_acquire);
+			if (t >= b)
+				return false;
+
+			item = slots[t & mask].load(std::memory_order_relaxed);
+			return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Getter method for the number of items, only a hint while other threads use the deque.
+		 *
+		 * @return Items between top and bottom.
+		 */
+		size_t size() const
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed);
+			const int64_t t = top.load(std::memory_order_relaxed);
+			return b > t ? (size_t)(b - t) : 0;
+		}
+
+	private:
+		WorkStealingDeque(const WorkStealingDeque&);
+		WorkStealingDeque& operator=(const WorkStealingDeque&);
+
+		// Thieves and the owner write different ends, padded onto different cache lines
+		std::atomic<int64_t> top; // Next item to steal
+		char topPadding[64 - sizeof(std::atomic<int64_t>)];
+		std::atomic<int64_t> bottom; // Next free slot
+		char bottomPadding[64 - sizeof(std::atomic<int64_t>)];
+		int64_t mask;
+		std::unique_ptr<std::atomic<T>[]> slots;
+	};
+}
+
+#endif // WORK_STEALING_DEQUE_H
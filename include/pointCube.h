@@ -7,7 +7,6 @@
 
 class PointCube {
 public:
-    std::vector<PointCube> pointCubes;
     glm::vec3 position; // Position of the cube
     float size;         // Size of the cube
     bool collected;     // Whether the cube has been collected
@@ -0,0 +1,309 @@
+/**
+ * @file AssetPack.cpp
+ * @brief Contains the implementation of the AssetPack class.
+ */
+
+#include <stdio.h>	  // For writing packs
+#include <string.h>	  // For memcmp, memcpy
+#include <sys/stat.h> // For file modification time
+
+#if defined(_WIN32)
+#include <windows.h> // GetModuleFileName
+#else
+#include <unistd.h>	 // readlink
+#endif
+
+#include <./include/AssetPack.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const char PACK_MAGIC[4] = { 'G', 'P', 'A', 'K' };
+	const uint32_t PACK_VERSION = 1;
+	const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+	const uint64_t DATA_ALIGNMENT = 16;
+
+	struct PackHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t slotCount;	   // Power of two
+		uint64_t slotOffset;   // Hash table
+		uint64_t entryOffset;  // Entry table
+		uint64_t nameOffset;   // Path strings
+	};
+
+	struct PackSlot
+	{
+		uint64_t hash;
+		uint32_t entry; // EMPTY_SLOT if unused
+		uint32_t reserved;
+	};
+
+	struct PackEntry
+	{
+		uint64_t offset; // Data offset from the start of the pack
+		uint64_t size;	 // Data size
+		uint64_t stamp;	 // getFileStamp() of the source file
+		uint32_t nameOffset;
+		uint32_t nameLength;
+	};
+
+	uint64_t fnv1a(const unsigned char* data, size_t size, uint64_t hash = 14695981039346656037ULL)
+	{
+		for (size_t i = 0; i < size; i++)
+			hash = (hash ^ data[i]) * 1099511628211ULL;
+		return hash;
+	}
+
+	// Path as stored in the pack, without a leading "./"
+	std::string normalise(const std::string& path)
+	{
+		return path.compare(0, 2, "./") == 0 ? path.substr(2) : path;
+	}
+
+	bool readFile(const std::string& filename, std::vector<unsigned char>& data)
+	{
+		FILE* file = fopen(filename.c_str(), "rb");
+		if (file == NULL)
+			return false;
+
+		fseek(file, 0, SEEK_END);
+		long length = ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		data.resize(length > 0 ? (size_t)length : 0);
+		bool read = length >= 0 && (data.empty() || fread(&data[0], 1, data.size(), file) == data.size());
+		fclose(file);
+		return read;
+	}
+}
+
+AssetPack::AssetPack()
+{
+}
+
+/**
+ * @brief Destructor for the AssetPack class, unmaps the pack.
+ */
+AssetPack::~AssetPack()
+{
+}
+
+/**
+ * @brief Maps a pack file.
+ */
+bool AssetPack::open(const std::string& filename)
+{
+	if (!file.open(filename))
+		return false;
+
+	const unsigned char* base = file.getData();
+	const size_t size = file.getSize();
+
+	// Validate the header and tables before handing out pointers
+	const PackHeader* header = (const PackHeader*)base;
+	bool valid = size >= sizeof(PackHeader) &&
+				 memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) == 0 &&
+				 header->version == PACK_VERSION &&
+				 header->slotCount != 0 && (header->slotCount & (header->slotCount - 1)) == 0 &&
+				 header->slotOffset + (uint64_t)header->slotCount * sizeof(PackSlot) <= size &&
+				 header->entryOffset + (uint64_t)header->entryCount * sizeof(PackEntry) <= size &&
+				 header->nameOffset <= size;
+
+	if (!valid)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Unmaps the pack.
+ */
+void AssetPack::close()
+{
+	file.close();
+}
+
+bool AssetPack::isOpen() const { return file.isOpen(); }
+
+/**
+ * @brief Looks up an asset by linear probing the hash table.
+ */
+bool AssetPack::find(const std::string& path, AssetView& view) const
+{
+	if (!file.isOpen())
+		return false;
+
+	const unsigned char* base = file.getData();
+	const size_t size = file.getSize();
+
+	const PackHeader* header = (const PackHeader*)base;
+	const PackSlot* slots = (const PackSlot*)(base + header->slotOffset);
+	const PackEntry* entries = (const PackEntry*)(base + header->entryOffset);
+	const std::string name = normalise(path);
+	const uint64_t hash = hashPath(name);
+	const uint32_t mask = header->slotCount - 1;
+
+	for (uint32_t i = 0; i < header->slotCount; i++)
+	{
+		const PackSlot& slot = slots[(hash + i) & mask];
+		if (slot.entry == EMPTY_SLOT || slot.entry >= header->entryCount)
+			return false;
+
+		if (slot.hash != hash)
+			continue;
+
+		const PackEntry& entry = entries[slot.entry];
+		if (entry.nameLength != name.size() ||
+			header->nameOffset + entry.nameOffset + entry.nameLength > size ||
+			memcmp(base + header->nameOffset + entry.nameOffset, name.data(), name.size()) != 0 ||
+			entry.offset + entry.size > size)
+			continue;
+
+		view.data = base + entry.offset;
+		view.size = (size_t)entry.size;
+		view.stamp = entry.stamp;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Identifies a version of a file by its modification time and size.
+ */
+uint64_t AssetPack::getFileStamp(const std::string& filename)
+{
+	struct stat info;
+	if (stat(filename.c_str(), &info) != 0)
+		return 0;
+
+	return ((uint64_t)info.st_mtime << 24) ^ (uint64_t)info.st_size;
+}
+
+/**
+ * @brief Hashes a path (FNV-1a, 64-bit) after removing a leading "./".
+ */
+uint64_t AssetPack::hashPath(const std::string& path)
+{
+	const std::string name = normalise(path);
+	return fnv1a((const unsigned char*)name.data(), name.size());
+}
+
+/**
+ * @brief Writes a pack file.
+ */
+bool AssetPack::write(const std::string& filename, const std::vector<std::string>& paths)
+{
+	std::vector<std::string> names;
+	std::vector<std::vector<unsigned char> > contents;
+
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		std::vector<unsigned char> data;
+		if (!readFile(paths[i], data))
+			return false;
+
+		names.push_back(normalise(paths[i]));
+		contents.push_back(data);
+	}
+
+	const uint32_t count = (uint32_t)names.size();
+
+	// Keep the table at most half full
+	uint32_t slotCount = 1;
+	while (slotCount < count * 2)
+		slotCount *= 2;
+
+	PackHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+	header.version = PACK_VERSION;
+	header.entryCount = count;
+	header.slotCount = slotCount;
+	header.slotOffset = sizeof(PackHeader);
+	header.entryOffset = header.slotOffset + (uint64_t)slotCount * sizeof(PackSlot);
+	header.nameOffset = header.entryOffset + (uint64_t)count * sizeof(PackEntry);
+
+	std::string nameBlob;
+	std::vector<PackEntry> entries(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		entries[i].nameOffset = (uint32_t)nameBlob.size();
+		entries[i].nameLength = (uint32_t)names[i].size();
+		nameBlob += names[i];
+	}
+
+	uint64_t offset = header.nameOffset + nameBlob.size();
+	for (uint32_t i = 0; i < count; i++)
+	{
+		offset = (offset + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+		entries[i].offset = offset;
+		entries[i].size = contents[i].size();
+		entries[i].stamp = getFileStamp(paths[i]);
+		offset += contents[i].size();
+	}
+
+	std::vector<PackSlot> slots(slotCount);
+	for (uint32_t i = 0; i < slotCount; i++)
+	{
+		slots[i].hash = 0;
+		slots[i].entry = EMPTY_SLOT;
+		slots[i].reserved = 0;
+	}
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint64_t hash = hashPath(names[i]);
+		uint32_t slot = (uint32_t)hash & (slotCount - 1);
+		while (slots[slot].entry != EMPTY_SLOT)
+			slot = (slot + 1) & (slotCount - 1);
+		slots[slot].hash = hash;
+		slots[slot].entry = i;
+	}
+
+	FILE* file = fopen(filename.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+				   fwrite(&slots[0], sizeof(PackSlot), slotCount, file) == slotCount &&
+				   (count == 0 || fwrite(&entries[0], sizeof(PackEntry), count, file) == count) &&
+				   fwrite(nameBlob.data(), 1, nameBlob.size(), file) == nameBlob.size();
+
+	uint64_t position = header.nameOffset + nameBlob.size();
+	const unsigned char padding[DATA_ALIGNMENT] = { 0 };
+	for (uint32_t i = 0; written && i < count; i++)
+	{
+		size_t pad = (size_t)(entries[i].offset - position);
+		written = fwrite(padding, 1, pad, file) == pad &&
+				  (contents[i].empty() || fwrite(&contents[i][0], 1, contents[i].size(), file) == contents[i].size());
+		position = entries[i].offset + entries[i].size;
+	}
+
+	fclose(file);
+	return written;
+}
+
+/**
+ * @brief Getter method for the directory holding the running executable.
+ */
+std::string AssetPack::getExecutableDirectory()
+{
+	char path[4096];
+#if defined(_WIN32)
+	DWORD length = GetModuleFileNameA(NULL, path, sizeof(path));
+	if (length == 0 || length >= sizeof(path))
+		return "";
+#else
+	ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+	if (length <= 0)
+		return "";
+#endif
+	std::string executable(path, (size_t)length);
+	size_t slash = executable.find_last_of("/\\");
+	return slash == std::string::npos ? "" : executable.substr(0, slash + 1);
+}
@@ -0,0 +1,331 @@
+/**
+ * @file BlockCompressor.cpp
+ * @brief Contains the implementation of the BlockCompressor class.
+ */
+
+#include <math.h> // For fabs, sqrt
+
+#include <./include/BlockCompressor.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	// Weight of colour 0 for each BC1 index (4 colour mode)
+	const float COLOUR_WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+	unsigned short pack565(const float rgb[3])
+	{
+		int r = (int)(rgb[0] * 31.0f / 255.0f + 0.5f);
+		int g = (int)(rgb[1] * 63.0f / 255.0f + 0.5f);
+		int b = (int)(rgb[2] * 31.0f / 255.0f + 0.5f);
+		r = r < 0 ? 0 : (r > 31 ? 31 : r);
+		g = g < 0 ? 0 : (g > 63 ? 63 : g);
+		b = b < 0 ? 0 : (b > 31 ? 31 : b);
+		return (unsigned short)((r << 11) | (g << 5) | b);
+	}
+
+	void unpack565(unsigned short colour, float rgb[3])
+	{
+		int r = (colour >> 11) & 31;
+		int g = (colour >> 5) & 63;
+		int b = colour & 31;
+		rgb[0] = (float)((r << 3) | (r >> 2));
+		rgb[1] = (float)((g << 2) | (g >> 4));
+		rgb[2] = (float)((b << 3) | (b >> 2));
+	}
+
+	/**
+	 * @brief Picks the nearest palette entry for every pixel of a block.
+	 *
+	 * @return Total squared error.
+	 */
+	float chooseIndices(const unsigned char block[64], unsigned short c0, unsigned short c1, unsigned char indices[16])
+	{
+		float palette[4][3];
+		unpack565(c0, palette[0]);
+		unpack565(c1, palette[1]);
+		for (int c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+			palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+		}
+
+		float error = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			float best = 1e30f;
+			for (int p = 0; p < 4; p++)
+			{
+				float dr = block[i * 4 + 0] - palette[p][0];
+				float dg = block[i * 4 + 1] - palette[p][1];
+				float db = block[i * 4 + 2] - palette[p][2];
+				float distance = dr * dr + dg * dg + db * db;
+				if (distance < best)
+				{
+					best = distance;
+					indices[i] = (unsigned char)p;
+				}
+			}
+			error += best;
+		}
+		return error;
+	}
+
+	/**
+	 * @brief Quantizes two endpoints, orders them for 4 colour mode and picks indices.
+	 *
+	 * @return Total squared error.
+	 */
+	float fitEndpoints(const unsigned char block[64], const float end0[3], const float end1[3],
+					   unsigned short& c0, unsigned short& c1, unsigned char indices[16])
+	{
+		c0 = pack565(end0);
+		c1 = pack565(end1);
+		if (c0 < c1)
+		{
+			unsigned short swap = c0;
+			c0 = c1;
+			c1 = swap;
+		}
+		return chooseIndices(block, c0, c1, indices);
+	}
+
+	void writeColourBlock(unsigned short c0, unsigned short c1, const unsigned char indices[16], unsigned char out[8])
+	{
+		// Equal endpoints would select 3 colour mode, every index then points at colour 0
+		unsigned bits = 0;
+		if (c0 != c1)
+		{
+			for (int i = 0; i < 16; i++)
+				bits |= (unsigned)indices[i] << (i * 2);
+		}
+
+		out[0] = (unsigned char)(c0 & 0xFF);
+		out[1] = (unsigned char)(c0 >> 8);
+		out[2] = (unsigned char)(c1 & 0xFF);
+		out[3] = (unsigned char)(c1 >> 8);
+		out[4] = (unsigned char)(bits & 0xFF);
+		out[5] = (unsigned char)((bits >> 8) & 0xFF);
+		out[6] = (unsigned char)((bits >> 16) & 0xFF);
+		out[7] = (unsigned char)(bits >> 24);
+	}
+}
+
+/**
+ * @brief Getter method for the size of an encoded image.
+ */
+size_t BlockCompressor::getEncodedSize(int width, int height, size_t blockBytes)
+{
+	return (size_t)((width + 3) / 4) * (size_t)((height + 3) / 4) * blockBytes;
+}
+
+/**
+ * @brief Copies a 4x4 block, repeating edge pixels where it overhangs the image.
+ */
+void BlockCompressor::fetchBlock(const unsigned char* rgba, int width, int height, int x, int y, unsigned char block[64])
+{
+	for (int j = 0; j < 4; j++)
+	{
+		int sy = y + j < height ? y + j : height - 1;
+		for (int i = 0; i < 4; i++)
+		{
+			int sx = x + i < width ? x + i : width - 1;
+			const unsigned char* pixel = rgba + ((size_t)sy * width + sx) * 4;
+			for (int c = 0; c < 4; c++)
+				block[(j * 4 + i) * 4 + c] = pixel[c];
+		}
+	}
+}
+
+/**
+ * @brief Encodes the colour of a block (BC1 layout, 4 colour mode).
+ */
+void BlockCompressor::encodeColour(const unsigned char block[64], unsigned char out[8])
+{
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; i++)
+		for (int c = 0; c < 3; c++)
+			mean[c] += block[i * 4 + c] / 16.0f;
+
+	// Covariance of the colours
+	float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; i++)
+	{
+		float r = block[i * 4 + 0] - mean[0];
+		float g = block[i * 4 + 1] - mean[1];
+		float b = block[i * 4 + 2] - mean[2];
+		cov[0] += r * r;
+		cov[1] += r * g;
+		cov[2] += r * b;
+		cov[3] += g * g;
+		cov[4] += g * b;
+		cov[5] += b * b;
+	}
+
+	// Principal axis by power iteration
+	float axis[3] = { 1.0f, 1.0f, 1.0f };
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+		float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+		float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+		float length = (float)sqrt(x * x + y * y + z * z);
+		if (length < 1e-6f)
+			break;
+		axis[0] = x / length;
+		axis[1] = y / length;
+		axis[2] = z / length;
+	}
+
+	// Endpoints at the extreme pixels along the axis
+	int lowest = 0, highest = 0;
+	float minimum = 1e30f, maximum = -1e30f;
+	for (int i = 0; i < 16; i++)
+	{
+		float projection = block[i * 4 + 0] * axis[0] + block[i * 4 + 1] * axis[1] + block[i * 4 + 2] * axis[2];
+		if (projection < minimum)
+		{
+			minimum = projection;
+			lowest = i;
+		}
+		if (projection > maximum)
+		{
+			maximum = projection;
+			highest = i;
+		}
+	}
+
+	float end0[3], end1[3];
+	for (int c = 0; c < 3; c++)
+	{
+		end0[c] = block[highest * 4 + c];
+		end1[c] = block[lowest * 4 + c];
+	}
+
+	unsigned short c0, c1;
+	unsigned char indices[16];
+	float error = fitEndpoints(block, end0, end1, c0, c1, indices);
+
+	// Refine both endpoints by least squares against the chosen indices
+	if (c0 != c1)
+	{
+		float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+		float ax[3] = { 0.0f, 0.0f, 0.0f };
+		float bx[3] = { 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; i++)
+		{
+			float a = COLOUR_WEIGHTS[indices[i]];
+			float b = 1.0f - a;
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+			for (int c = 0; c < 3; c++)
+			{
+				ax[c] += a * block[i * 4 + c];
+				bx[c] += b * block[i * 4 + c];
+			}
+		}
+
+		float determinant = aa * bb - ab * ab;
+		if (fabs(determinant) > 1e-6f)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				end0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+				end1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+			}
+
+			unsigned short r0, r1;
+			unsigned char refined[16];
+			if (fitEndpoints(block, end0, end1, r0, r1, refined) < error)
+			{
+				c0 = r0;
+				c1 = r1;
+				for (int i = 0; i < 16; i++)
+					indices[i] = refined[i];
+			}
+		}
+	}
+
+	writeColourBlock(c0, c1, indices, out);
+}
+
+/**
+ * @brief Encodes the alpha of a block (BC3 layout, 8 value mode).
+ */
+void BlockCompressor::encodeAlpha(const unsigned char block[64], unsigned char out[8])
+{
+	int a0 = 0, a1 = 255;
+	for (int i = 0; i < 16; i++)
+	{
+		int alpha = block[i * 4 + 3];
+		a0 = alpha > a0 ? alpha : a0;
+		a1 = alpha < a1 ? alpha : a1;
+	}
+
+	int palette[8];
+	palette[0] = a0;
+	palette[1] = a1;
+	for (int i = 2; i < 8; i++)
+		palette[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+
+	unsigned long long bits = 0;
+	if (a0 != a1)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			int alpha = block[i * 4 + 3];
+			int best = 0;
+			int bestDistance = 256;
+			for (int p = 0; p < 8; p++)
+			{
+				int distance = alpha > palette[p] ? alpha - palette[p] : palette[p] - alpha;
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			bits |= (unsigned long long)best << (i * 3);
+		}
+	}
+
+	out[0] = (unsigned char)a0;
+	out[1] = (unsigned char)a1;
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = (unsigned char)((bits >> (i * 8)) & 0xFF);
+}
+
+/**
+ * @brief Encodes an image as BC1, alpha is ignored.
+ */
+void BlockCompressor::encodeBC1(const unsigned char* rgba, int width, int height, unsigned char* out)
+{
+	unsigned char block[64];
+	for (int y = 0; y < height; y += 4)
+	{
+		for (int x = 0; x < width; x += 4, out += BC1_BLOCK_BYTES)
+		{
+			fetchBlock(rgba, width, height, x, y, block);
+			encodeColour(block, out);
+		}
+	}
+}
+
+/**
+ * @brief Encodes an image as BC3.
+ */
+void BlockCompressor::encodeBC3(const unsigned char* rgba, int width, int height, unsigned char* out)
+{
+	unsigned char block[64];
+	for (int y = 0; y < height; y += 4)
+	{
+		for (int x = 0; x < width; x += 4, out += BC3_BLOCK_BYTES)
+		{
+			fetchBlock(rgba, width, height, x, y, block);
+			encodeAlpha(block, out);
+			encodeColour(block, out + 8);
+		}
+	}
+}
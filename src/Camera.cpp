@@ -0,0 +1,103 @@
+/**
+ * @file Camera.cpp
+ * @brief Contains the implementation of the Camera class.
+ */
+
+#include <./include/Camera.h>
+
+using namespace gpp; // GPP namespace
+
+Camera::Camera()
+	: eye(0.0f, 0.0f, 1.0f), target(0.0f), up(0.0f, 1.0f, 0.0f),
+	  fieldOfView(glm::radians(45.0f)), aspect(4.0f / 3.0f), zNear(0.1f), zFar(100.0f),
+	  view(1.0f), projection(1.0f), viewProjection(1.0f),
+	  viewDirty(true), projectionDirty(true), version(0)
+{
+}
+
+/**
+ * @brief Setter method for the view, marks it dirty only if it changed.
+ */
+void Camera::setLookAt(const glm::vec3& eye, const glm::vec3& target, const glm::vec3& up)
+{
+	if (eye == this->eye && target == this->target && up == this->up)
+		return;
+
+	this->eye = eye;
+	this->target = target;
+	this->up = up;
+	viewDirty = true;
+}
+
+/**
+ * @brief Setter method for the projection, marks it dirty only if it changed.
+ */
+void Camera::setPerspective(float fieldOfView, float aspect, float zNear, float zFar)
+{
+	if (fieldOfView == this->fieldOfView && aspect == this->aspect && zNear == this->zNear && zFar == this->zFar)
+		return;
+
+	this->fieldOfView = fieldOfView;
+	this->aspect = aspect;
+	this->zNear = zNear;
+	this->zFar = zFar;
+	projectionDirty = true;
+}
+
+/**
+ * @brief Setter method for the aspect ratio from a window size.
+ */
+void Camera::setViewport(unsigned width, unsigned height)
+{
+	if (width == 0 || height == 0)
+		return; // Minimised
+
+	setPerspective(fieldOfView, (float)width / (float)height, zNear, zFar);
+}
+
+/**
+ * @brief Rebuilds whichever matrices are dirty, and the view projection if either was.
+ */
+void Camera::rebuild()
+{
+	if (!viewDirty && !projectionDirty)
+		return;
+
+	if (viewDirty)
+		view = glm::lookAt(eye, target, up);
+	if (projectionDirty)
+		projection = glm::perspective(fieldOfView, aspect, zNear, zFar);
+
+	viewProjection = projection * view;
+	viewDirty = false;
+	projectionDirty = false;
+	version++;
+}
+
+const glm::mat4& Camera::getView()
+{
+	rebuild();
+	return view;
+}
+
+const glm::mat4& Camera::getProjection()
+{
+	rebuild();
+	return projection;
+}
+
+const glm::mat4& Camera::getViewProjection()
+{
+	rebuild();
+	return viewProjection;
+}
+
+unsigned Camera::getVersion()
+{
+	rebuild();
+	return version;
+}
+
+float Camera::getNear() const { return zNear; }
+
+float Camera::getFar() const { return zFar; }
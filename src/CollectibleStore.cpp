@@ -0,0 +1,361 @@
+/**
+ * @file CollectibleStore.cpp
+ * @brief Contains the implementation of the CollectibleStore class.
+ */
+
+#include <math.h>	 // For fabsf, sqrtf, sinf, cosf, logf, powf
+#include <algorithm> // For std::sort, std::min, std::max and std::swap
+#include <functional> // For std::greater
+
+#include <./include/CollectibleStore.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	/**
+	 * @brief Small, fast generator (xorshift32), so large scatters are reproducible on every platform.
+	 */
+	struct Random
+	{
+		uint32_t state;
+
+		explicit Random(uint32_t seed) : state(seed != 0 ? seed : 0x9E3779B9u) {}
+
+		uint32_t next()
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+
+		// Uniform in [0, 1)
+		float unit() { return (next() >> 8) * (1.0f / 16777216.0f); }
+
+		// Uniform in [0, range)
+		size_t below(size_t range) { return (size_t)next() % range; }
+	};
+
+	// Poisson-disk scatter
+	const float DISK_DENSITY = 0.75f;  // Points per unit area times radius^2 of a maximal set
+	const float SURPLUS = 0.05f;	   // Fraction of extra points dropped at random after the last pass
+	const float TOP_UP_SHRINK = 0.97f; // Radius of each top up of a pass still short after MAX_PASSES
+	const float ANNULUS_EDGE = 1.0001f; // Candidate distance in radii, just clear of the disk
+	const float MIN_EXPONENT = 0.5f;   // Bounds of the measured density exponent
+	const float MAX_EXPONENT = 4.0f;
+	const int MAX_PASSES = 4;		   // Full passes before any surplus is accepted or the last one topped up
+	const size_t PILOT_POINTS = 20000; // Points of the pass measuring the density of a large scatter
+	const int SEED_ATTEMPTS = 4;	   // Tries to restart the growth in each free cell
+}
+
+CollectibleStore::CollectibleStore()
+{
+}
+
+/**
+ * @brief Removes every collectible.
+ */
+void CollectibleStore::clear()
+{
+	positions.clear();
+	sizes.clear();
+	types.clear();
+	cells.clear();
+}
+
+/**
+ * @brief Reserves room for collectibles about to be added.
+ */
+void CollectibleStore::reserve(size_t count)
+{
+	positions.reserve(count);
+	sizes.reserve(count);
+	types.reserve(count);
+}
+
+/**
+ * @brief Adds a collectible, found by collect() after the next build().
+ */
+void CollectibleStore::add(const glm::vec3& position, float size, uint32_t type)
+{
+	cells.insert((uint32_t)positions.size(), position, size);
+	positions.push_back(position);
+	sizes.push_back(size);
+	types.push_back(type);
+}
+
+void CollectibleStore::build() { cells.build(); }
+
+/**
+ * @brief Removes a collectible, moving the last one into its place.
+ */
+void CollectibleStore::remove(uint32_t index)
+{
+	const uint32_t last = (uint32_t)positions.size() - 1;
+
+	cells.remove(index, positions[index]);
+	if (index != last)
+	{
+		cells.rename(last, index, positions[last]);
+		positions[index] = positions[last];
+		sizes[index] = sizes[last];
+		types[index] = types[last];
+	}
+
+	positions.pop_back();
+	sizes.pop_back();
+	types.pop_back();
+}
+
+/**
+ * @brief Removes every built collectible whose box overlaps a box.
+ *
+ * Hits are removed from the highest index down, so no hit still to be removed is moved by an earlier one.
+ */
+size_t CollectibleStore::collect(const glm::vec3& position, float size, std::vector<uint32_t>* removed)
+{
+	const glm::vec3 extent(size);
+
+	nearby.clear();
+	cells.query(position - extent, position + extent, nearby);
+
+	size_t hits = 0;
+	for (size_t i = 0; i < nearby.size(); i++)
+	{
+		const uint32_t index = nearby[i];
+		const float reach = size + sizes[index];
+		if (fabsf(position.x - positions[index].x) < reach &&
+			fabsf(position.y - positions[index].y) < reach &&
+			fabsf(position.z - positions[index].z) < reach)
+		{
+			nearby[hits++] = index;
+		}
+	}
+
+	std::sort(nearby.begin(), nearby.begin() + hits, std::greater<uint32_t>());
+	for (size_t i = 0; i < hits; i++)
+		remove(nearby[i]);
+
+	if (removed != NULL)
+		removed->insert(removed->end(), nearby.begin(), nearby.begin() + hits);
+
+	return hits;
+}
+
+size_t CollectibleStore::size() const { return positions.size(); }
+
+bool CollectibleStore::empty() const { return positions.empty(); }
+
+const glm::vec3* CollectibleStore::getPositions() const { return positions.empty() ? NULL : &positions[0]; }
+
+const float* CollectibleStore::getSizes() const { return sizes.empty() ? NULL : &sizes[0]; }
+
+const uint32_t* CollectibleStore::getTypes() const { return types.empty() ? NULL : &types[0]; }
+
+/**
+ * @brief Scatters positions over the free cells of a maze with a Poisson-disk (blue noise) distribution.
+ *
+ * Bridson's algorithm: a point is accepted only if no accepted point lies within the radius, found by
+ * looking at the 5 x 5 background cells around it (cells of radius / sqrt(2) hold at most one point).
+ * Each active point tries candidates spaced around the edge of its disk (Roberts' variant, which packs
+ * tighter with fewer candidates) until one is accepted or it gives up. When the active list runs dry, the
+ * growth restarts from a free maze cell not yet reached, so walls and disconnected parts of the maze are
+ * covered too.
+ *
+ * Large scatters first measure the density on a strip of the maze, so one full pass is usually enough.
+ * Otherwise the radius is corrected from the last two passes, at most MAX_PASSES of them, and a last
+ * pass still short is topped up with slightly smaller disks rather than started over.
+ */
+size_t CollectibleStore::scatter(const std::vector<std::vector<int>>& grid, size_t count, float margin, uint32_t seed,
+								 std::vector<glm::vec3>& positions)
+{
+	std::vector<uint32_t> freeCells; // x * depth + z
+	const size_t width = grid.size();
+	const size_t depth = width > 0 ? grid[0].size() : 0;
+	for (size_t x = 0; x < width; x++)
+		for (size_t z = 0; z < depth; z++)
+			if (grid[x][z] == 0)
+				freeCells.push_back((uint32_t)(x * depth + z));
+
+	if (freeCells.empty() || count == 0)
+		return 0;
+
+	Random random(seed);
+	for (size_t i = freeCells.size() - 1; i > 0; i--)
+		std::swap(freeCells[i], freeCells[random.below(i + 1)]);
+
+	positions.reserve(positions.size() + count);
+
+	// No room inside the margins, every point goes to the centre of a cell
+	const float usable = margin < 0.5f ? 1.0f - 2.0f * margin : 0.0f;
+	if (usable <= 0.0f)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint32_t cell = freeCells[i % freeCells.size()];
+			positions.push_back(glm::vec3(cell / depth + 0.5f, 0.0f, cell % depth + 0.5f));
+		}
+		return count;
+	}
+
+	// Free cells as one flat mask, read for every candidate
+	std::vector<uint8_t> open(width * depth, 0);
+	for (size_t s = 0; s < freeCells.size(); s++)
+		open[freeCells[s]] = 1;
+
+	const size_t first = positions.size();
+	std::vector<glm::vec2> background; // Point in each background cell, x below 0 if empty
+	std::vector<uint32_t> active;
+
+	// One Bridson pass over the columns below a limit, returns the number of points placed. A top up keeps
+	// the points of the last pass, placed with a larger radius, and grows from them into the gaps.
+	auto pass = [&](float radius, size_t limit, bool topUp) -> size_t
+	{
+		const float side = radius * 0.70710678f;
+		const float radius2 = radius * radius;
+		const size_t columns = (size_t)(limit / side) + 1;
+		const size_t rows = (size_t)(depth / side) + 1;
+		background.assign(columns * rows, glm::vec2(-1.0f));
+		active.clear();
+		if (!topUp)
+			positions.resize(first);
+
+		// Kept points are further apart than the cell diagonal, one per cell
+		for (size_t i = first; i < positions.size(); i++)
+		{
+			background[(size_t)(positions[i].x / side) * rows + (size_t)(positions[i].z / side)] =
+				glm::vec2(positions[i].x, positions[i].z);
+			active.push_back((uint32_t)i);
+		}
+
+		// Accepts a point if it is inside the margins of a free cell and no accepted point is within the radius
+		auto tryAdd = [&](float x, float z) -> bool
+		{
+			if (x < 0.0f || z < 0.0f || x >= (float)limit || z >= (float)depth)
+				return false;
+			const size_t cellX = (size_t)x;
+			const size_t cellZ = (size_t)z;
+			if (!open[cellX * depth + cellZ] || x - cellX < margin || x - cellX > 1.0f - margin ||
+				z - cellZ < margin || z - cellZ > 1.0f - margin)
+				return false;
+
+			const size_t column = (size_t)(x / side);
+			const size_t row = (size_t)(z / side);
+			const size_t c0 = column >= 2 ? column - 2 : 0;
+			const size_t r0 = row >= 2 ? row - 2 : 0;
+			const size_t c1 = std::min(column + 2, columns - 1);
+			const size_t r1 = std::min(row + 2, rows - 1);
+			for (size_t c = c0; c <= c1; c++)
+			{
+				const glm::vec2* cells = &background[c * rows];
+				for (size_t r = r0; r <= r1; r++)
+				{
+					const float dx = cells[r].x - x;
+					const float dz = cells[r].y - z;
+					if (cells[r].x >= 0.0f && dx * dx + dz * dz < radius2)
+						return false;
+				}
+			}
+
+			background[column * rows + row] = glm::vec2(x, z);
+			active.push_back((uint32_t)positions.size());
+			positions.push_back(glm::vec3(x, 0.0f, z));
+			return true;
+		};
+
+		for (size_t s = 0; s < freeCells.size(); s++)
+		{
+			// Restart the growth inside a cell the disks have not reached, after the kept points
+			if (freeCells[s] / depth >= limit)
+				continue;
+			const float x0 = (float)(freeCells[s] / depth) + margin;
+			const float z0 = (float)(freeCells[s] % depth) + margin;
+			for (int attempt = 0; attempt < SEED_ATTEMPTS && active.empty(); attempt++)
+				tryAdd(x0 + usable * random.unit(), z0 + usable * random.unit());
+
+			while (!active.empty())
+			{
+				const size_t pick = random.below(active.size());
+				const glm::vec3 centre = positions[active[pick]];
+
+				// Twelve candidates 30 degrees apart just outside the disk, from a random start, so the
+				// disks pack tightly and few candidates are needed
+				const float start = 6.28318531f * random.unit();
+				float dx = radius * ANNULUS_EDGE * cosf(start);
+				float dz = radius * ANNULUS_EDGE * sinf(start);
+				bool placed = false;
+				for (int attempt = 0; attempt < 12 && !placed; attempt++)
+				{
+					placed = tryAdd(centre.x + dx, centre.z + dz);
+					const float turned = dx * 0.86602540f - dz * 0.5f;
+					dz = dx * 0.5f + dz * 0.86602540f;
+					dx = turned;
+				}
+
+				if (!placed)
+				{
+					active[pick] = active.back();
+					active.pop_back();
+				}
+			}
+		}
+
+		return positions.size() - first;
+	};
+
+	// A maximal set of these disks holds about 0.75 / radius^2 points per unit area, a first guess
+	const float target = count * (1.0f + 0.5f * SURPLUS); // Middle of the accepted surplus
+	float radius = sqrtf(DISK_DENSITY * freeCells.size() * usable * usable / target);
+
+	// Walls and margins make the real density differ, measure it on a strip of the maze holding
+	// PILOT_POINTS or so, when that is a small part of the count
+	if (count >= PILOT_POINTS * 4 && width > 1)
+	{
+		const size_t limit = std::max(width * PILOT_POINTS / count, (size_t)1);
+		size_t stripCells = 0;
+		for (size_t i = 0; i < limit * depth; i++)
+			stripCells += open[i];
+
+		const size_t pilot = stripCells > 0 ? pass(radius, limit, false) : 0;
+		if (pilot > 0)
+			radius *= sqrtf(pilot * (float)freeCells.size() / (stripCells * target));
+	}
+
+	float lastRadius = 0.0f;
+	size_t lastPlaced = 0;
+	size_t placed = 0;
+	for (int passes = 1;; passes++)
+	{
+		placed = pass(radius, width, false);
+		if (placed >= count && placed - count <= count * SURPLUS)
+			break;
+		if (passes == MAX_PASSES)
+			break;
+
+		// The points placed go as radius^-k, k measured from the last two passes (2 for a large open area)
+		float exponent = 2.0f;
+		if (lastPlaced > 0 && lastPlaced != placed && lastRadius != radius)
+		{
+			exponent = logf((float)placed / lastPlaced) / logf(lastRadius / radius);
+			exponent = std::min(std::max(exponent, MIN_EXPONENT), MAX_EXPONENT);
+		}
+		lastRadius = radius;
+		lastPlaced = placed;
+		radius *= powf((float)placed / target, 1.0f / exponent);
+	}
+
+	// Still short after MAX_PASSES, fill the gaps of the last pass with slightly smaller disks
+	while (placed < count)
+	{
+		radius *= TOP_UP_SHRINK;
+		placed = pass(radius, width, true);
+	}
+
+	// Drop the surplus at random, usually a few percent of the points, so the spacing stays close to the radius
+	for (size_t i = positions.size() - 1; i > first; i--)
+		std::swap(positions[i], positions[first + random.below(i - first + 1)]);
+	positions.resize(first + count);
+
+	return count;
+}
@@ -0,0 +1,348 @@
+/**
+ * @file Crowd.cpp
+ * @brief Contains the implementation of the Crowd class.
+ */
+
+#include <math.h>	 // For floorf and sqrtf
+#include <algorithm> // For std::fill
+
+#include <./include/Crowd.h>
+#include <./include/GridCollider.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const size_t AGENT_GRAIN = 1024;	// Agents per job
+	const float STEERING = 8.0f;		// Fraction of the gap to the desired velocity closed per second
+	const float SEPARATION = 2.0f;		// Push between touching agents, in top speeds
+	const unsigned MAX_NEIGHBOURS = 16; // Agents pushing one agent at most, bounds the cost in a packed cell
+
+	// Neighbouring cells, x then z
+	const int NEIGHBOURS[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+}
+
+Crowd::Crowd(float radius, unsigned cellCapacity)
+	: radius(radius), cellCapacity(cellCapacity), grid(NULL), width(0), depth(0), goal(-1), cellStarts(1, 0)
+{
+}
+
+/**
+ * @brief Setter method for the maze the agents move in.
+ */
+void Crowd::setGrid(const std::vector<std::vector<int>>& grid)
+{
+	this->grid = &grid;
+	width = (int)grid.size();
+	depth = width > 0 ? (int)grid[0].size() : 0;
+	goal = -1;
+	distances.assign((size_t)(width * depth), -1);
+	cellStarts.assign((size_t)(width * depth) + 1, 0);
+	order.clear();
+}
+
+/**
+ * @brief Removes every agent.
+ */
+void Crowd::clear()
+{
+	positions.clear();
+	previousPositions.clear();
+	velocities.clear();
+	speeds.clear();
+	types.clear();
+	order.clear();
+	agentCells.clear();
+	std::fill(cellStarts.begin(), cellStarts.end(), 0);
+}
+
+/**
+ * @brief Reserves room for agents about to be added.
+ */
+void Crowd::reserve(size_t count)
+{
+	positions.reserve(count);
+	previousPositions.reserve(count);
+	velocities.reserve(count);
+	speeds.reserve(count);
+	types.reserve(count);
+	order.reserve(count);
+	agentCells.reserve(count);
+}
+
+/**
+ * @brief Adds an agent at rest.
+ */
+uint32_t Crowd::add(const glm::vec3& position, TYPE type, float speed)
+{
+	positions.push_back(position);
+	previousPositions.push_back(position);
+	velocities.push_back(glm::vec3(0.0f));
+	speeds.push_back(speed);
+	types.push_back(type);
+	return (uint32_t)(positions.size() - 1);
+}
+
+/**
+ * @brief Getter method for the cell a position is in.
+ *
+ * @return Index of the cell, -1 outside the grid.
+ */
+int Crowd::getCell(const glm::vec3& position) const
+{
+	const int x = (int)floorf(position.x);
+	const int z = (int)floorf(position.z);
+	if (x < 0 || z < 0 || x >= width || z >= depth)
+		return -1;
+	return x * depth + z;
+}
+
+/**
+ * @brief Setter method for the point the agents head for.
+ *
+ * The distance field is a breadth first search over the open cells, from the goal outwards.
+ */
+void Crowd::setGoal(const glm::vec3& position)
+{
+	int cell = getCell(position);
+	if (cell >= 0 && (*grid)[cell / depth][cell % depth] == 1)
+		cell = -1;
+
+	if (cell == goal)
+		return;
+
+	goal = cell;
+	std::fill(distances.begin(), distances.end(), -1);
+	if (goal < 0)
+		return;
+
+	std::vector<int> frontier;
+	frontier.reserve(distances.size());
+	frontier.push_back(goal);
+	distances[goal] = 0;
+
+	for (size_t next = 0; next < frontier.size(); next++)
+	{
+		const int current = frontier[next];
+		const int x = current / depth;
+		const int z = current % depth;
+		for (int n = 0; n < 4; n++)
+		{
+			const int nx = x + NEIGHBOURS[n][0];
+			const int nz = z + NEIGHBOURS[n][1];
+			if (nx < 0 || nz < 0 || nx >= width || nz >= depth || (*grid)[nx][nz] == 1)
+				continue;
+
+			const int neighbour = nx * depth + nz;
+			if (distances[neighbour] >= 0)
+				continue;
+
+			distances[neighbour] = distances[current] + 1;
+			frontier.push_back(neighbour);
+		}
+	}
+}
+
+/**
+ * @brief Counts the agents in every cell and sorts them by cell (a counting sort, linear in the agents).
+ *
+ * Afterwards the agents in cell c are order[cellStarts[c]] to order[cellStarts[c + 1] - 1].
+ */
+void Crowd::binAgents()
+{
+	const size_t cells = (size_t)(width * depth);
+	const size_t count = positions.size();
+
+	std::fill(cellStarts.begin(), cellStarts.end(), 0);
+	agentCells.resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const int cell = getCell(positions[i]);
+		agentCells[i] = cell;
+		if (cell >= 0)
+			cellStarts[cell]++;
+	}
+
+	// Running totals give the end of each cell, filling backwards moves each to its start
+	for (size_t c = 1; c < cells; c++)
+		cellStarts[c] += cellStarts[c - 1];
+	cellStarts[cells] = cells > 0 ? cellStarts[cells - 1] : 0;
+
+	order.resize(cellStarts[cells]);
+	for (size_t i = count; i-- > 0;)
+	{
+		if (agentCells[i] >= 0)
+			order[--cellStarts[agentCells[i]]] = (uint32_t)i;
+	}
+}
+
+/**
+ * @brief Steps a range of agents, reading only the previous positions and the binning.
+ *
+ * @param begin First agent.
+ * @param end One past the last agent.
+ * @param step Seconds to advance.
+ */
+void Crowd::stepAgents(size_t begin, size_t end, float step)
+{
+	const GridCollider collider(*grid);
+	const glm::vec3 extent(radius);
+	const float spacing = 2.0f * radius;
+	const float steering = STEERING * step < 1.0f ? STEERING * step : 1.0f;
+
+	for (size_t i = begin; i < end; i++)
+	{
+		const glm::vec3& position = previousPositions[i];
+		const float speed = speeds[i];
+		const int cell = agentCells[i];
+
+		// Head for the least crowded neighbouring cell one step closer to the goal, wait if all are full
+		glm::vec3 desired(0.0f);
+		if (cell >= 0 && distances[cell] > 0)
+		{
+			const int x = cell / depth;
+			const int z = cell % depth;
+			int best = -1;
+			uint32_t bestOccupancy = cellCapacity;
+			for (int n = 0; n < 4; n++)
+			{
+				const int nx = x + NEIGHBOURS[n][0];
+				const int nz = z + NEIGHBOURS[n][1];
+				if (nx < 0 || nz < 0 || nx >= width || nz >= depth)
+					continue;
+
+				const int neighbour = nx * depth + nz;
+				const uint32_t occupancy = cellStarts[neighbour + 1] - cellStarts[neighbour];
+				if (distances[neighbour] < 0 || distances[neighbour] >= distances[cell] || occupancy >= bestOccupancy)
+					continue;
+
+				best = n;
+				bestOccupancy = occupancy;
+			}
+
+			if (best >= 0)
+			{
+				const float dx = (float)(x + NEIGHBOURS[best][0]) + 0.5f - position.x;
+				const float dz = (float)(z + NEIGHBOURS[best][1]) + 0.5f - position.z;
+				const float length = sqrtf(dx * dx + dz * dz);
+				if (length > 1e-6f)
+					desired = glm::vec3(dx / length * speed, 0.0f, dz / length * speed);
+			}
+		}
+
+		// Push away from agents closer than two radii, found through the 3x3 cells around
+		glm::vec3 push(0.0f);
+		if (cell >= 0)
+		{
+			const int x = cell / depth;
+			const int z = cell % depth;
+			unsigned pushed = 0;
+			for (int nx = x - 1; nx <= x + 1 && pushed < MAX_NEIGHBOURS; nx++)
+			{
+				for (int nz = z - 1; nz <= z + 1 && pushed < MAX_NEIGHBOURS; nz++)
+				{
+					if (nx < 0 || nz < 0 || nx >= width || nz >= depth)
+						continue;
+
+					const int neighbour = nx * depth + nz;
+					for (uint32_t k = cellStarts[neighbour]; k < cellStarts[neighbour + 1] && pushed < MAX_NEIGHBOURS; k++)
+					{
+						const uint32_t other = order[k];
+						if (other == i)
+							continue;
+
+						float dx = position.x - previousPositions[other].x;
+						float dz = position.z - previousPositions[other].z;
+						float distance2 = dx * dx + dz * dz;
+						if (distance2 >= spacing * spacing)
+							continue;
+
+						// Agents on the same spot part along x, the lower index to the right
+						if (distance2 < 1e-12f)
+						{
+							dx = other > i ? 1e-3f : -1e-3f;
+							dz = 0.0f;
+							distance2 = dx * dx;
+						}
+
+						const float distance = sqrtf(distance2);
+						const float overlap = (spacing - distance) / spacing;
+						push.x += dx / distance * overlap;
+						push.z += dz / distance * overlap;
+						pushed++;
+					}
+				}
+			}
+		}
+
+		desired += push * (SEPARATION * speed);
+
+		glm::vec3 velocity = velocities[i];
+		velocity += (desired - velocity) * steering;
+
+		// Pushes may not launch an agent faster than half again its top speed
+		const float limit = 1.5f * speed;
+		const float length2 = velocity.x * velocity.x + velocity.z * velocity.z;
+		if (length2 > limit * limit)
+			velocity *= limit / sqrtf(length2);
+		velocity.y = 0.0f;
+
+		velocities[i] = velocity;
+		positions[i] = collider.move(position, extent, velocity * step);
+	}
+}
+
+/**
+ * @brief Steps every agent.
+ */
+void Crowd::update(float step, JobSystem* jobs)
+{
+	previousPositions = positions;
+	if (positions.empty() || grid == NULL)
+		return;
+
+	binAgents();
+
+	const size_t count = positions.size();
+	if (jobs != NULL && jobs->getWorkerCount() > 1)
+		jobs->parallelFor(count, AGENT_GRAIN, [this, step](size_t begin, size_t end, unsigned) { stepAgents(begin, end, step); });
+	else
+		stepAgents(0, count, step);
+}
+
+size_t Crowd::size() const { return positions.size(); }
+
+bool Crowd::empty() const { return positions.empty(); }
+
+unsigned Crowd::getCellCapacity() const { return cellCapacity; }
+
+/**
+ * @brief Getter method for the number of agents in a cell at the last update.
+ */
+unsigned Crowd::getOccupancy(int x, int z) const
+{
+	if (x < 0 || z < 0 || x >= width || z >= depth)
+		return 0;
+	const int cell = x * depth + z;
+	return cellStarts[cell + 1] - cellStarts[cell];
+}
+
+/**
+ * @brief Getter method for the distance of a cell from the goal.
+ */
+int Crowd::getDistance(int x, int z) const
+{
+	if (x < 0 || z < 0 || x >= width || z >= depth)
+		return -1;
+	return distances[x * depth + z];
+}
+
+const glm::vec3* Crowd::getPositions() const { return positions.empty() ? NULL : &positions[0]; }
+
+const glm::vec3* Crowd::getPreviousPositions() const { return previousPositions.empty() ? NULL : &previousPositions[0]; }
+
+const glm::vec3* Crowd::getVelocities() const { return velocities.empty() ? NULL : &velocities[0]; }
+
+const float* Crowd::getSpeeds() const { return speeds.empty() ? NULL : &speeds[0]; }
+
+const TYPE* Crowd::getTypes() const { return types.empty() ? NULL : &types[0]; }
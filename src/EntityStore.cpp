@@ -0,0 +1,497 @@
+/**
+ * @file EntityStore.cpp
+ * @brief Contains the implementation of the EntityStore class.
+ */
+
+#include <algorithm> // For std::sort, std::unique, std::find and std::fill
+#include <functional> // For std::greater
+
+#include <./include/EntityStore.h>
+#include <./include/MatrixBatch.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	// Transform flags
+	const uint8_t LOCAL_DIRTY = 1;	 // World transform out of date
+	const uint8_t WORLD_CHANGED = 2; // World transform recomputed during this update
+
+	const size_t MATRIX_GRAIN = 4096; // MVP matrices per job
+}
+
+const EntityHandle EntityStore::INVALID = { 0xFFFFFFFFu, 0 };
+
+EntityStore::EntityStore(size_t capacity)
+	: meshTable(1)
+{
+	positions.reserve(capacity);
+	rotations.reserve(capacity);
+	scales.reserve(capacity);
+	sizes.reserve(capacity);
+	types.reserve(capacity);
+	worldPositions.reserve(capacity);
+	worldRotations.reserve(capacity);
+	worldScales.reserve(capacity);
+	parents.reserve(capacity);
+	flags.reserve(capacity);
+	meshes.reserve(capacity);
+	owners.reserve(capacity);
+	indices.reserve(capacity);
+	generations.reserve(capacity);
+}
+
+/**
+ * @brief Hands out a slot for the entity at a dense index, reusing destroyed slots first.
+ *
+ * @return The slot.
+ */
+uint32_t EntityStore::allocateSlot(uint32_t index)
+{
+	uint32_t slot;
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		slot = (uint32_t)indices.size();
+		indices.push_back(0);
+		generations.push_back(1); // Generation 0 is never handed out, see INVALID
+	}
+
+	indices[slot] = index;
+	return slot;
+}
+
+/**
+ * @brief Creates a root entity.
+ */
+EntityHandle EntityStore::create(TYPE type, const glm::vec3& position, float size)
+{
+	EntityHandle handle;
+	create(1, type, &position, size, &handle);
+	return handle;
+}
+
+/**
+ * @brief Creates entities of one type at once.
+ */
+void EntityStore::create(size_t count, TYPE type, const glm::vec3* positions, float size, EntityHandle* handles)
+{
+	const size_t first = this->positions.size();
+
+	this->positions.insert(this->positions.end(), positions, positions + count);
+	rotations.resize(first + count, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+	scales.resize(first + count, 1.0f);
+	sizes.resize(first + count, size);
+	types.resize(first + count, type);
+	worldPositions.insert(worldPositions.end(), positions, positions + count);
+	worldRotations.resize(first + count, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+	worldScales.resize(first + count, 1.0f);
+	parents.resize(first + count, INVALID);
+	flags.resize(first + count, LOCAL_DIRTY);
+	meshes.resize(first + count, 0);
+	owners.resize(first + count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint32_t slot = allocateSlot((uint32_t)(first + i));
+		owners[first + i] = slot;
+		if (handles != NULL)
+		{
+			handles[i].slot = slot;
+			handles[i].generation = generations[slot];
+		}
+	}
+}
+
+/**
+ * @brief Removes the entity at a dense index by moving the last entity into its place.
+ */
+void EntityStore::remove(uint32_t index)
+{
+	const uint32_t last = (uint32_t)positions.size() - 1;
+	const uint32_t slot = owners[index];
+
+	if (index != last)
+	{
+		positions[index] = positions[last];
+		rotations[index] = rotations[last];
+		scales[index] = scales[last];
+		sizes[index] = sizes[last];
+		types[index] = types[last];
+		worldPositions[index] = worldPositions[last];
+		worldRotations[index] = worldRotations[last];
+		worldScales[index] = worldScales[last];
+		parents[index] = parents[last];
+		flags[index] = flags[last] | LOCAL_DIRTY; // Its MVP matrix moves too, see updateMatrices()
+		meshes[index] = meshes[last];
+		owners[index] = owners[last];
+		indices[owners[index]] = index;
+	}
+
+	positions.pop_back();
+	rotations.pop_back();
+	scales.pop_back();
+	sizes.pop_back();
+	types.pop_back();
+	worldPositions.pop_back();
+	worldRotations.pop_back();
+	worldScales.pop_back();
+	parents.pop_back();
+	flags.pop_back();
+	meshes.pop_back();
+	owners.pop_back();
+
+	generations[slot]++;
+	freeSlots.push_back(slot);
+}
+
+/**
+ * @brief Destroys an entity.
+ */
+bool EntityStore::destroy(EntityHandle handle)
+{
+	const int index = getIndex(handle);
+	if (index < 0)
+		return false;
+
+	remove((uint32_t)index);
+	return true;
+}
+
+/**
+ * @brief Destroys entities at once.
+ *
+ * Removing from the highest dense index down means no entity still to be removed is moved by an
+ * earlier removal.
+ */
+size_t EntityStore::destroy(const EntityHandle* handles, size_t count)
+{
+	std::vector<uint32_t> doomed;
+	doomed.reserve(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const int index = getIndex(handles[i]);
+		if (index >= 0)
+			doomed.push_back((uint32_t)index);
+	}
+
+	std::sort(doomed.begin(), doomed.end(), std::greater<uint32_t>());
+	doomed.erase(std::unique(doomed.begin(), doomed.end()), doomed.end());
+
+	for (size_t i = 0; i < doomed.size(); i++)
+		remove(doomed[i]);
+
+	return doomed.size();
+}
+
+/**
+ * @brief Destroys every entity, invalidating all handles.
+ */
+void EntityStore::clear()
+{
+	for (size_t i = 0; i < owners.size(); i++)
+	{
+		generations[owners[i]]++;
+		freeSlots.push_back(owners[i]);
+	}
+
+	positions.clear();
+	rotations.clear();
+	scales.clear();
+	sizes.clear();
+	types.clear();
+	worldPositions.clear();
+	worldRotations.clear();
+	worldScales.clear();
+	parents.clear();
+	flags.clear();
+	meshes.clear();
+	owners.clear();
+	meshTable.resize(1);
+}
+
+bool EntityStore::isAlive(EntityHandle handle) const { return getIndex(handle) >= 0; }
+
+/**
+ * @brief Getter method for the dense index of an entity.
+ */
+int EntityStore::getIndex(EntityHandle handle) const
+{
+	if (handle.slot >= generations.size() || generations[handle.slot] != handle.generation)
+		return -1;
+	return (int)indices[handle.slot];
+}
+
+/**
+ * @brief Getter method for the handle of the entity at a dense index.
+ */
+EntityHandle EntityStore::getHandle(size_t index) const
+{
+	EntityHandle handle = { owners[index], generations[owners[index]] };
+	return handle;
+}
+
+/**
+ * @brief Setter method for the position of an entity, relative to its parent.
+ */
+bool EntityStore::setPosition(EntityHandle handle, const glm::vec3& position)
+{
+	const int index = getIndex(handle);
+	if (index < 0)
+		return false;
+
+	positions[index] = position;
+	flags[index] |= LOCAL_DIRTY;
+	return true;
+}
+
+/**
+ * @brief Setter method for the rotation of an entity, relative to its parent.
+ */
+bool EntityStore::setRotation(EntityHandle handle, const glm::quat& rotation)
+{
+	const int index = getIndex(handle);
+	if (index < 0)
+		return false;
+
+	rotations[index] = rotation;
+	flags[index] |= LOCAL_DIRTY;
+	return true;
+}
+
+/**
+ * @brief Setter method for the scale of an entity, relative to its parent.
+ */
+bool EntityStore::setScale(EntityHandle handle, float scale)
+{
+	const int index = getIndex(handle);
+	if (index < 0)
+		return false;
+
+	scales[index] = scale;
+	flags[index] |= LOCAL_DIRTY;
+	return true;
+}
+
+/**
+ * @brief Setter method for the parent of an entity.
+ */
+bool EntityStore::setParent(EntityHandle handle, EntityHandle parent)
+{
+	const int index = getIndex(handle);
+	if (index < 0 || (parent != INVALID && !isAlive(parent)))
+		return false;
+
+	// Refuse cycles: the entity must not be among the parent's ancestors
+	for (EntityHandle ancestor = parent; ancestor != INVALID; ancestor = getParent(ancestor))
+	{
+		if (ancestor == handle)
+			return false;
+	}
+
+	parents[index] = parent;
+	flags[index] |= LOCAL_DIRTY;
+	return true;
+}
+
+/**
+ * @brief Getter method for the parent of an entity.
+ */
+EntityHandle EntityStore::getParent(EntityHandle handle) const
+{
+	const int index = getIndex(handle);
+	if (index < 0 || !isAlive(parents[index]))
+		return INVALID;
+	return parents[index];
+}
+
+/**
+ * @brief Brings the world transform of an entity up to date, its ancestors' first.
+ *
+ * An entity is recomputed if its own local transform changed or its parent's world transform was
+ * recomputed during this update. Entities already recomputed during this update are left alone, so each
+ * is done once.
+ *
+ * @param index Dense index of the entity.
+ */
+void EntityStore::updateWorldTransform(uint32_t index)
+{
+	int parent = -1;
+	if (parents[index] != INVALID)
+	{
+		parent = getIndex(parents[index]);
+		if (parent < 0)
+		{
+			// Parent destroyed, the entity becomes a root
+			parents[index] = INVALID;
+			flags[index] |= LOCAL_DIRTY;
+		}
+		else
+		{
+			updateWorldTransform((uint32_t)parent);
+			if ((flags[parent] & WORLD_CHANGED) && !(flags[index] & WORLD_CHANGED))
+				flags[index] |= LOCAL_DIRTY;
+		}
+	}
+
+	if (!(flags[index] & LOCAL_DIRTY))
+		return;
+
+	if (parent >= 0)
+	{
+		// The parent's scale and rotation apply to the local translation, then its translation
+		worldPositions[index] = worldPositions[parent] + worldRotations[parent] * (positions[index] * worldScales[parent]);
+		worldRotations[index] = worldRotations[parent] * rotations[index];
+		worldScales[index] = worldScales[parent] * scales[index];
+	}
+	else
+	{
+		worldPositions[index] = positions[index];
+		worldRotations[index] = rotations[index];
+		worldScales[index] = scales[index];
+	}
+	flags[index] = WORLD_CHANGED;
+}
+
+/**
+ * @brief Writes the MVP matrices of a run of entities from their world transforms.
+ *
+ * The model matrices are written into out first and multiplied in place by the view projection in one
+ * MatrixBatch call, each column of a product only depends on the same column of the model matrix.
+ *
+ * @param viewProjection Projection times view matrix.
+ * @param out MVP array, indexed like the entities.
+ * @param begin First entity of the run.
+ * @param end One past the last entity of the run.
+ */
+void EntityStore::writeMatrices(const glm::mat4& viewProjection, glm::mat4* out, size_t begin, size_t end) const
+{
+	for (size_t i = begin; i < end; i++)
+	{
+		glm::mat4 model = glm::mat4_cast(worldRotations[i]);
+		model[0] *= worldScales[i];
+		model[1] *= worldScales[i];
+		model[2] *= worldScales[i];
+		model[3] = glm::vec4(worldPositions[i], 1.0f);
+		out[i] = model;
+	}
+
+	MatrixBatch::multiply(viewProjection, out + begin, out + begin, end - begin);
+}
+
+/**
+ * @brief Recomputes the world transforms and MVP matrices that are out of date.
+ */
+size_t EntityStore::updateMatrices(const glm::mat4& viewProjection, bool viewProjectionChanged, std::vector<glm::mat4>& mvps,
+								   JobSystem* jobs)
+{
+	const size_t count = positions.size();
+	for (size_t i = 0; i < count; i++)
+		updateWorldTransform((uint32_t)i);
+
+	if (count == 0)
+	{
+		mvps.clear();
+		return 0;
+	}
+
+	if (viewProjectionChanged || mvps.size() != count)
+	{
+		mvps.resize(count);
+		glm::mat4* out = &mvps[0];
+		if (jobs != NULL)
+		{
+			jobs->parallelFor(count, MATRIX_GRAIN, [&](size_t begin, size_t end, unsigned)
+				{ writeMatrices(viewProjection, out, begin, end); });
+		}
+		else
+		{
+			writeMatrices(viewProjection, out, 0, count);
+		}
+		std::fill(flags.begin(), flags.end(), 0);
+		return count;
+	}
+
+	// Only the entities that moved, a run of neighbours at a time
+	size_t updated = 0;
+	for (size_t i = 0; i < count;)
+	{
+		if (!(flags[i] & WORLD_CHANGED))
+		{
+			flags[i] = 0;
+			i++;
+			continue;
+		}
+
+		size_t end = i + 1;
+		while (end < count && (flags[end] & WORLD_CHANGED))
+			end++;
+
+		writeMatrices(viewProjection, &mvps[0], i, end);
+		std::fill(flags.begin() + i, flags.begin() + end, 0);
+		updated += end - i;
+		i = end;
+	}
+
+	return updated;
+}
+
+/**
+ * @brief Setter method for the shared mesh an entity is drawn with.
+ *
+ * Meshes stay in the table until clear(), so ids remain valid while entities come and go.
+ */
+bool EntityStore::setMesh(EntityHandle handle, const MeshRef& mesh)
+{
+	const int index = getIndex(handle);
+	if (index < 0)
+		return false;
+
+	size_t id = 0;
+	if (mesh)
+	{
+		id = std::find(meshTable.begin(), meshTable.end(), mesh) - meshTable.begin();
+		if (id == meshTable.size())
+		{
+			if (id > 0xFFFF)
+				return false;
+			meshTable.push_back(mesh);
+		}
+	}
+
+	meshes[index] = (uint16_t)id;
+	return true;
+}
+
+/**
+ * @brief Getter method for a mesh by id.
+ */
+const MeshRef& EntityStore::getMesh(uint16_t id) const { return meshTable[id]; }
+
+size_t EntityStore::size() const { return positions.size(); }
+
+bool EntityStore::empty() const { return positions.empty(); }
+
+const glm::vec3* EntityStore::getPositions() const { return positions.empty() ? NULL : &positions[0]; }
+
+const glm::quat* EntityStore::getRotations() const { return rotations.empty() ? NULL : &rotations[0]; }
+
+const float* EntityStore::getScales() const { return scales.empty() ? NULL : &scales[0]; }
+
+float* EntityStore::getSizes() { return sizes.empty() ? NULL : &sizes[0]; }
+
+const float* EntityStore::getSizes() const { return sizes.empty() ? NULL : &sizes[0]; }
+
+const TYPE* EntityStore::getTypes() const { return types.empty() ? NULL : &types[0]; }
+
+const uint16_t* EntityStore::getMeshes() const { return meshes.empty() ? NULL : &meshes[0]; }
+
+const glm::vec3* EntityStore::getWorldPositions() const { return worldPositions.empty() ? NULL : &worldPositions[0]; }
+
+const glm::quat* EntityStore::getWorldRotations() const { return worldRotations.empty() ? NULL : &worldRotations[0]; }
+
+const float* EntityStore::getWorldScales() const { return worldScales.empty() ? NULL : &worldScales[0]; }
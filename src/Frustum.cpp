@@ -0,0 +1,53 @@
+/**
+ * @file Frustum.cpp
+ * @brief Contains the implementation of the Frustum class.
+ */
+
+#include <./include/Frustum.h>
+
+using namespace gpp; // GPP namespace
+
+Frustum::Frustum()
+{
+	// Accept everything until planes are set
+	for (int i = 0; i < 6; i++)
+		planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+/**
+ * @brief Constructor extracting the planes from a view projection matrix (Gribb/Hartmann).
+ */
+Frustum::Frustum(const glm::mat4& m)
+{
+	// Rows of the (column major) matrix
+	glm::vec4 row[4];
+	for (int r = 0; r < 4; r++)
+		row[r] = glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]);
+
+	planes[0] = row[3] + row[0]; // Left
+	planes[1] = row[3] - row[0]; // Right
+	planes[2] = row[3] + row[1]; // Bottom
+	planes[3] = row[3] - row[1]; // Top
+	planes[4] = row[3] + row[2]; // Near
+	planes[5] = row[3] - row[2]; // Far
+}
+
+/**
+ * @brief Tests an axis aligned bounding box against the frustum.
+ *
+ * Only the corner furthest along each plane normal is tested.
+ */
+bool Frustum::intersects(const glm::vec3& min, const glm::vec3& max) const
+{
+	for (int i = 0; i < 6; i++)
+	{
+		const glm::vec4& p = planes[i];
+		glm::vec3 corner(p.x >= 0.0f ? max.x : min.x,
+						 p.y >= 0.0f ? max.y : min.y,
+						 p.z >= 0.0f ? max.z : min.z);
+
+		if (p.x * corner.x + p.y * corner.y + p.z * corner.z + p.w < 0.0f)
+			return false;
+	}
+	return true;
+}
@@ -11,10 +11,14 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <./include/pointCube.h>
+#include <./include/MatrixBatch.h>
 
 /* STB_IMAGE_IMPLEMENTATION should be defined only once */
 #define STB_IMAGE_IMPLEMENTATION // Define STB_IMAGE_IMPLEMENTATION only once
@@ -47,51 +51,99 @@ string toString(T number)
 	return oss.str();
 }
 
+/**
+ * @brief Builds a model matrix from a translation and a scale per axis without full matrix products.
+ *
+ * @param position Translation.
+ * @param scale Scale along each axis.
+ * @return translate(position) * scale(scale).
+ */
+static glm::mat4 placed(const glm::vec3& position, const glm::vec3& scale)
+{
+	glm::mat4 result(1.0f);
+	result[0][0] = scale.x;
+	result[1][1] = scale.y;
+	result[2][2] = scale.z;
+	result[3] = glm::vec4(position, 1.0f);
+	return result;
+}
+
 GLuint vsid, // Vertex Shader ID
 	fsid,	 // Fragment Shader ID
-	progID,	 // Program ID
-	vbo,	 // Vertex Buffer ID
-	vib,	 // Vertex Index Buffer
-	to[1];	 // Texture ID
+	progID;	 // Program ID
 
 GLint positionID, // Position ID
 	colorID,	  // Color ID
 	textureID,	  // Texture ID
 	uvID,		  // UV ID
-	mvpID;		  // Model View Projection ID
+	mvpID,		  // Model View Projection ID
+	uvRectID,	  // Atlas rectangle ID
+	texturedID;	  // Textured flag ID
 
 GLenum error; // OpenGL Error Code
 
 
-// Filename for texture
-const string filename = "./assets/textures/grid.tga";
-// Please see ../assets/textures/ for more textures
-// const string filename = "./assets/textures/coordinates.tga";
-// const string filename = "./assets/textures/cube.tga";
-// const string filename = "./assets/textures/grid_wip.tga";
-// const string filename = "./assets/textures/minecraft.tga";
-// const string filename = "./assets/textures/texture.tga";
-// const string filename = "./assets/textures/texture_2.tga";
-// const string filename = "../assets/textures/uvtemplate.tga";
+// Texture used by the maze walls
+const string wallTexture = "./assets/textures/grid.tga";
 
-int width;						 // width of texture
-int height;						 // height of texture
-int comp_count;					 // Component of texture
-const int colour_components = 4; // 4 = RGBA
+// Font used by the HUD
+const string hudFont = "./assets/fonts/BBrick.ttf";
 
-// Texture image data
-unsigned char *img_data;
+// Pack of everything under ./assets (make pack), loose files are used when it is missing
+const string assetPackFile = "assets.pak";
+
+// Level holding the maze, collectibles and spawns (levelbuild), a maze is generated when it is missing
+const string levelFile = "./assets/levels/default.lvl";
+
+// Scene shader sources
+const string sceneVertexShader = "./assets/shaders/scene.vert";
+const string sceneFragmentShader = "./assets/shaders/scene.frag";
+
+// Watched for hot reload when the assets are loose
+const string assetDirectory = "./assets";
+
+// Crowd chasing the player, every BOSS_INTERVAL-th agent is a boss
+const size_t CROWD_AGENTS = 2000; // At most, small mazes get fewer (see initialiseCrowd())
+const size_t BOSS_INTERVAL = 50;
+const float NPC_SPEED = 1.5f; // Units per second, the player runs at 2
+const float BOSS_SPEED = 1.0f;
 
 // View Projection Matrices
 mat4 projection, view;
 
-Font font; // Game font
-
 float x_offset, y_offset, z_offset; // offset on screen (Vertex Shader)
 
 int score = 0;  // Initialize a score variable
 
-std::vector<PointCube> pointCubes;  // Store all point cubes
+/**
+ * @brief Reads a text asset (e.g. shader source) from the pack, or from the file system when it is not packed.
+ *
+ * @param path Path of the asset.
+ * @param pack Asset pack searched first.
+ * @param text Filled with the contents.
+ * @return true if the asset was read.
+ */
+static bool readTextAsset(const string& path, const AssetPack& pack, string& text)
+{
+	AssetView view;
+	if (pack.find(path, view))
+	{
+		text.assign(reinterpret_cast<const char*>(view.data), view.size);
+		return true;
+	}
+
+	ifstream file(path.c_str(), ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	ostringstream contents;
+	contents << file.rdbuf();
+	text = contents.str();
+	return true;
+}
+
 
 /**
  * @brief Constructs a new Game object with the specified context settings.
@@ -99,14 +151,23 @@ std::vector<PointCube> pointCubes;  // Store all point cubes
  * @param settings Context settings for the window.
  */
 Game::Game(int mazeWidth, int mazeHeight, const sf::ContextSettings& settings)
-	: maze(mazeWidth, mazeHeight), playerPosition(1.0f, 0.0f, 1.0f), playerSpeed(2.0f), // Initialize the maze and player
+	: player(EntityStore::INVALID), mazeWidth(mazeWidth), mazeHeight(mazeHeight), playerPosition(1.0f, 0.0f, 1.0f), playerSpeed(2.0f), playerSize(0.5f), // Initialize the maze and player
+	cameraVersion(0),
 	cameraPosition(0.0f, 5.0f, 10.0f),  // Initial camera position
 	cameraTarget(playerPosition),       // Camera looks at the player
 	cameraUp(0.0f, 1.0f, 0.0f),         // Up vector
 	cameraYaw(-90.0f),                  // Initial yaw
 	cameraPitch(0.0f),                  // Initial pitch
 	cameraSpeed(5.0f),                   // Camera speed 
-	points(0) // Initialize points to 0
+	points(0), // Initialize points to 0
+	hudPoints(-1), // Force the first HUD update
+	rateTime(0.0),
+	rateTick(0),
+	rateFrames(0),
+	wallLayer(0),
+	atlasTexture(0),
+	contextTime(0.0),
+	initialiseTime(0.0)
 {
 	// Create the SFML window with OpenGL context
 	window.create(sf::VideoMode(800, 600), "3D Maze Game", sf::Style::Default, settings);
@@ -129,8 +190,6 @@ Game::Game(int mazeWidth, int mazeHeight, const sf::ContextSettings& settings)
 	gluPerspective(45.0, window.getSize().x / window.getSize().y, 0.1, 100.0);
 	glMatrixMode(GL_MODELVIEW);
 
-	game_objects.push_back(new GameObject(gpp::TYPE::PLAYER)); // Correctly add the player object to the vector
-
 	// Initialize the view and projection matrices
 	viewMatrix = glm::lookAt(cameraPosition, playerPosition, cameraUp);
 	projectionMatrix = glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
@@ -139,50 +198,6 @@ Game::Game(int mazeWidth, int mazeHeight, const sf::ContextSettings& settings)
 
 }
 
-static void drawCube(float size) {
-	float halfSize = size / 2.0f;
-
-	glBegin(GL_QUADS);
-
-	// Front face
-	glVertex3f(-halfSize, -halfSize, halfSize);
-	glVertex3f(halfSize, -halfSize, halfSize);
-	glVertex3f(halfSize, halfSize, halfSize);
-	glVertex3f(-halfSize, halfSize, halfSize);
-
-	// Back face
-	glVertex3f(-halfSize, -halfSize, -halfSize);
-	glVertex3f(-halfSize, halfSize, -halfSize);
-	glVertex3f(halfSize, halfSize, -halfSize);
-	glVertex3f(halfSize, -halfSize, -halfSize);
-
-	// Left face
-	glVertex3f(-halfSize, -halfSize, -halfSize);
-	glVertex3f(-halfSize, -halfSize, halfSize);
-	glVertex3f(-halfSize, halfSize, halfSize);
-	glVertex3f(-halfSize, halfSize, -halfSize);
-
-	// Right face
-	glVertex3f(halfSize, -halfSize, -halfSize);
-	glVertex3f(halfSize, halfSize, -halfSize);
-	glVertex3f(halfSize, halfSize, halfSize);
-	glVertex3f(halfSize, -halfSize, halfSize);
-
-	// Top face
-	glVertex3f(-halfSize, halfSize, -halfSize);
-	glVertex3f(-halfSize, halfSize, halfSize);
-	glVertex3f(halfSize, halfSize, halfSize);
-	glVertex3f(halfSize, halfSize, -halfSize);
-
-	// Bottom face
-	glVertex3f(-halfSize, -halfSize, -halfSize);
-	glVertex3f(halfSize, -halfSize, -halfSize);
-	glVertex3f(halfSize, -halfSize, halfSize);
-	glVertex3f(-halfSize, -halfSize, halfSize);
-
-	glEnd();
-}
-
 /**
  * @brief Destroys the Game object.
  */
@@ -191,56 +206,46 @@ Game::~Game()
 	DEBUG_MSG("\nGame::~Game() Destructor\n");
 }
 
+/**
+ * @brief Follows the player with the camera and brings the out of date MVP matrices up to date.
+ *
+ * The view projection is only rebuilt when the player moved or the window was resized. Every MVP matrix
+ * is recomputed then, otherwise only the objects that moved have their world transform and MVP matrix
+ * recomputed.
+ */
 void Game::updateMVPMatrix()
 {
-	glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)window.getSize().x / (float)window.getSize().y, 0.1f, 100.0f);
-	glm::mat4 view = glm::lookAt(
+	camera.setLookAt(
 		glm::vec3(playerPosition.x, playerPosition.y + 2.0f, playerPosition.z + 5.0f), // Camera position
-		glm::vec3(playerPosition.x, playerPosition.y, playerPosition.z),               // Look at player
+		playerPosition,                                                                // Look at player
 		glm::vec3(0.0f, 1.0f, 0.0f)                                                    // Up vector
 	);
 
-	for (auto& gameObject : game_objects) {
-		if (gameObject != nullptr) {
-			gameObject->setMVPMatrix(projection * view * gameObject->getModelMatrix());
-		}
-	}
+	// Every MVP matrix when the camera moved, otherwise only the moved entities'
+	const unsigned version = camera.getVersion();
+	entities.updateMatrices(camera.getViewProjection(), version != cameraVersion, entityMVPs, &jobs);
+	cameraVersion = version;
 }
 
-void Game::handleInput(float deltaTime) {
-	glm::vec3 previousPosition = playerPosition; // Save previous position for collision detection
-	
-	//player movement controls
+/**
+ * @brief Passes the movement keys to the simulation and steers the camera with the mouse.
+ */
+void Game::handleInput() {
+	//player movement controls, applied by the simulation at its next tick
+	uint32_t input = 0;
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
-		playerPosition.z -= playerSpeed * deltaTime;
+		input |= (uint32_t)SIMULATION_INPUT::FORWARD;
 	}
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
-		playerPosition.z += playerSpeed * deltaTime;
+		input |= (uint32_t)SIMULATION_INPUT::BACK;
 	}
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-		playerPosition.x -= playerSpeed * deltaTime;
+		input |= (uint32_t)SIMULATION_INPUT::LEFT;
 	}
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-		playerPosition.x += playerSpeed * deltaTime;
-	}
-
-	// Collision detection with maze walls
-	int gridX = static_cast<int>(playerPosition.x);
-	int gridZ = static_cast<int>(playerPosition.z);
-	if (maze.getMaze()[gridX][gridZ] == 1) {
-		// Collision occurred, revert position
-		playerPosition = previousPosition;
-	}
-
-	// Check for collisions and update points
-	for (PointCube& cube : pointCubes) 
-	{
-		if (cube.checkCollision(playerPosition, playerSize)) 
-		{
-			points += 10; // Increment points
-			cube.collected = true; // Mark cube as collected
-		}
+		input |= (uint32_t)SIMULATION_INPUT::RIGHT;
 	}
+	simulation.setInput(input);
 
 
 	//mouse lock toggle
@@ -317,9 +322,59 @@ void Game::handleInput(float deltaTime) {
 }
 
 
+/**
+ * @brief Brings the drawn state up to the latest simulation snapshot.
+ *
+ * The player and the crowd are drawn between the snapshot's two states, one tick behind the simulation,
+ * so they move smoothly whatever the frame rate. Collectibles the simulation removed leave the drawn copy in the
+ * same order, which keeps both copies identical.
+ */
+void Game::updateFromSimulation()
+{
+	const SimulationSnapshot& snapshot = simulation.getSnapshot();
+	const double now = simulation.getTime();
+
+	const float alpha = (float)glm::clamp((now - snapshot.time) / simulation.getStep(), 0.0, 1.0);
+	const glm::vec3 position = glm::mix(snapshot.previous.playerPosition, snapshot.current.playerPosition, alpha);
+	if (position != playerPosition) {
+		playerPosition = position;
+		entities.setPosition(player, playerPosition);
+	}
+
+	const size_t agentCount = snapshot.agents.size() == snapshot.previousAgents.size() ? snapshot.agents.size() : 0;
+	agentPositions.resize(agentCount);
+	jobs.parallelFor(agentCount, 4096, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; i++)
+				agentPositions[i] = glm::mix(snapshot.previousAgents[i], snapshot.agents[i], alpha);
+		});
+
+	simulation.takeCollected(collectedIndices);
+	for (size_t i = 0; i < collectedIndices.size(); i++)
+		collectibles.remove(collectedIndices[i]);
+
+	if (snapshot.current.points != points) {
+		points = snapshot.current.points;
+		score = points;
+		std::cout << "Score: " << score << std::endl;
+	}
+
+	// Simulation and render rates, measured once a second
+	rateFrames++;
+	if (now - rateTime >= 1.0) {
+		const double elapsed = now - rateTime;
+		DEBUG_MSG("Simulation " + toString((snapshot.tick - rateTick) / elapsed) + " Hz, render " +
+			toString(rateFrames / elapsed) + " fps");
+		rateTime = now;
+		rateTick = snapshot.tick;
+		rateFrames = 0;
+	}
+}
+
 void Game::update(float deltaTime)
 {
-	handleInput(deltaTime);
+	handleInput();
+	updateFromSimulation();
 	updateMVPMatrix(); // Update the MVP matrix for all game objects
 
 	static float angle = 0.0f;
@@ -330,85 +385,14 @@ void Game::update(float deltaTime)
 	cameraPosition.x = playerPosition.x + radius * sin(angle);
 	cameraPosition.z = playerPosition.z + radius * cos(angle);
 
-	for (auto& cube : pointCubes) {
-		if (!cube.collected && cube.checkCollision(playerPosition, 0.5f)) { // Assuming playerSize is 0.5f
-			score += 10; // Increase score
-			std::cout << "Score: " << score << std::endl;
-		}
-	}
-}
-
-void Game::renderMaze() 
-{
-	const auto& grid = maze.getMaze();
-	float size = 1.0f;  // Size of each cell
-	float height = 1.0f;  // Height of each wall
-
-	glColor3f(1.0f, 1.0f, 1.0f);  // Set color to white for the walls
-
-	for (std::size_t x = 0; x < grid.size(); ++x) 
+	// Only rebuild the HUD text when the displayed value changes
+	if (points != hudPoints)
 	{
-		for (std::size_t y = 0; y < grid[x].size(); ++y) 
-		{
-			if (grid[x][y] == 1) 
-			{
-				glPushMatrix();
-				glTranslatef(x * size, 0.0f, y * size);
-
-				// Draw each face of the cube
-				glBegin(GL_QUADS);
-
-				// Front face
-				glVertex3f(0.0f, 0.0f, 0.0f);
-				glVertex3f(size, 0.0f, 0.0f);
-				glVertex3f(size, height, 0.0f);
-				glVertex3f(0.0f, height, 0.0f);
-
-				// Back face
-				glVertex3f(0.0f, 0.0f, size);
-				glVertex3f(size, 0.0f, size);
-				glVertex3f(size, height, size);
-				glVertex3f(0.0f, height, size);
-
-				// Left face
-				glVertex3f(0.0f, 0.0f, 0.0f);
-				glVertex3f(0.0f, 0.0f, size);
-				glVertex3f(0.0f, height, size);
-				glVertex3f(0.0f, height, 0.0f);
-
-				// Right face
-				glVertex3f(size, 0.0f, 0.0f);
-				glVertex3f(size, 0.0f, size);
-				glVertex3f(size, height, size);
-				glVertex3f(size, height, 0.0f);
-
-				// Top face
-				glVertex3f(0.0f, height, 0.0f);
-				glVertex3f(size, height, 0.0f);
-				glVertex3f(size, height, size);
-				glVertex3f(0.0f, height, size);
-
-				// Bottom face
-				glVertex3f(0.0f, 0.0f, 0.0f);
-				glVertex3f(size, 0.0f, 0.0f);
-				glVertex3f(size, 0.0f, size);
-				glVertex3f(0.0f, 0.0f, size);
-
-				glEnd();
-				glPopMatrix();
-			}
-		}
+		hudPoints = points;
+		hud.setText("Points: " + std::to_string(points));
 	}
 }
 
-void Game::renderPlayer() {
-	glPushMatrix();
-	glTranslatef(playerPosition.x, playerPosition.y, playerPosition.z);
-	glColor3f(0.0f, 1.0f, 0.0f); // Set player color to green
-	drawCube(0.5f); // Render player as a cube
-	glPopMatrix();
-}
-
 void Game::setupVBO()
 {
 	GLfloat vertices[] = {
@@ -447,17 +431,16 @@ void Game::setupVBO()
 /**
  * @brief Initializes the game.
  *
- * This method initializes various resources and sets up OpenGL for rendering. Method is responsible for setting up various OpenGL
- * resources, including shaders, buffers, textures, and matrices. It initializes GLEW, sets up shaders (vertex and fragment), loads
- * texture data, and sets up projection and camera matrices.
+ * This method initializes various resources and sets up OpenGL for rendering. Startup is described as a task
+ * graph: CPU-only work (asset pack, level, maze, game objects, atlas layout, font atlas, camera, hot reload) runs on
+ * the job system while the main thread, which owns the GL context, creates buffers, compiles shaders and
+ * starts the texture stream. Each task is timed for the time-to-first-frame report.
  */
 void Game::initialise()
 {
 	DEBUG_MSG("\n******** Initialisation Procedure STARTS ********\n");
 
 	isRunning = true;
-	GLint isCompiled = 0;
-	GLint isLinked = 0;
 
 	if (!(!glewInit()))
 	{
@@ -466,43 +449,264 @@ void Game::initialise()
 		throw runtime_error("\nGLEW Init Failed\n");
 	}
 
+	contextTime = startupClock.getElapsedTime().asMicroseconds() / 1000.0;
+
+	const unsigned assetsTask = startup.add("asset pack", AFFINITY::ANY, [this]() { openAssets(); });
+
+	const unsigned levelTask = startup.add("level", AFFINITY::ANY, [this]() { openLevel(); }, { assetsTask });
+
+	const unsigned mazeTask = startup.add("maze", AFFINITY::ANY, [this]()
+		{
+			if (level.isOpen())
+				maze.load(level.getCells(), level.getMazeWidth(), level.getMazeHeight());
+			else
+				maze.generate(mazeWidth, mazeHeight);
+		},
+		{ levelTask });
+
+	const unsigned objectsTask = startup.add("game objects", AFFINITY::ANY, [this]() { initialiseObjects(); }, { levelTask });
+
+	const unsigned crowdTask = startup.add("crowd", AFFINITY::ANY, [this]() { initialiseCrowd(); }, { mazeTask });
+
+	// The camera starts on the player's spawn
+	const unsigned cameraTask = startup.add("camera", AFFINITY::ANY, [this]() { initialiseCamera(); }, { levelTask });
+
+	const unsigned layoutTask = startup.add("atlas layout", AFFINITY::ANY, [this]()
+		{
+			atlas.setLayers(vector<string>(SCENE_TEXTURES, SCENE_TEXTURES + SCENE_TEXTURE_COUNT));
+			wallLayer = atlas.find(wallTexture);
+		});
+
+	// Read (or bake on the first run) the HUD's distance field atlas
+	const unsigned fontTask = startup.add("font atlas", AFFINITY::ANY, [this]()
+		{
+			hud.prepare(hudFont, 24, &assets);
+			hud.setPosition(10.0f, 10.0f);
+		},
+		{ assetsTask });
+
+	const unsigned gpuTask = startup.add("gpu info", AFFINITY::MAIN, [this]() { logGpuInformation(); });
+
+	const unsigned buffersTask = startup.add("buffers", AFFINITY::MAIN, [this]() { initialiseBuffers(); }, { objectsTask });
+
+	const unsigned shadersTask = startup.add("shaders", AFFINITY::MAIN, [this]() { initialiseShaders(); }, { assetsTask });
+
+	const unsigned texturesTask = startup.add("textures", AFFINITY::MAIN, [this]() { initialiseTextures(); },
+		{ assetsTask, layoutTask });
+
+	const unsigned hudTask = startup.add("hud upload", AFFINITY::MAIN, [this]() { hud.upload(); }, { fontTask });
+
+	const unsigned hotReloadTask = startup.add("hot reload", AFFINITY::ANY, [this]() { initialiseHotReload(); }, { assetsTask });
+
+	startup.add("render state", AFFINITY::MAIN, [this]() { initialiseRenderState(); },
+		{ mazeTask, crowdTask, cameraTask, gpuTask, buffersTask, shadersTask, texturesTask, hudTask, hotReloadTask });
+
+	startup.run(jobs);
+
+	initialiseTime = startupClock.getElapsedTime().asMicroseconds() / 1000.0;
+
+	DEBUG_MSG("\n******** Initialisation Procedure ENDS ********\n");
+}
+
+/**
+ * @brief Maps the asset pack, next to the executable or in the working directory.
+ */
+void Game::openAssets()
+{
+	if (assets.open(AssetPack::getExecutableDirectory() + assetPackFile) || assets.open(assetPackFile))
+	{
+		DEBUG_MSG("Asset pack mapped");
+	}
+	else
+	{
+		DEBUG_MSG("Asset pack not found, loading loose files");
+	}
+}
+
+/**
+ * @brief Registers the reloadable assets and starts watching the asset directory.
+ *
+ * Textures rebuild the scene atlas on the streamer's decode threads, the font is baked into a spare atlas
+ * and the shaders are read on the reload thread; each is swapped in by the render thread between frames.
+ * Packed assets are not watched, edits to the loose files would not be seen.
+ */
+void Game::initialiseHotReload()
+{
+	if (assets.isOpen())
+	{
+		DEBUG_MSG("Hot reload off, assets are packed");
+		return;
+	}
+
+	for (unsigned i = 0; i < SCENE_TEXTURE_COUNT; i++)
+	{
+		hotReload.add(SCENE_TEXTURES[i], HotReload::DecodeFunction(), [this]() { streamer.reload(atlasTexture); });
+	}
+
+	hotReload.add(hudFont, [this]() { return hud.prepareReload(hudFont, &assets); }, [this]() { hud.applyReload(); });
+
+	hotReload.add(sceneVertexShader, [this]() { return readTextAsset(sceneVertexShader, assets, reloadedVertexSource); },
+		[this]()
+		{
+			if (buildShaders(reloadedVertexSource, fragmentSource))
+				vertexSource = reloadedVertexSource;
+		});
+
+	hotReload.add(sceneFragmentShader, [this]() { return readTextAsset(sceneFragmentShader, assets, reloadedFragmentSource); },
+		[this]()
+		{
+			if (buildShaders(vertexSource, reloadedFragmentSource))
+				fragmentSource = reloadedFragmentSource;
+		});
+
+	if (hotReload.start(vector<string>(1, assetDirectory)))
+	{
+		DEBUG_MSG("Watching " + assetDirectory + " for changes");
+	}
+	else
+	{
+		DEBUG_MSG("Hot reload not available");
+	}
+}
+
+/**
+ * @brief Maps the level and moves the player to its spawn.
+ */
+void Game::openLevel()
+{
+	if (!level.open(levelFile, &assets))
+	{
+		DEBUG_MSG("Level not found, generating the maze");
+		return;
+	}
+
+	mazeWidth = (int)level.getMazeWidth();
+	mazeHeight = (int)level.getMazeHeight();
+
+	const LevelSpawn* spawn = level.findSpawn("player");
+	if (spawn != NULL)
+		playerPosition = glm::vec3(spawn->position[0], spawn->position[1], spawn->position[2]);
+
+	DEBUG_MSG("Level mapped: " + toString(level.getCollectibleCount()) + " collectibles");
+}
+
+/**
+ * @brief Creates the game objects and collectibles, CPU only.
+ */
+void Game::initialiseObjects()
+{
 	DEBUG_MSG("\n******** Init GameObjects STARTS ********\n");
 
-	game_objects.push_back(new GameObject(gpp::TYPE::PLAYER));
-	game_objects[0]->setPosition(glm::vec3(0.0001f, 0.0f, 0.0f));
+	player = entities.create(gpp::TYPE::PLAYER, playerPosition, 0.5f * playerSize);
+	entities.setScale(player, playerSize); // Of the unit cube it is drawn with
+
+	// The simulation collects from its own copy, the drawn copy replays its removals (see update())
+	CollectibleStore& simulated = simulation.getCollectibles();
+	auto add = [&](const glm::vec3& position, float size, uint32_t type)
+	{
+		collectibles.add(position, size, type);
+		simulated.add(position, size, type);
+	};
 
-	pointCubes.push_back(PointCube(glm::vec3(1.0f, 0.0f, -5.0f), 0.5f));
-	pointCubes.push_back(PointCube(glm::vec3(-2.0f, 1.0f, -3.0f), 0.5f));
-	pointCubes.push_back(PointCube(glm::vec3(0.0f, -1.0f, -7.0f), 0.5f));
-	pointCubes.push_back(PointCube(glm::vec3(2.0f, 2.0f, -4.0f), 0.5f));
+	if (level.isOpen())
+	{
+		const LevelCollectible* levelCollectibles = level.getCollectibles();
+		const LevelObjectType* types = level.getObjectTypes();
+		collectibles.reserve(level.getCollectibleCount());
+		simulated.reserve(level.getCollectibleCount());
+		for (size_t i = 0; i < level.getCollectibleCount(); i++)
+		{
+			const LevelCollectible& collectible = levelCollectibles[i];
+			add(glm::vec3(collectible.position[0], collectible.position[1], collectible.position[2]),
+				types[collectible.type].size, collectible.type);
+		}
+	}
+	else
+	{
+		add(glm::vec3(1.0f, 0.0f, -5.0f), 0.5f, 0);
+		add(glm::vec3(-2.0f, 1.0f, -3.0f), 0.5f, 0);
+		add(glm::vec3(0.0f, -1.0f, -7.0f), 0.5f, 0);
+		add(glm::vec3(2.0f, 2.0f, -4.0f), 0.5f, 0);
+	}
+
+	collectibles.build();
+	simulated.build();
+
+	DEBUG_MSG("\n******** Init GameObjects ENDS ********\n");
+}
+
+/**
+ * @brief Scatters the NPCs and bosses over the open cells of the maze, CPU only.
+ */
+void Game::initialiseCrowd()
+{
+	Crowd& crowd = simulation.getCrowd();
+	crowd.clear();
+
+	// Fill the open cells to half their capacity at most, so agents spawn apart and have room to move
+	const std::vector<std::vector<int>>& grid = maze.getMaze();
+	size_t openCells = 0;
+	for (size_t x = 0; x < grid.size(); x++)
+		for (size_t z = 0; z < grid[x].size(); z++)
+			if (grid[x][z] == 0)
+				openCells++;
+	const size_t agents = std::min(CROWD_AGENTS, openCells * crowd.getCellCapacity() / 2);
+
+	std::vector<glm::vec3> spawns;
+	CollectibleStore::scatter(grid, agents, 0.2f, 7, spawns);
+
+	crowd.reserve(spawns.size());
+	agentTypes.resize(spawns.size());
+	for (size_t i = 0; i < spawns.size(); i++)
+	{
+		agentTypes[i] = i % BOSS_INTERVAL == 0 ? gpp::TYPE::BOSS : gpp::TYPE::NPC;
+		crowd.add(spawns[i], agentTypes[i], agentTypes[i] == gpp::TYPE::BOSS ? BOSS_SPEED : NPC_SPEED);
+	}
+
+	DEBUG_MSG("Crowd: " + toString(crowd.size()) + " agents");
+}
+
+/**
+ * @brief Sets up the camera, projection and view matrices, CPU only.
+ */
+void Game::initialiseCamera()
+{
+	DEBUG_MSG("\n******** MVP STARTS ********\n");
 
-	//camera
 	cameraPosition = glm::vec3(0.0f, 5.0f, 10.0f); // Initial camera position
 	cameraTarget = playerPosition; // Initial target is the player's position
 	cameraUp = glm::vec3(0.0f, 1.0f, 0.0f); // Up vector is along the Y-axis
 
 	projectionMatrix = glm::perspective(glm::radians(45.0f), (float)window.getSize().x / (float)window.getSize().y, 0.1f, 100.0f);
+	camera.setPerspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
+	camera.setViewport(window.getSize().x, window.getSize().y);
+
+	// Set up Projection Matrix
+	projection = perspective(
+		45.0f,		 // Field of View 45 degrees
+		4.0f / 3.0f, // Aspect ratio: 4:3
+		5.0f,		 // Display Range Min : 0.1f unit
+		100.0f		 // Display Range Max : 100.0f unit
+	);
 
-	DEBUG_MSG("\n******** Init GameObjects ENDS ********\n");
-
-	// Copy UV coordinates to all faces (initially only one face is defined in Cube.h)
-	// This loop iterates over each face (except the first one) and copies the UV coordinates
-	// from the first face to the UV array for that face.
-	for (int i = 1; i < 6; i++)
-	{
-		// Calculate the starting position of UV coordinates for the current face in the UV array
-		int uv_start_position = i * 4 * 2; // Each face has 4 vertices, each vertex has 2 UV coordinates
+	// Set up Camera Matrix
+	view = lookAt(
+		vec3(0.0f, 4.0f, 10.0f), // Camera (x,y,z), in World Space
+		vec3(0.0f, 0.0f, 0.0f),	 // Camera looking at origin
+		vec3(0.0f, 1.0f, 0.0f)	 // 0.0f, 1.0f, 0.0f Look Down and 0.0f, -1.0f, 0.0f Look Up
+	);
 
-		// Copy UV coordinates from the first face to the current face
-		memcpy(&uvs[uv_start_position], &uvs[0], 2 * 4 * sizeof(GLfloat)); // Each vertex has 2 UV coordinates,
-		// and there are 4 vertices per face
-	}
+	lastX = window.getSize().x / 2.0f;
+	lastY = window.getSize().y / 2.0f;
 
-	// 	for (int i = 1; i < 6; i++) {
-	//		memcpy(&uvs[i * 4 * 2], &uvs[0], 2 * 4 * sizeof(GLfloat));
-	//	}
+	DEBUG_MSG("\n******** MVP ENDS ********\n");
+}
 
-	// Output GPU information to the debug console
+/**
+ * @brief Outputs GPU information to the debug console.
+ */
+void Game::logGpuInformation()
+{
 	DEBUG_MSG("\n******** GPU information STARTS ********\n");
 	// Retrieve and output GPU vendor information
 	DEBUG_MSG(glGetString(GL_VENDOR));
@@ -513,292 +717,289 @@ void Game::initialise()
 	// Retrieve and output GPU shading language version information
 	DEBUG_MSG(glGetString(GL_SHADING_LANGUAGE_VERSION));
 	DEBUG_MSG("\n******** GPU information ENDS ********\n");
+}
 
-	// Vertex Buffer Object
-	glGenBuffers(1, &vbo); // Generate Vertex Buffer
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
+/**
+ * @brief Creates the shared meshes of the game objects.
+ *
+ * Every object of a kind references one mesh, so its buffers exist once however many objects use it.
+ */
+void Game::initialiseBuffers()
+{
 	DEBUG_MSG("\n******** Model information STARTS ********\n");
-	// Vertices (3) x,y,z , Colors (4) RGBA, UV/ST (2)
-	for (auto& gameObject : game_objects) {
-		if (gameObject != nullptr) {
-			int countVERTICES = gameObject->getVertexCount();
-			int countCOLORS = gameObject->getColorCount();
-			int countUVS = gameObject->getUVCount();
-			DEBUG_MSG("\n******** Model information ENDS ********\n");
-
-			// Vertices (3) x,y,z , Colours (4) RGBA, UV/ST (2)
-			glBufferData(GL_ARRAY_BUFFER, ((3 * VERTICES) + (4 * COLOURS) + (2 * UVS)) * sizeof(GLfloat), NULL, GL_STATIC_DRAW);
-
-			glGenBuffers(1, &vib); // Generate Vertex Index Buffer
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vib);
-
-			// Count of Indices
-			for (auto& gameObject : game_objects) {
-				if (gameObject != nullptr) {
-					int countINDICES = gameObject->getIndexCount();
-
-					DEBUG_MSG("\nVertices : " + to_string(countVERTICES));
-					DEBUG_MSG("Colors : " + to_string(countCOLORS));
-					DEBUG_MSG("UVs : " + to_string(countUVS));
-					DEBUG_MSG("Indexes : " + to_string(countINDICES));
-
-					// Indices to be drawn
-					glBufferData(GL_ELEMENT_ARRAY_BUFFER, 3 * INDICES * sizeof(GLuint), indices, GL_STATIC_DRAW);
-
-					// NOTE: uniforms values must be used within Shader so that they
-					// can be retreived
-					// Define and compile Vertex Shader
-					const char* vs_src =
-						"#version 130\n\n"
-						"\n"
-						"in vec3 sv_position;\n"
-						"in vec4 sv_colour;\n"
-						"in vec2 sv_uv;\n\n"
-						"\n"
-						"out vec4 colour;\n"
-						"out vec2 uv;\n\n"
-						"\n"
-						"uniform mat4 sv_mvp;\n"
-						"\n"
-						"void main() {\n"
-						"	colour = sv_colour;\n"
-						"	uv = sv_uv;\n"
-						//"	gl_Position = vec4(sv_position, 1);\n"
-						"	gl_Position = sv_mvp * vec4(sv_position, 1 );\n"
-						"}\n"; // Vertex Shader Src
-
-					DEBUG_MSG("\n******** Vertex Shader src STARTS ********\n");
-					DEBUG_MSG(string(vs_src));
-					DEBUG_MSG("\n******** Vertex Shader src ENDS ********\n");
-
-					DEBUG_MSG("Setting Up Vertex Shader");
-
-					// Compile Vertex Shader
-					vsid = glCreateShader(GL_VERTEX_SHADER);
-					glShaderSource(vsid, 1, (const GLchar**)&vs_src, NULL);
-					glCompileShader(vsid);
-
-					// Check if Vertex Shader is Compiled
-					glGetShaderiv(vsid, GL_COMPILE_STATUS, &isCompiled);
-
-					if (isCompiled == GL_TRUE)
-					{
-						DEBUG_MSG("Vertex Shader Compiled");
-						isCompiled = GL_FALSE;
-					}
-					else
-					{
-						GLint logLength = 0;
-						glGetShaderiv(vsid, GL_INFO_LOG_LENGTH, &logLength);
-						char* errorLog = new char[logLength];
-						glGetShaderInfoLog(vsid, logLength, &logLength, &errorLog[0]);
-						DEBUG_MSG("\n******** Vertex Shader ErrorLog STARTS ********\n");
-						DEBUG_MSG(string(errorLog));
-						DEBUG_MSG("\n******** Vertex Shader ErrorLog ENDS ********\n");
-						throw runtime_error("\nERROR: Vertex Shader Compilation Error\n");
-					}
-				}
-			}
 
-			// Define and compile Fragment Shader
-			const char* fs_src =
-				"#version 130\n\n"
-				"\n"
-				"uniform sampler2D f_texture;\n"
-				"\n"
-				"in vec4 colour;\n"
-				"in vec2 uv;\n"
-				"\n"
-				"out vec4 fColor;\n"
-				"\n"
-				"void main() {\n"
-				"	vec4 lightColor = vec4(1.0f, 0.0f, 1.0f, 1.0f);\n"
-				"	fColor = lightColor * (colour + texture2D(f_texture, uv));\n"
-				"\n"
-				"}\n"; // Fragment Shader Src
-
-			DEBUG_MSG("\n******** Fragment Shader src STARTS ********\n");
-			DEBUG_MSG(string(fs_src));
-			DEBUG_MSG("\n******** Fragment Shader src ENDS ********\n");
-
-			DEBUG_MSG("Setting Up Fragment Shader");
-
-			// Compile Fragment Shader
-			fsid = glCreateShader(GL_FRAGMENT_SHADER);
-			glShaderSource(fsid, 1, (const GLchar**)&fs_src, NULL);
-			glCompileShader(fsid);
-
-			// Check is Shader Compiled
-			glGetShaderiv(fsid, GL_COMPILE_STATUS, &isCompiled);
-
-			if (isCompiled == GL_TRUE)
-			{
-				DEBUG_MSG("Fragment Shader Compiled");
-				isCompiled = GL_FALSE;
-			}
-			else
-			{
-				GLint logLength = 0;
-				glGetShaderiv(fsid, GL_INFO_LOG_LENGTH, &logLength);
-				char* errorLog = new char[logLength];
-				glGetShaderInfoLog(fsid, logLength, &logLength, &errorLog[0]);
-				DEBUG_MSG("\n******** Vertex Shader ErrorLog STARTS ********\n");
-				DEBUG_MSG(string(errorLog));
-				DEBUG_MSG("\n******** Vertex Shader ErrorLog ENDS ********\n");
-				throw runtime_error("\nERROR: Fragment Shader Compilation Error\n");
-			}
+	std::vector<MeshVertex> cubeVertices;
+	std::vector<uint32_t> cubeIndices;
+	buildCubeMesh(cubeVertices, cubeIndices);
 
-			// Create and link shader program
-			DEBUG_MSG("\n******** Shader Linking STARTS ********\n");
-			DEBUG_MSG("Setting Up and Linking Shader");
-			progID = glCreateProgram();
-			glAttachShader(progID, vsid);
-			glAttachShader(progID, fsid);
-			glLinkProgram(progID);
+	const uint32_t attributes = (uint32_t)MESH_ATTRIBUTE::POSITION | (uint32_t)MESH_ATTRIBUTE::NORMAL |
+								(uint32_t)MESH_ATTRIBUTE::UV | (uint32_t)MESH_ATTRIBUTE::COLOUR;
+	cubeMesh = meshes.create("cube", cubeVertices, cubeIndices, attributes);
+	if (!cubeMesh)
+	{
+		throw runtime_error("\nERROR: Cube mesh not created\n");
+	}
 
-			// Check if Shader Program is linked
-			glGetProgramiv(progID, GL_LINK_STATUS, &isLinked);
+	entities.setMesh(player, cubeMesh);
 
-			if (isLinked == 1)
-			{
-				DEBUG_MSG("Vertex and Fragment Shader Linked");
-			}
-			else
-			{
-				throw runtime_error("\nERROR: Vertex and Fragment Shader Link Error\n");
-			}
-			DEBUG_MSG("\n******** Shader Linking ENDS ********\n");
-			// Use Shader Program on GPU
-			glUseProgram(progID);
+	DEBUG_MSG("\nVertices : " + to_string(cubeMesh->getVertexCount()));
+	DEBUG_MSG("Indexes : " + to_string(cubeMesh->getIndexCount()));
+	DEBUG_MSG("Meshes : " + to_string(meshes.getMeshCount()));
+	DEBUG_MSG("Mesh users : " + to_string(cubeMesh.use_count() - 1));
+	DEBUG_MSG("\n******** Model information ENDS ********\n");
+}
 
-			// Set image data
-			// https://github.com/nothings/stb/blob/master/stb_image.h
-			// Load texture image data
-			img_data = stbi_load(filename.c_str(), &width, &height, &comp_count, colour_components);
+/**
+ * @brief Converts the cube in Cube.h to mesh vertices, one per face corner.
+ *
+ * @param meshVertices Receives the vertices.
+ * @param meshIndices Receives the triangle list.
+ */
+void Game::buildCubeMesh(std::vector<MeshVertex>& meshVertices, std::vector<uint32_t>& meshIndices)
+{
+	meshVertices.resize(ARRAY_SIZE(vertices) / 3);
+	for (size_t i = 0; i < meshVertices.size(); i++)
+	{
+		MeshVertex& vertex = meshVertices[i];
+		const size_t face = i / 4;
+		const size_t corner = i % 4;
+		vertex.position = glm::vec3(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]);
+		vertex.normal = glm::vec3(normals[face * 6], normals[face * 6 + 1], normals[face * 6 + 2]);
+		vertex.uv = glm::vec2(uvs[corner * 2], uvs[corner * 2 + 1]); // Every face is mapped like the front
+		vertex.colour = glm::vec4(colours[i * 4], colours[i * 4 + 1], colours[i * 4 + 2], colours[i * 4 + 3]);
+	}
 
-			if (img_data == NULL)
-			{
-				throw runtime_error("\nERROR: Texture not loaded " + filename + "\n");
-			}
+	meshIndices.assign(indices, indices + ARRAY_SIZE(indices));
+}
 
-			// Enable 2D texturing
-			DEBUG_MSG("\n******** Enabling Textures STARTS ********\n");
-			glEnable(GL_TEXTURE_2D);
-			glGenTextures(1, &to[0]);
-			glBindTexture(GL_TEXTURE_2D, to[0]);
-
-			// Texture wrapping
-			// https://www.khronos.org/opengles/sdk/docs/man/xhtml/glTexParameter.xml
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-
-			// Texture filtering
-			// https://www.khronos.org/opengles/sdk/docs/man/xhtml/glTexParameter.xml
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-			// Transfer texture image data to GPU
-			// https://www.khronos.org/opengles/sdk/docs/man/xhtml/glTexImage2D.xml
-			glTexImage2D(
-				GL_TEXTURE_2D,	  // 2D Texture Image
-				0,				  // Mipmapping Level
-				GL_RGBA,		  // GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA, GL_RGB, GL_BGR, GL_RGBA
-				width,			  // Width
-				height,			  // Height
-				0,				  // Border
-				GL_RGBA,		  // Bitmap
-				GL_UNSIGNED_BYTE, // Specifies Data type of image data
-				img_data		  // Image Data
-			);
-
-			DEBUG_MSG("\n******** Enabling Textures ENDS ********\n");
-
-			// Set up Projection Matrix
-			DEBUG_MSG("\n******** MVP STARTS ********\n");
-			projection = perspective(
-				45.0f,		 // Field of View 45 degrees
-				4.0f / 3.0f, // Aspect ratio: 4:3
-				5.0f,		 // Display Range Min : 0.1f unit
-				100.0f		 // Display Range Max : 100.0f unit
-			);
-
-			// Set up Camera Matrix
-			view = lookAt(
-				vec3(0.0f, 4.0f, 10.0f), // Camera (x,y,z), in World Space
-				vec3(0.0f, 0.0f, 0.0f),	 // Camera looking at origin
-				vec3(0.0f, 1.0f, 0.0f)	 // 0.0f, 1.0f, 0.0f Look Down and 0.0f, -1.0f, 0.0f Look Up
-			);
-
-			lastX = window.getSize().x / 2.0f;
-			lastY = window.getSize().y / 2.0f;
-
-			DEBUG_MSG("\n******** MVP ENDS ********\n");
-
-			// Enable Depth Test for accurate rendering
-			DEBUG_MSG("\n******** CULLING ENABLE STARTS ********\n");
-			glEnable(GL_DEPTH_TEST);
-			glDepthFunc(GL_LESS);
-			glEnable(GL_CULL_FACE);
-			DEBUG_MSG("\n******** CULLING ENABLE ENDS ********\n");
-
-			DEBUG_MSG("\n******** OpenGL Error Check STARTS ********\n");
-			GLenum error = glGetError();
-			if (error != GL_NO_ERROR)
-			{
-				throw runtime_error("ERROR: OpenGL Error : " + to_string(error));
-			}
-			DEBUG_MSG("\n******** OpenGL Error Check ENDS ********\n");
+/**
+ * @brief Reads the scene shaders and builds them, see buildShaders().
+ */
+void Game::initialiseShaders()
+{
+	if (!readTextAsset(sceneVertexShader, assets, vertexSource) || !readTextAsset(sceneFragmentShader, assets, fragmentSource))
+	{
+		throw runtime_error("\nERROR: Scene shader sources not found\n");
+	}
 
-			// Load Font
-			font.loadFromFile("./assets/fonts/BBrick.ttf");
+	if (!buildShaders(vertexSource, fragmentSource))
+	{
+		throw runtime_error("\nERROR: Scene shaders not built\n");
+	}
+}
 
-			DEBUG_MSG("\n******** Initialisation Procedure ENDS ********\n");
-		}
+/**
+ * @brief Compiles one scene shader stage.
+ *
+ * @return The shader, 0 if it did not compile (the error log is printed).
+ */
+static GLuint compileSceneShader(GLenum stage, const string& source, const string& name)
+{
+	DEBUG_MSG("\n******** " + name + " src STARTS ********\n");
+	DEBUG_MSG(source);
+	DEBUG_MSG("\n******** " + name + " src ENDS ********\n");
+
+	DEBUG_MSG("Setting Up " + name);
+
+	const GLchar* src = source.c_str();
+	GLuint shader = glCreateShader(stage);
+	glShaderSource(shader, 1, &src, NULL);
+	glCompileShader(shader);
+
+	// Check if Shader is Compiled
+	GLint isCompiled = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+
+	if (isCompiled == GL_TRUE)
+	{
+		DEBUG_MSG(name + " Compiled");
+		return shader;
 	}
+
+	GLint logLength = 0;
+	glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+	string errorLog(logLength > 0 ? logLength : 1, '\0');
+	glGetShaderInfoLog(shader, logLength, &logLength, &errorLog[0]);
+	DEBUG_MSG("\n******** " + name + " ErrorLog STARTS ********\n");
+	DEBUG_MSG(errorLog);
+	DEBUG_MSG("\n******** " + name + " ErrorLog ENDS ********\n");
+	glDeleteShader(shader);
+	return 0;
 }
+
 /**
- * @brief Updates the game state.
+ * @brief Compiles and links the scene shaders, replacing the current program only if both stages build.
+ *
+ * Used at startup and by hot reload, where a broken edit keeps the previous program running. The attribute
+ * and uniform locations are looked up for the new program, packets recorded from the next frame use it.
+ *
+ * @param vertexShaderSource Vertex shader source.
+ * @param fragmentShaderSource Fragment shader source.
+ * @return true if the new program is in use.
  */
-void Game::update() {
-#if (DEBUG >= 2)
-	DEBUG_MSG("Updating... MVP");
-#endif
-	// Update the Model View Projection matrix by combining the projection, view, and model matrices
+bool Game::buildShaders(const string& vertexShaderSource, const string& fragmentShaderSource)
+{
+	GLuint vertexShader = compileSceneShader(GL_VERTEX_SHADER, vertexShaderSource, "Vertex Shader");
+	GLuint fragmentShader = compileSceneShader(GL_FRAGMENT_SHADER, fragmentShaderSource, "Fragment Shader");
 
-	for (auto& gameObject : game_objects) 
+	if (vertexShader == 0 || fragmentShader == 0)
 	{
-		if (gameObject != nullptr) 
-		{  // Check if the pointer is valid
-		    // Set the MVP matrix for the current GameObject
-			gameObject->setMVPMatrix(projection * view * gameObject->getModelMatrix());
-		}
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return false;
 	}
 
-#if (DEBUG >= 2)
-	DEBUG_MSG("MVP : " + game_objects->enumToString());
-	DEBUG_MSG(glm::to_string(game_objects->getModelMatrix()));
-#endif
+	// Create and link shader program
+	DEBUG_MSG("\n******** Shader Linking STARTS ********\n");
+	DEBUG_MSG("Setting Up and Linking Shader");
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
 
+	// Check if Shader Program is linked
+	GLint isLinked = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
 
-#if (DEBUG >= 2)
-	DEBUG_MSG("MVP : " + glm::to_string(mvp));
-#endif
+	if (isLinked != GL_TRUE)
+	{
+		DEBUG_MSG("ERROR: Vertex and Fragment Shader Link Error");
+		glDeleteProgram(program);
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return false;
+	}
+	DEBUG_MSG("Vertex and Fragment Shader Linked");
+	DEBUG_MSG("\n******** Shader Linking ENDS ********\n");
 
-#if (DEBUG >= 2)
-	DEBUG_MSG("Finished Updating... MVP");
-#endif
+	// Find variables within the shader, a program without a position or MVP matrix draws nothing
+	// https://www.khronos.org/opengles/sdk/docs/man/xhtml/glGetAttribLocation.xml
+	const GLint programPositionID = glGetAttribLocation(program, "sv_position");
+	const GLint programMvpID = glGetUniformLocation(program, "sv_mvp");
+	if (programPositionID < 0 || programMvpID < 0)
+	{
+		DEBUG_MSG("ERROR: sv_position or sv_mvp not found");
+		glDeleteProgram(program);
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return false;
+	}
+
+	// Release the program being replaced
+	if (progID != 0)
+	{
+		glDetachShader(progID, vsid);
+		glDetachShader(progID, fsid);
+		glDeleteShader(vsid);
+		glDeleteShader(fsid);
+		glDeleteProgram(progID);
+	}
+
+	vsid = vertexShader;
+	fsid = fragmentShader;
+	progID = program;
+
+	// Optional inputs are -1 when the shader does not use them, they are then skipped when drawing
+	positionID = programPositionID;
+	mvpID = programMvpID;
+	colorID = glGetAttribLocation(progID, "sv_colour");
+	uvID = glGetAttribLocation(progID, "sv_uv");
+	textureID = glGetUniformLocation(progID, "f_texture");
+	uvRectID = glGetUniformLocation(progID, "sv_uvRect");
+	texturedID = glGetUniformLocation(progID, "f_textured");
+
+	// Use Shader Program on GPU, the sampler reads texture unit 0
+	glUseProgram(progID);
+	if (textureID >= 0)
+		glUniform1i(textureID, 0);
+	glUseProgram(0);
+	return true;
+}
+
+/**
+ * @brief Starts streaming the scene atlas.
+ *
+ * Every scene texture is packed into one atlas with its mipmap chain (read from the cache when none of the
+ * images changed). The build runs on a decode thread and the placeholder is drawn until the atlas has
+ * streamed in, the layout is known up front so layers can be recorded already.
+ */
+void Game::initialiseTextures()
+{
+	DEBUG_MSG("\n******** Enabling Textures STARTS ********\n");
+	glEnable(GL_TEXTURE_2D);
+	streamer.initialise();
+
+	const TextureAtlas* sceneAtlas = &atlas;
+	const AssetPack* sceneAssets = &assets;
+	atlasTexture = streamer.request(
+		[sceneAtlas, sceneAssets](MipChain& mips) { return sceneAtlas->build(ATLAS_CACHE, sceneAssets, mips); },
+		GL_CLAMP_TO_EDGE);
+
+	DEBUG_MSG("\n******** Enabling Textures ENDS ********\n");
+}
+
+/**
+ * @brief Enables depth testing and culling, then checks for errors raised during startup.
+ */
+void Game::initialiseRenderState()
+{
+	// Enable Depth Test for accurate rendering
+	DEBUG_MSG("\n******** CULLING ENABLE STARTS ********\n");
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glEnable(GL_CULL_FACE);
+	DEBUG_MSG("\n******** CULLING ENABLE ENDS ********\n");
+
+	DEBUG_MSG("\n******** OpenGL Error Check STARTS ********\n");
+	GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+	{
+		throw runtime_error("ERROR: OpenGL Error : " + to_string(error));
+	}
+	DEBUG_MSG("\n******** OpenGL Error Check ENDS ********\n");
+}
+
+/**
+ * @brief Outputs the time-to-first-frame report, broken down by startup phase.
+ *
+ * Task times are relative to the start of the startup graph. The sum of the task times against the
+ * graph's duration shows how much of startup overlapped.
+ */
+void Game::reportStartup()
+{
+	const double firstFrameTime = startupClock.getElapsedTime().asMicroseconds() / 1000.0;
+
+	double taskTime = 0.0;
+	for (unsigned i = 0; i < startup.getTaskCount(); i++)
+		taskTime += startup.getTiming(i).end - startup.getTiming(i).start;
+
+	ostringstream report;
+	report << fixed << setprecision(2)
+		   << "\n******** Time to first frame " << firstFrameTime << " ms ********\n"
+		   << "  window and context   " << contextTime << " ms\n"
+		   << "  startup graph        " << startup.getElapsed() << " ms (" << taskTime << " ms of tasks on "
+		   << jobs.getWorkerCount() << " threads)\n"
+		   << startup.getReport()
+		   << "  first frame          " << firstFrameTime - initialiseTime << " ms";
+	DEBUG_MSG(report.str());
 }
 
 /**
  * @brief Runs the game loop.
  *
- * Method contains the main game loop where events are handled, the game state is updated (Game::update()), and
- * the scene is rendered (Game::render()). The loop runs until the isRunning flag is false.
+ * Method contains the main game loop where events are handled, the game state is updated (Game::update(float)), and
+ * the scene is rendered (Game::render()). The loop runs until the window is closed.
  */
 void Game::run() {
 	sf::Clock clock;
 
+	initialise();
+
+	// Gameplay runs at its own fixed rate from here on, frames only draw it
+	simulation.start(maze.getMaze(), playerPosition, playerSpeed, playerSize, &jobs);
+
+	bool firstFrame = true;
+
 	while (window.isOpen()) {
 		float deltaTime = clock.restart().asSeconds();
 
@@ -808,185 +1009,329 @@ void Game::run() {
 			if (event.type == sf::Event::Closed) {
 				window.close();
 			}
+			else if (event.type == sf::Event::Resized) {
+				glViewport(0, 0, event.size.width, event.size.height);
+				camera.setViewport(event.size.width, event.size.height);
+			}
 		}
 
-		update(deltaTime);
-
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		if (!window.isOpen()) {
+			break;
+		}
 
-		glLoadIdentity();
-		gluLookAt(
-			playerPosition.x, playerPosition.y + 2.0f, playerPosition.z + 5.0f, // Camera position
-			playerPosition.x, playerPosition.y, playerPosition.z, // Look at player
-			0.0f, 1.0f, 0.0f  // Up vector
-		);
+		// Swap in assets reloaded since the last frame
+		hotReload.update();
 
-		renderMaze();
-		renderPlayer();
+		update(deltaTime);
+		render();
 
-		window.display();
+		if (firstFrame) {
+			firstFrame = false;
+			reportStartup();
+		}
 	}
+
+	simulation.stop();
 }
 
 /**
- * @brief Renders the game scene.
- * method clears the color and depth buffers, draws the HUD (heads-up display), binds buffers, sets shader uniforms,
- * enables vertex arrays, and draws the cube using indexed drawing.
+ * @brief Records the packets for every visible object in the scene.
+ *
+ * Maze chunks, collectibles and crowd agents are culled and recorded on the worker threads into per-worker
+ * command buffers. The player and HUD are recorded by the render thread, then all buffers are
+ * merged into the render queue.
+ *
+ * @param view Camera view matrix used to compute packet depth.
+ * @param projection Camera projection matrix used for culling.
  */
-void Game::render()
+void Game::buildRenderQueue(const glm::mat4& view, const glm::mat4& projection)
 {
+	const float zNear = 0.1f;
+	const float zFar = 100.0f;
+	const int CHUNK = 16; // Maze cells per chunk side
+
+	const glm::mat4 viewProjection = projection * view;
+	const Frustum frustum(viewProjection);
+	const GLuint sceneProgram = progID;
+	const glm::mat4 unitCube = glm::scale(glm::mat4(1.0f), glm::vec3(0.5f)) * cubeMesh->getDequantizeMatrix(); // Side 1
+
+	// The unit cube only scales and offsets the mesh, so a cube of side s at p is placed(p + s * offset, s * scale)
+	const glm::vec3 cubeScale(unitCube[0][0], unitCube[1][1], unitCube[2][2]);
+	const glm::vec3 cubeOffset(unitCube[3].x, unitCube[3].y, unitCube[3].z);
+	const auto& grid = maze.getMaze();
+	const int gridWidth = (int)grid.size();
+	const int gridDepth = gridWidth > 0 ? (int)grid[0].size() : 0;
+	const int chunksX = (gridWidth + CHUNK - 1) / CHUNK;
+	const int chunksZ = (gridDepth + CHUNK - 1) / CHUNK;
+	const GLuint atlasTexture = streamer.getTexture(this->atlasTexture);
+	const int wallLayer = this->wallLayer;
+
+	renderQueue.clear();
+	renderQueue.setBufferCount(jobs.getWorkerCount());
+
+	// Maze walls, one chunk per work item
+	const JobSystem::RangeFunction recordWalls = [&](size_t begin, size_t end, unsigned worker)
+		{
+			std::vector<DrawPacket>& buffer = renderQueue.getBuffer(worker).packets;
+			const size_t firstPacket = buffer.size();
 
-#if (DEBUG >= 2)
-	DEBUG_MSG("Render Loop...");
-#endif
-
-	// Clear the screen
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-	// Bind the VAO (it encapsulates the VBO and attribute settings)
-	glBindVertexArray(VAO);
-
-	// Draw the object
-	glDrawArrays(GL_TRIANGLES, 0, 6);  // Change this depending on your vertex layout
-
-	// Unbind the VAO
-	glBindVertexArray(0);
+			DrawPacket packet;
+			packet.program = sceneProgram;
+			packet.texture = atlasTexture;
+			packet.layer = (uint16_t)wallLayer;
+			packet.mesh = MESH::WALL;
+			packet.colour = glm::vec3(1.0f);
 
-	// Save current OpenGL render states
-	// https://www.sfml-dev.org/documentation/2.0/classsf_1_1RenderTarget.php#a8d1998464ccc54e789aaf990242b47f7
-	window.pushGLStates();
+			for (size_t chunk = begin; chunk < end; chunk++)
+			{
+				int x0 = (int)(chunk % chunksX) * CHUNK;
+				int z0 = (int)(chunk / chunksX) * CHUNK;
+				int x1 = x0 + CHUNK < gridWidth ? x0 + CHUNK : gridWidth;
+				int z1 = z0 + CHUNK < gridDepth ? z0 + CHUNK : gridDepth;
 
-	// Find mouse position using sf::Mouse
-	int x = Mouse::getPosition(window).x;
-	int y = Mouse::getPosition(window).y;
+				if (!frustum.intersects(glm::vec3((float)x0, 0.0f, (float)z0), glm::vec3((float)x1, 1.0f, (float)z1)))
+					continue;
 
-	// Display points
-	sf::Font font;
-	if (!font.loadFromFile("BBrick.ttf")) {
-		// handle error
-	}
+				for (int x = x0; x < x1; ++x)
+				{
+					for (int y = z0; y < z1; ++y)
+					{
+						if (grid[x][y] == 1)
+						{
+							glm::vec3 centre((float)x + 0.5f, 0.5f, (float)y + 0.5f);
+							packet.mvp = placed(centre + cubeOffset, cubeScale);
+							float distance = -(view * glm::vec4(centre, 1.0f)).z;
+							packet.key = RenderQueue::makeKey(PASS::GEOMETRY, packet.program, packet.texture, packet.mesh,
+								RenderQueue::quantizeDepth(PASS::GEOMETRY, distance, zNear, zFar));
+							buffer.push_back(packet);
+						}
+					}
+				}
+			}
 
-	sf::Text text;
-	text.setFont(font);
-	text.setString("Points: " + std::to_string(points));
-	text.setCharacterSize(24);
-	text.setFillColor(sf::Color::White);
-	text.setPosition(10.f, 10.f);
+			// Model matrices to MVP matrices, in one batch
+			if (buffer.size() > firstPacket)
+				MatrixBatch::multiply(viewProjection, &buffer[firstPacket].mvp, sizeof(DrawPacket), buffer.size() - firstPacket);
+		};
 
-	window.draw(text);
+	// Collectibles, only the ones not collected yet are in the store
+	const glm::vec3* collectiblePositions = collectibles.getPositions();
+	const float* collectibleSizes = collectibles.getSizes();
+	const JobSystem::RangeFunction recordCollectibles = [&](size_t begin, size_t end, unsigned worker)
+		{
+			std::vector<DrawPacket>& buffer = renderQueue.getBuffer(worker).packets;
+			const size_t firstPacket = buffer.size();
 
-	for (const auto& cube : pointCubes) {
-		cube.render();
-	}
+			DrawPacket packet;
+			packet.program = sceneProgram;
+			packet.texture = 0;
+			packet.layer = 0;
+			packet.mesh = MESH::CUBE;
+			packet.colour = glm::vec3(1.0f, 0.85f, 0.0f);
 
+			for (size_t i = begin; i < end; i++)
+			{
+				const glm::vec3& position = collectiblePositions[i];
+				glm::vec3 extent(collectibleSizes[i] * 0.5f);
 
-	// Restore OpenGL render states
-	// https://www.sfml-dev.org/documentation/2.0/classsf_1_1RenderTarget.php#a8d1998464ccc54e789aaf990242b47f7
+				if (!frustum.intersects(position - extent, position + extent))
+					continue;
 
-	window.popGLStates();
+				packet.mvp = placed(position + collectibleSizes[i] * cubeOffset, collectibleSizes[i] * cubeScale);
+				packet.key = RenderQueue::makeKey(PASS::GEOMETRY, packet.program, packet.texture, packet.mesh,
+					RenderQueue::quantizeDepth(PASS::GEOMETRY, -(view * glm::vec4(position, 1.0f)).z, zNear, zFar));
+				buffer.push_back(packet);
+			}
 
-	// Rebind Buffers and then set SubData
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vib);
+			if (buffer.size() > firstPacket)
+				MatrixBatch::multiply(viewProjection, &buffer[firstPacket].mvp, sizeof(DrawPacket), buffer.size() - firstPacket);
+		};
 
-	// Use Progam on GPU
-	glUseProgram(progID);
+	// Crowd agents, bosses in red
+	const JobSystem::RangeFunction recordAgents = [&](size_t begin, size_t end, unsigned worker)
+		{
+			std::vector<DrawPacket>& buffer = renderQueue.getBuffer(worker).packets;
+			const size_t firstPacket = buffer.size();
+
+			DrawPacket packet;
+			packet.program = sceneProgram;
+			packet.texture = 0;
+			packet.layer = 0;
+			packet.mesh = MESH::CUBE;
+			const float size = 0.3f;
+			const glm::vec3 extent(0.5f * size);
+
+			for (size_t i = begin; i < end; i++)
+			{
+				const glm::vec3& position = agentPositions[i];
+				if (!frustum.intersects(position - extent, position + extent))
+					continue;
+
+				packet.mvp = placed(position + size * cubeOffset, size * cubeScale);
+				packet.colour = agentTypes[i] == gpp::TYPE::BOSS ? glm::vec3(0.9f, 0.1f, 0.1f) : glm::vec3(0.2f, 0.5f, 1.0f);
+				packet.key = RenderQueue::makeKey(PASS::GEOMETRY, packet.program, packet.texture, packet.mesh,
+					RenderQueue::quantizeDepth(PASS::GEOMETRY, -(view * glm::vec4(position, 1.0f)).z, zNear, zFar));
+				buffer.push_back(packet);
+			}
 
-	// Find variables within the shader
-	// https://www.khronos.org/opengles/sdk/docs/man/xhtml/glGetAttribLocation.xml
-	positionID = glGetAttribLocation(progID, "sv_position");
-	if (positionID == -1)
+			if (buffer.size() > firstPacket)
+				MatrixBatch::multiply(viewProjection, &buffer[firstPacket].mvp, sizeof(DrawPacket), buffer.size() - firstPacket);
+		};
+
+	// Walls, collectibles and agents are recorded at the same time, the render thread helps until all are done
+	const size_t agentCount = agentPositions.size() < agentTypes.size() ? agentPositions.size() : agentTypes.size();
+	JobCounter recorded;
+	jobs.parallelFor((size_t)(chunksX * chunksZ), 1, recordWalls, recorded);
+	jobs.parallelFor(collectibles.size(), 1024, recordCollectibles, recorded);
+	jobs.parallelFor(agentCount, 1024, recordAgents, recorded);
+	jobs.wait(recorded);
+
+	// Player and HUD, recorded by the render thread (worker 0)
+	std::vector<DrawPacket>& buffer = renderQueue.getBuffer(0).packets;
+
+	DrawPacket packet;
+	packet.program = sceneProgram;
+	packet.texture = 0;
+	packet.layer = 0;
+	packet.mesh = MESH::CUBE;
+	packet.colour = glm::vec3(0.0f, 1.0f, 0.0f);
+
+	// Entities are drawn with the MVP matrices of this frame, see updateMVPMatrix()
+	const int playerIndex = entities.getIndex(player);
+	if (playerIndex >= 0 && (size_t)playerIndex < entityMVPs.size())
 	{
-		throw runtime_error("\nERROR: positionID not found\n");
+		packet.mvp = entityMVPs[playerIndex] * unitCube;
+		packet.key = RenderQueue::makeKey(PASS::GEOMETRY, packet.program, packet.texture, packet.mesh,
+			RenderQueue::quantizeDepth(PASS::GEOMETRY, -(view * glm::vec4(playerPosition, 1.0f)).z, zNear, zFar));
+		buffer.push_back(packet);
 	}
 
-	colorID = glGetAttribLocation(progID, "sv_colour");
-	if (colorID == -1)
-	{
-		throw runtime_error("\nERROR: colorID not found\n");
-	}
+	packet.program = 0; // The HUD binds its own program
+	packet.mesh = MESH::HUD_TEXT;
+	packet.colour = glm::vec3(1.0f);
+	packet.key = RenderQueue::makeKey(PASS::HUD, 0, 0, packet.mesh, 0);
+	buffer.push_back(packet);
 
-	uvID = glGetAttribLocation(progID, "sv_uv");
-	if (uvID == -1)
-	{
-		throw runtime_error("\nERROR: uvID not found\n");
-	}
+	renderQueue.merge();
+}
 
-	textureID = glGetUniformLocation(progID, "f_texture");
-	if (textureID == -1)
-	{
-		throw runtime_error("\nERROR: textureID not found\n");
-	}
+/**
+ * @brief Executes the sorted render queue.
+ *
+ * Program, texture and pass state are only changed when they differ from the previous packet. Walls and
+ * cubes are the shared cube mesh drawn through the scene program, its MVP matrix, colour and atlas
+ * rectangle set per draw.
+ */
+void Game::executeRenderQueue()
+{
+	bool first = true;
+	PASS pass = PASS::GEOMETRY;
+	GLuint program = 0;
+	GLuint texture = 0;
+
+	glActiveTexture(GL_TEXTURE0);
 
-	mvpID = glGetUniformLocation(progID, "sv_mvp");
-	if (mvpID < 0)
+	for (size_t i = 0; i < renderQueue.size(); i++)
 	{
-		throw runtime_error("\nERROR: mvpID not found\n");
-	}
+		const DrawPacket& packet = renderQueue[i];
+		PASS packetPass = (PASS)(packet.key >> RenderQueue::PASS_SHIFT);
 
+		if (first || packetPass != pass)
+		{
+			pass = packetPass;
+			if (pass == PASS::TRANSLUCENT)
+			{
+				glEnable(GL_BLEND);
+				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				glDepthMask(GL_FALSE);
+			}
+			else
+			{
+				glDisable(GL_BLEND);
+				glDepthMask(GL_TRUE);
+			}
+		}
 
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glLoadIdentity();
+		const bool programChanged = first || packet.program != program;
+		if (programChanged)
+		{
+			program = packet.program;
+			glUseProgram(program);
+		}
 
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
+		if (programChanged || packet.texture != texture)
+		{
+			texture = packet.texture;
+			glBindTexture(GL_TEXTURE_2D, texture);
+			if (program == progID && texturedID >= 0)
+				glUniform1f(texturedID, texture != 0 ? 1.0f : 0.0f);
+		}
 
-	// Camera setup
-	gluLookAt(cameraPosition.x, cameraPosition.y, cameraPosition.z,
-		cameraTarget.x, cameraTarget.y, cameraTarget.z,
-		cameraUp.x, cameraUp.y, cameraUp.z);
+		first = false;
 
-	glm::mat4 modelMatrix = game_objects[0]->getModelMatrix();  // Assume each object has a model matrix
-	glm::mat4 mvp = projectionMatrix * viewMatrix * modelMatrix;
-	for (auto* object : game_objects) {
-		glPushMatrix();
-		glMultMatrixf(glm::value_ptr(object->getModelMatrix()));
+		if (packet.mesh == MESH::HUD_TEXT)
+		{
+			renderHUD();
+			program = 0; // Left unbound by the HUD
+			continue;
+		}
 
-		drawCube(1.0f);
+		// Geometry is only drawn with the scene program the locations belong to
+		if ((packet.mesh != MESH::WALL && packet.mesh != MESH::CUBE) || program != progID)
+			continue;
 
-		glPopMatrix();
-	}
+		// Layers share the atlas texture, only the UVs change
+		if (uvRectID >= 0)
+			glUniform4fv(uvRectID, 1, glm::value_ptr(atlas.getRect(packet.layer)));
+		glUniformMatrix4fv(mvpID, 1, GL_FALSE, glm::value_ptr(packet.mvp));
+		if (colorID >= 0)
+			glVertexAttrib4f(colorID, packet.colour.x, packet.colour.y, packet.colour.z, 1.0f);
 
-	for (PointCube& cube : pointCubes) {
-		cube.render();
+		// The packet's colour replaces the mesh's vertex colours
+		cubeMesh->draw(positionID, -1, uvID, -1);
 	}
 
-	//debugging
-	std::cout << "Camera Position: (" << cameraPosition.x << ", " << cameraPosition.y << ", " << cameraPosition.z << ")" << std::endl;
-	std::cout << "Camera Target: (" << cameraTarget.x << ", " << cameraTarget.y << ", " << cameraTarget.z << ")" << std::endl;
-
-	// Set the view matrix
-	glm::mat4 projection = glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
-	glm::mat4 view = viewMatrix;
-
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+}
 
-	renderMaze();
-	renderPlayer();
-	
+/**
+ * @brief Draws the heads-up display (points) on top of the scene.
+ */
+void Game::renderHUD()
+{
+	hud.draw(window.getSize().x, window.getSize().y);
+}
 
-	// Render each game object
-	for (auto* object : game_objects) {
-		glPushMatrix();
-		glMultMatrixf(glm::value_ptr(object->getModelMatrix()));
+/**
+ * @brief Renders the game scene.
+ *
+ * Method clears the color and depth buffers, sets up the camera, builds the render queue for the frame,
+ * sorts it and executes it, then presents the frame.
+ */
+void Game::render()
+{
 
-		drawCube(object->getSize()); 
+#if (DEBUG >= 2)
+	DEBUG_MSG("Render Loop...");
+#endif
 
-		glPopMatrix();
-	}
+	// Clear the screen
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	window.display();
+	// Camera setup, as left by update()
+	const glm::mat4& view = camera.getView();
+	const glm::mat4& projection = camera.getProjection();
 
-	// Disable Arrays
-	glDisableVertexAttribArray(positionID);
-	glDisableVertexAttribArray(colorID);
-	glDisableVertexAttribArray(uvID);
+	// Transfer this frame's share of any streamed textures before they are recorded
+	streamer.update();
 
-	// Unbind Buffers with 0 (Resets OpenGL States...important step)
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	// Record (on the workers), sort and draw this frame's packets
+	buildRenderQueue(view, projection);
+	renderQueue.sort();
+	executeRenderQueue();
 
-	// Reset the Shader Program to Use
-	glUseProgram(0);
+	window.display();
 
 	// Check for OpenGL Error code
 	error = glGetError();
@@ -1033,11 +1378,9 @@ void Game::unload()
 	glDeleteBuffers(1, &VBO);
 	glDeleteVertexArrays(1, &VAO);
 
-	// Delete the vertex index buffer object
-	glDeleteBuffers(1, &vib);
-
-	// Free the image data
-	stbi_image_free(img_data);
+	// Release the shared meshes, their buffers go with the last reference
+	entities.clear();
+	cubeMesh.reset();
 
 #if (DEBUG >= 2)
 	DEBUG_MSG("Cleaning up...ENDS");
@@ -0,0 +1,107 @@
+/**
+ * @file GridCollider.cpp
+ * @brief Contains the implementation of the GridCollider class.
+ */
+
+#include <math.h>	 // For floorf, ceilf, fabsf
+#include <algorithm> // For std::min, std::max
+
+#include <./include/GridCollider.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const float SKIN = 1e-4f; // Gap left between a stopped box and the wall, keeps it out of the wall's cell
+}
+
+GridCollider::GridCollider(const std::vector<std::vector<int>>& grid)
+	: grid(grid)
+{
+}
+
+/**
+ * @brief Moves a box as far as the walls let it, sliding along them.
+ */
+glm::vec3 GridCollider::move(const glm::vec3& position, const glm::vec3& halfExtent, const glm::vec3& displacement) const
+{
+	glm::vec3 moved = position;
+	moved.y += displacement.y;
+
+	// The longer axis first, so a glancing move along a wall is not stopped by its short component
+	const int first = fabsf(displacement.x) >= fabsf(displacement.z) ? 0 : 2;
+	const int second = 2 - first;
+
+	moved[first] += sweep(moved, halfExtent, first, displacement[first]);
+	moved[second] += sweep(moved, halfExtent, second, displacement[second]);
+	return moved;
+}
+
+/**
+ * @brief Getter method for whether a cell is a wall, cells outside the grid are open.
+ */
+bool GridCollider::isWall(int x, int z) const
+{
+	if (x < 0 || x >= (int)grid.size() || z < 0 || z >= (int)grid[x].size())
+		return false;
+	return grid[x][z] == 1;
+}
+
+/**
+ * @brief Sweeps a box along one axis through the cells its leading face crosses.
+ *
+ * @param position Centre of the box.
+ * @param halfExtent Half size of the box.
+ * @param axis 0 for x, 2 for z.
+ * @param distance Signed movement along the axis.
+ * @return Signed movement allowed before the first wall.
+ */
+float GridCollider::sweep(const glm::vec3& position, const glm::vec3& halfExtent, int axis, float distance) const
+{
+	if (distance == 0.0f)
+		return 0.0f;
+
+	// Only cells inside the grid can be walls, so both ranges are clipped to it
+	const int width = (int)grid.size();
+	const int depth = width > 0 ? (int)grid[0].size() : 0;
+	const int cells = axis == 0 ? width : depth;
+	const int rows = axis == 0 ? depth : width;
+
+	// Rows of cells the box covers across the movement
+	const int across = 2 - axis;
+	const int low = std::max((int)floorf(position[across] - halfExtent[across]), 0);
+	const int high = std::min((int)ceilf(position[across] + halfExtent[across]) - 1, rows - 1);
+
+	if (distance > 0.0f)
+	{
+		// Cells entered have their near side in [leading, leading + distance)
+		const float leading = position[axis] + halfExtent[axis];
+		const int begin = std::max((int)ceilf(leading), 0);
+		const int end = std::min((int)ceilf(leading + distance), cells);
+		for (int cell = begin; cell < end; cell++)
+		{
+			for (int row = low; row <= high; row++)
+			{
+				if (axis == 0 ? isWall(cell, row) : isWall(row, cell))
+					return fmaxf(0.0f, (float)cell - SKIN - leading);
+			}
+		}
+	}
+	else
+	{
+		// Cells entered have their near side in (leading + distance, leading]
+		const float leading = position[axis] - halfExtent[axis];
+		const int begin = std::min((int)floorf(leading) - 1, cells - 1);
+		const int end = std::max((int)floorf(leading + distance), 0);
+		for (int cell = begin; cell >= end; cell--)
+		{
+			for (int row = low; row <= high; row++)
+			{
+				if (axis == 0 ? isWall(cell, row) : isWall(row, cell))
+					return fminf(0.0f, (float)(cell + 1) + SKIN - leading);
+			}
+		}
+	}
+
+	return distance;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file HUD.cpp
+ * @brief Contains the implementation of the HUD class.
+ */
+
+#include <iostream> // For debug output
+
+#include <./include/HUD.h>
+#include <./include/Debug.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	// Pixel coordinates (origin at the top left) to clip space
+	const char* HUD_VERTEX_SHADER =
+		"#version 130\n"
+		"\n"
+		"in vec2 sv_position;\n"
+		"in vec2 sv_uv;\n"
+		"\n"
+		"out vec2 uv;\n"
+		"\n"
+		"uniform vec2 sv_screen;\n"
+		"\n"
+		"void main() {\n"
+		"	uv = sv_uv;\n"
+		"	gl_Position = vec4(sv_position.x / sv_screen.x * 2.0 - 1.0, 1.0 - sv_position.y / sv_screen.y * 2.0, 0.0, 1.0);\n"
+		"}\n";
+
+	// Antialiased over one screen pixel of distance, whatever the text size
+	const char* HUD_FRAGMENT_SHADER =
+		"#version 130\n"
+		"\n"
+		"uniform sampler2D f_texture;\n"
+		"uniform vec4 f_colour;\n"
+		"\n"
+		"in vec2 uv;\n"
+		"\n"
+		"out vec4 fColor;\n"
+		"\n"
+		"void main() {\n"
+		"	float distance = texture2D(f_texture, uv).a;\n"
+		"	float width = max(fwidth(distance) * 0.5, 0.001);\n"
+		"	float coverage = smoothstep(0.5 - width, 0.5 + width, distance);\n"
+		"	fColor = vec4(f_colour.rgb, f_colour.a * coverage);\n"
+		"}\n";
+
+	GLuint compileShader(GLenum type, const char* source)
+	{
+		GLuint shader = glCreateShader(type);
+		glShaderSource(shader, 1, (const GLchar**)&source, NULL);
+		glCompileShader(shader);
+
+		GLint isCompiled = GL_FALSE;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+		if (isCompiled != GL_TRUE)
+		{
+			GLint logLength = 0;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+			std::string errorLog(logLength > 0 ? logLength : 1, '\0');
+			glGetShaderInfoLog(shader, logLength, &logLength, &errorLog[0]);
+			DEBUG_MSG("ERROR: HUD shader not compiled " + errorLog);
+			glDeleteShader(shader);
+			return 0;
+		}
+		return shader;
+	}
+}
+
+HUD::HUD()
+	: font(new SdfFont()), characterSize(24), x(0.0f), y(0.0f), loaded(false), dirty(true), vbo(0), vertexCount(0),
+	  program(0), positionID(-1), uvID(-1), screenID(-1), textureID(-1), colourID(-1)
+{
+}
+
+/**
+ * @brief Destructor for the HUD class, releases the vertex buffer and the shader.
+ */
+HUD::~HUD()
+{
+	if (vbo != 0)
+		glDeleteBuffers(1, &vbo);
+
+	if (program != 0)
+		glDeleteProgram(program);
+}
+
+/**
+ * @brief Loads the distance field atlas of the font and builds the shader.
+ *
+ * The atlas is read from its cache when the font is unchanged, so no glyph is rasterised at runtime.
+ */
+bool HUD::load(const std::string& filename, unsigned size, const AssetPack* pack)
+{
+	return prepare(filename, size, pack) && upload();
+}
+
+/**
+ * @brief CPU half of load(), reads or bakes the atlas without touching the GL context.
+ */
+bool HUD::prepare(const std::string& filename, unsigned size, const AssetPack* pack)
+{
+	loaded = false;
+	characterSize = size;
+	dirty = true;
+
+	if (!font->prepare(filename, pack))
+	{
+		DEBUG_MSG("ERROR: HUD font not loaded " + filename);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief GL half of load(), uploads the prepared atlas and builds the shader.
+ */
+bool HUD::upload()
+{
+	font->upload();
+	loaded = font->isLoaded() && buildShader();
+	return loaded;
+}
+
+/**
+ * @brief Reads or bakes the font again into a spare atlas.
+ */
+bool HUD::prepareReload(const std::string& filename, const AssetPack* pack)
+{
+	std::unique_ptr<SdfFont> next(new SdfFont(font->getBaseSize(), font->getSpread()));
+	if (!next->prepare(filename, pack))
+	{
+		DEBUG_MSG("ERROR: HUD font not reloaded " + filename);
+		return false;
+	}
+
+	reloaded = std::move(next);
+	return true;
+}
+
+/**
+ * @brief Swaps the atlas from prepareReload() in, the text is laid out again with its metrics.
+ */
+void HUD::applyReload()
+{
+	if (!reloaded)
+		return;
+
+	reloaded->upload();
+	if (reloaded->isLoaded())
+	{
+		font = std::move(reloaded);
+		loaded = program != 0;
+		dirty = true;
+	}
+	reloaded.reset();
+}
+
+/**
+ * @brief Compiles and links the distance field shader.
+ */
+bool HUD::buildShader()
+{
+	if (program != 0)
+		return true;
+
+	GLuint vertexShader = compileShader(GL_VERTEX_SHADER, HUD_VERTEX_SHADER);
+	GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, HUD_FRAGMENT_SHADER);
+
+	if (vertexShader != 0 && fragmentShader != 0)
+	{
+		program = glCreateProgram();
+		glAttachShader(program, vertexShader);
+		glAttachShader(program, fragmentShader);
+		glLinkProgram(program);
+
+		GLint isLinked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked != GL_TRUE)
+		{
+			DEBUG_MSG("ERROR: HUD shader not linked");
+			glDeleteProgram(program);
+			program = 0;
+		}
+	}
+
+	// The program keeps what it needs
+	if (vertexShader != 0)
+		glDeleteShader(vertexShader);
+	if (fragmentShader != 0)
+		glDeleteShader(fragmentShader);
+
+	if (program == 0)
+		return false;
+
+	positionID = glGetAttribLocation(program, "sv_position");
+	uvID = glGetAttribLocation(program, "sv_uv");
+	screenID = glGetUniformLocation(program, "sv_screen");
+	textureID = glGetUniformLocation(program, "f_texture");
+	colourID = glGetUniformLocation(program, "f_colour");
+	return true;
+}
+
+/**
+ * @brief Setter method for the displayed text.
+ */
+void HUD::setText(const std::string& text)
+{
+	if (text != this->text)
+	{
+		this->text = text;
+		dirty = true;
+	}
+}
+
+/**
+ * @brief Setter method for the character size.
+ */
+void HUD::setCharacterSize(unsigned size)
+{
+	if (size != characterSize)
+	{
+		characterSize = size;
+		dirty = true;
+	}
+}
+
+/**
+ * @brief Setter method for the top left corner of the text in pixels.
+ */
+void HUD::setPosition(float x, float y)
+{
+	if (x != this->x || y != this->y)
+	{
+		this->x = x;
+		this->y = y;
+		dirty = true;
+	}
+}
+
+/**
+ * @brief Rebuilds the vertex buffer, two triangles per visible glyph scaled from the base size.
+ */
+void HUD::rebuild()
+{
+	const float scale = (float)characterSize / (float)font->getBaseSize();
+
+	vertices.clear();
+
+	float penX = x;
+	float baseline = y + (float)characterSize;
+	unsigned previous = 0;
+
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		unsigned c = (unsigned char)text[i];
+		const SdfGlyph* glyph = font->getGlyph(c);
+		if (glyph == NULL)
+			continue;
+
+		penX += font->getKerning(previous, c) * scale;
+		previous = c;
+
+		float left = penX + glyph->left * scale;
+		float top = baseline + glyph->top * scale;
+		float right = left + glyph->width * scale;
+		float bottom = top + glyph->height * scale;
+
+		const GLfloat quad[] = {
+			left, top, glyph->u0, glyph->v0,
+			right, top, glyph->u1, glyph->v0,
+			right, bottom, glyph->u1, glyph->v1,
+			right, bottom, glyph->u1, glyph->v1,
+			left, bottom, glyph->u0, glyph->v1,
+			left, top, glyph->u0, glyph->v0,
+		};
+		vertices.insert(vertices.end(), quad, quad + sizeof(quad) / sizeof(quad[0]));
+
+		penX += glyph->advance * scale;
+	}
+
+	if (vbo == 0)
+		glGenBuffers(1, &vbo);
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.empty() ? NULL : &vertices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	vertexCount = (GLsizei)(vertices.size() / 4);
+	dirty = false;
+}
+
+/**
+ * @brief Draws the text in screen space on top of the scene.
+ *
+ * Leaves no program or texture bound, as the render queue expects for the HUD pass.
+ */
+void HUD::draw(unsigned screenWidth, unsigned screenHeight)
+{
+	if (!loaded)
+		return;
+
+	if (dirty)
+		rebuild();
+
+	if (vertexCount == 0)
+		return;
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_CULL_FACE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glUseProgram(program);
+	glUniform2f(screenID, (GLfloat)screenWidth, (GLfloat)screenHeight);
+	glUniform4f(colourID, 1.0f, 1.0f, 1.0f, 1.0f);
+	glUniform1i(textureID, 0);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, font->getTexture());
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glEnableVertexAttribArray(positionID);
+	glEnableVertexAttribArray(uvID);
+	glVertexAttribPointer(positionID, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void*)0);
+	glVertexAttribPointer(uvID, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void*)(2 * sizeof(GLfloat)));
+
+	glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+
+	glDisableVertexAttribArray(uvID);
+	glDisableVertexAttribArray(positionID);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+	glDisable(GL_BLEND);
+	glEnable(GL_CULL_FACE);
+	glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,306 @@
+/**
+ * @file HotReload.cpp
+ * @brief Contains the implementation of the HotReload class.
+ */
+
+#if defined(__linux__)
+#include <dirent.h>		   // Directory listing
+#include <poll.h>		   // Waiting for events with a timeout
+#include <sys/inotify.h>   // File change notifications
+#include <sys/stat.h>	   // File type
+#include <unistd.h>		   // read, close
+#endif
+
+#include <iostream> // For debug output
+
+#include <./include/HotReload.h>
+#include <./include/Debug.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	// Path as registered, without a leading "./"
+	std::string normalise(const std::string& path)
+	{
+		return path.compare(0, 2, "./") == 0 ? path.substr(2) : path;
+	}
+
+	const int POLL_MILLISECONDS = 100; // Longest the watcher takes to notice stop()
+}
+
+HotReload::HotReload()
+	: stopping(false), descriptor(-1)
+{
+}
+
+/**
+ * @brief Destructor for the HotReload class, stops the threads.
+ */
+HotReload::~HotReload()
+{
+	stop();
+}
+
+/**
+ * @brief Registers a resource, before start().
+ */
+void HotReload::add(const std::string& path, const DecodeFunction& decode, const ApplyFunction& apply)
+{
+	std::unique_ptr<Resource> resource(new Resource());
+	resource->path = normalise(path);
+	resource->decode = decode;
+	resource->apply = apply;
+	resource->queued = false;
+	resource->busy = false;
+	resource->changed = false;
+	resources.push_back(std::move(resource));
+}
+
+/**
+ * @brief Starts watching directories and their subdirectories.
+ */
+bool HotReload::start(const std::vector<std::string>& directories)
+{
+	stop();
+
+#if defined(__linux__)
+	descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (descriptor < 0)
+		return false;
+
+	for (size_t i = 0; i < directories.size(); i++)
+		addWatch(normalise(directories[i]));
+
+	if (watches.empty())
+	{
+		close(descriptor);
+		descriptor = -1;
+		return false;
+	}
+
+	stopping = false;
+	watcher = std::thread(&HotReload::watchLoop, this);
+	decoder = std::thread(&HotReload::decodeLoop, this);
+	return true;
+#else
+	(void)directories;
+	return false;
+#endif
+}
+
+/**
+ * @brief Stops the threads, reloads still queued are dropped.
+ */
+void HotReload::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	if (watcher.joinable())
+		watcher.join();
+	if (decoder.joinable())
+		decoder.join();
+
+#if defined(__linux__)
+	if (descriptor >= 0)
+		close(descriptor);
+#endif
+	descriptor = -1;
+	watches.clear();
+
+	for (size_t i = 0; i < resources.size(); i++)
+	{
+		resources[i]->queued = false;
+		resources[i]->busy = false;
+		resources[i]->changed = false;
+	}
+	decodeQueue.clear();
+	applyQueue.clear();
+}
+
+bool HotReload::isRunning() const { return descriptor >= 0; }
+
+/**
+ * @brief Watches a directory and, recursively, its subdirectories (inotify watches are not recursive).
+ */
+void HotReload::addWatch(const std::string& directory)
+{
+#if defined(__linux__)
+	const int watch = inotify_add_watch(descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if (watch < 0)
+		return;
+	watches[watch] = directory;
+
+	DIR* dir = opendir(directory.c_str());
+	if (dir == NULL)
+		return;
+
+	while (struct dirent* entry = readdir(dir))
+	{
+		std::string name = entry->d_name;
+		if (name.empty() || name[0] == '.')
+			continue;
+
+		std::string path = directory + "/" + name;
+		struct stat info;
+		if (stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+			addWatch(path);
+	}
+	closedir(dir);
+#else
+	(void)directory;
+#endif
+}
+
+/**
+ * @brief Queues the resources read from a changed file.
+ *
+ * @param path Path of the file, relative like the registered paths.
+ */
+void HotReload::changed(const std::string& path)
+{
+	bool queued = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t i = 0; i < resources.size(); i++)
+		{
+			Resource& resource = *resources[i];
+			if (resource.path != path || resource.queued)
+				continue;
+
+			if (resource.busy)
+			{
+				resource.changed = true;
+				continue;
+			}
+
+			resource.queued = true;
+			decodeQueue.push_back(&resource);
+			queued = true;
+		}
+	}
+
+	if (queued)
+	{
+		DEBUG_MSG("Reloading " + path);
+		wake.notify_one();
+	}
+}
+
+/**
+ * @brief Watcher thread body, turns inotify events into queued resources until stop().
+ */
+void HotReload::watchLoop()
+{
+#if defined(__linux__)
+	// Large enough for many events, aligned for the event structure
+	alignas(struct inotify_event) char buffer[16 * 1024];
+
+	while (!stopping)
+	{
+		struct pollfd waiting = { descriptor, POLLIN, 0 };
+		if (poll(&waiting, 1, POLL_MILLISECONDS) <= 0)
+			continue;
+
+		const ssize_t length = read(descriptor, buffer, sizeof(buffer));
+		for (ssize_t offset = 0; offset < length;)
+		{
+			const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+			offset += sizeof(struct inotify_event) + event->len;
+
+			std::map<int, std::string>::const_iterator directory = watches.find(event->wd);
+			if (directory == watches.end() || event->len == 0)
+				continue;
+
+			const std::string path = directory->second + "/" + event->name;
+			if (event->mask & IN_ISDIR)
+			{
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					addWatch(path);
+			}
+			else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+			{
+				// Saves by rename arrive as IN_MOVED_TO, in place writes as IN_CLOSE_WRITE
+				changed(path);
+			}
+		}
+	}
+#endif
+}
+
+/**
+ * @brief Decode thread body, runs queued decode functions until stop().
+ */
+void HotReload::decodeLoop()
+{
+	for (;;)
+	{
+		Resource* resource = NULL;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this] { return stopping || !decodeQueue.empty(); });
+			if (stopping)
+				return;
+			resource = decodeQueue.front();
+			decodeQueue.pop_front();
+
+			// A change from here on is picked up once this reload is finished
+			resource->queued = false;
+			resource->busy = true;
+		}
+
+		if (resource->decode && !resource->decode())
+		{
+			DEBUG_MSG("ERROR: Reload failed, keeping " + resource->path);
+			finish(*resource);
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		applyQueue.push_back(resource);
+	}
+}
+
+/**
+ * @brief Ends a reload, queuing the resource again if its file changed meanwhile.
+ *
+ * @param resource Resource decoded (and applied, if its decode succeeded).
+ */
+void HotReload::finish(Resource& resource)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		resource.busy = false;
+		if (!resource.changed || stopping)
+			return;
+
+		resource.changed = false;
+		resource.queued = true;
+		decodeQueue.push_back(&resource);
+	}
+	wake.notify_one();
+}
+
+/**
+ * @brief Applies every reload decoded since the last call.
+ */
+size_t HotReload::update()
+{
+	std::deque<Resource*> decoded;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		decoded.swap(applyQueue);
+	}
+
+	for (size_t i = 0; i < decoded.size(); i++)
+	{
+		decoded[i]->apply();
+		finish(*decoded[i]);
+	}
+
+	return decoded.size();
+}
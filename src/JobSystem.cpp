@@ -0,0 +1,395 @@
+/**
+ * @file JobSystem.cpp
+ * @brief Contains the implementation of the JobSystem class.
+ */
+
+#include <./include/JobSystem.h>
+
+using namespace gpp; // GPP namespace
+
+namespace gpp
+{
+	/**
+	 * @struct Job
+	 * @brief A scheduled job, either a function or a range of a parallelFor().
+	 */
+	struct Job
+	{
+		JobSystem::JobFunction function;	   // Set for single jobs
+		const JobSystem::RangeFunction* range; // Set for ranges
+		size_t begin;
+		size_t end;
+		size_t grain;
+		JobCounter* counter; // May be NULL for single jobs
+		Job* next;			 // Next job waiting on the same counter
+	};
+}
+
+namespace
+{
+	// Worker the current thread is, for the system that started it
+	struct CurrentWorker
+	{
+		const JobSystem* system;
+		unsigned index;
+	};
+
+	thread_local CurrentWorker current = { NULL, 0 };
+
+	const unsigned SPIN_ATTEMPTS = 64; // Failed searches before a background worker sleeps
+
+	Job* newRangeJob(const JobSystem::RangeFunction* range, size_t begin, size_t end, size_t grain, JobCounter* counter)
+	{
+		Job* job = new Job();
+		job->range = range;
+		job->begin = begin;
+		job->end = end;
+		job->grain = grain;
+		job->counter = counter;
+		job->next = NULL;
+		return job;
+	}
+}
+
+JobCounter::JobCounter()
+	: pending(0), waiting(NULL)
+{
+}
+
+/**
+ * @brief Whether every job counted so far has finished. Use JobSystem::wait() before destroying the counter.
+ */
+bool JobCounter::isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+/**
+ * @brief Constructor for the JobSystem class, the calling thread becomes worker 0.
+ */
+JobSystem::JobSystem(unsigned count)
+	: queued(0), sleepers(0), stopping(false)
+{
+	if (count == 0)
+	{
+		unsigned hardware = std::thread::hardware_concurrency();
+		count = hardware > 1 ? hardware - 1 : 0;
+	}
+
+	for (unsigned i = 0; i <= count; i++)
+	{
+		workers.push_back(std::unique_ptr<Worker>(new Worker()));
+		workers.back()->random = 0x9E3779B9u * (i + 1);
+	}
+
+	current.system = this;
+	current.index = 0;
+
+	for (unsigned i = 0; i < count; i++)
+		threads.push_back(std::thread(&JobSystem::workerLoop, this, i + 1));
+}
+
+/**
+ * @brief Destructor for the JobSystem class, joins all worker threads.
+ */
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+
+	if (current.system == this)
+		current.system = NULL;
+}
+
+/**
+ * @brief Getter method for the number of workers including the main thread.
+ */
+unsigned JobSystem::getWorkerCount() const { return (unsigned)workers.size(); }
+
+/**
+ * @brief Getter method for the worker index of the calling thread.
+ */
+int JobSystem::getCurrentWorker() const { return current.system == this ? (int)current.index : -1; }
+
+/**
+ * @brief Schedules a job.
+ */
+void JobSystem::run(const JobFunction& fn, JobCounter* counter, JobCounter* after)
+{
+	Job* job = new Job();
+	job->function = fn;
+	job->range = NULL;
+	job->begin = 0;
+	job->end = 0;
+	job->grain = 0;
+	job->counter = counter;
+	job->next = NULL;
+
+	if (counter != NULL)
+		counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+	if (after != NULL)
+	{
+		// Checked under the lock finish() takes the waiting list with, so the job is either kept or started
+		std::lock_guard<std::mutex> lock(after->mutex);
+		if (after->pending.load(std::memory_order_acquire) != 0)
+		{
+			job->next = after->waiting;
+			after->waiting = job;
+			return;
+		}
+	}
+
+	schedule(job);
+}
+
+/**
+ * @brief Schedules [0, count) in ranges of at most grain items without waiting.
+ */
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeFunction& fn, JobCounter& counter)
+{
+	if (count == 0)
+		return;
+
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+	schedule(newRangeJob(&fn, 0, count, grain > 0 ? grain : 1, &counter));
+}
+
+/**
+ * @brief Runs [0, count) in ranges of at most grain items across every worker.
+ */
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeFunction& fn)
+{
+	if (count == 0)
+		return;
+
+	if (grain == 0)
+		grain = 1;
+
+	// Nothing to share, run inline
+	const int worker = getCurrentWorker();
+	if (worker >= 0 && (workers.size() == 1 || count <= grain))
+	{
+		fn(0, count, (unsigned)worker);
+		return;
+	}
+
+	JobCounter counter;
+	parallelFor(count, grain, fn, counter);
+	wait(counter);
+}
+
+/**
+ * @brief Runs jobs until every job counted on a counter has finished.
+ */
+void JobSystem::wait(JobCounter& counter)
+{
+	const int worker = getCurrentWorker();
+	while (counter.pending.load(std::memory_order_acquire) != 0)
+	{
+		Job* job;
+		if (worker >= 0 && findJob((unsigned)worker, job))
+			execute(job, (unsigned)worker);
+		else
+			std::this_thread::yield();
+	}
+
+	// The last finish() may still hold the lock, the counter must not go before it lets go
+	std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+/**
+ * @brief Runs one scheduled job on the calling worker, if any can be found.
+ */
+bool JobSystem::runPendingJob()
+{
+	const int worker = getCurrentWorker();
+	Job* job;
+	if (worker < 0 || !findJob((unsigned)worker, job))
+		return false;
+
+	execute(job, (unsigned)worker);
+	return true;
+}
+
+/**
+ * @brief Queues a job whose dependencies are done, on the calling worker's deque if it is a worker.
+ *
+ * A worker whose deque is full runs the job at once instead.
+ */
+void JobSystem::schedule(Job* job)
+{
+	queued.fetch_add(1);
+
+	const int worker = getCurrentWorker();
+	if (worker < 0)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		shared.push_back(job);
+	}
+	else if (!workers[worker]->jobs.push(job))
+	{
+		queued.fetch_sub(1);
+		execute(job, (unsigned)worker);
+		return;
+	}
+
+	// Pairs with the sleeper count going up before a worker checks queued, so no wake-up is lost
+	if (sleepers.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		wake.notify_one();
+	}
+}
+
+/**
+ * @brief Takes a job: the worker's newest own job, else the oldest job of a random other worker,
+ * else one from the shared queue.
+ *
+ * @return false if none was found.
+ */
+bool JobSystem::findJob(unsigned worker, Job*& job)
+{
+	Worker& self = *workers[worker];
+	if (self.jobs.pop(job))
+	{
+		queued.fetch_sub(1);
+		return true;
+	}
+
+	const unsigned count = (unsigned)workers.size();
+	if (count > 1)
+	{
+		// Xorshift, so workers do not all go after the same victim
+		self.random ^= self.random << 13;
+		self.random ^= self.random >> 17;
+		self.random ^= self.random << 5;
+
+		const unsigned start = self.random % count;
+		for (unsigned i = 0; i < count; i++)
+		{
+			const unsigned victim = (start + i) % count;
+			if (victim != worker && workers[victim]->jobs.steal(job))
+			{
+				queued.fetch_sub(1);
+				return true;
+			}
+		}
+	}
+
+	if (queued.load(std::memory_order_relaxed) == 0)
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (shared.empty())
+		return false;
+
+	job = shared.front();
+	shared.pop_front();
+	queued.fetch_sub(1);
+	return true;
+}
+
+/**
+ * @brief Runs a job and counts it as finished.
+ *
+ * A range first splits off its upper half onto the worker's deque until it is no larger than its
+ * grain, so a thief always takes the largest piece left.
+ */
+void JobSystem::execute(Job* job, unsigned worker)
+{
+	if (job->range != NULL)
+	{
+		while (job->end - job->begin > job->grain)
+		{
+			const size_t middle = job->begin + (job->end - job->begin) / 2;
+			job->counter->pending.fetch_add(1, std::memory_order_relaxed);
+			Job* half = newRangeJob(job->range, middle, job->end, job->grain, job->counter);
+			job->end = middle;
+			schedule(half);
+		}
+
+		(*job->range)(job->begin, job->end, worker);
+	}
+	else
+	{
+		job->function(worker);
+	}
+
+	JobCounter* counter = job->counter;
+	delete job;
+
+	if (counter != NULL)
+		finish(counter);
+}
+
+/**
+ * @brief Counts a job of a counter as finished, starting the jobs waiting on the counter when it was the last.
+ */
+void JobSystem::finish(JobCounter* counter)
+{
+	// Not the last job: drop the count without touching the counter again
+	size_t pending = counter->pending.load(std::memory_order_relaxed);
+	while (pending > 1)
+	{
+		if (counter->pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+			return;
+	}
+
+	// Possibly the last: wait() holds the counter alive until the lock is released
+	Job* ready = NULL;
+	{
+		std::lock_guard<std::mutex> lock(counter->mutex);
+		if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			ready = counter->waiting;
+			counter->waiting = NULL;
+		}
+	}
+
+	while (ready != NULL)
+	{
+		Job* next = ready->next;
+		ready->next = NULL;
+		schedule(ready);
+		ready = next;
+	}
+}
+
+/**
+ * @brief Background thread body, runs and steals jobs until the system is destroyed.
+ */
+void JobSystem::workerLoop(unsigned worker)
+{
+	current.system = this;
+	current.index = worker;
+
+	unsigned idle = 0;
+	for (;;)
+	{
+		Job* job;
+		if (findJob(worker, job))
+		{
+			execute(job, worker);
+			idle = 0;
+			continue;
+		}
+
+		if (++idle < SPIN_ATTEMPTS)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		sleepers.fetch_add(1);
+		wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+		sleepers.fetch_sub(1);
+		if (stopping)
+			return;
+		idle = 0;
+	}
+}
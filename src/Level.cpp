@@ -0,0 +1,286 @@
+/**
+ * @file Level.cpp
+ * @brief Contains the implementation of the Level class.
+ */
+
+#include <stdio.h>	// For writing levels
+#include <string.h> // For memcmp, memcpy, strncmp
+
+#include <./include/Level.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const char LEVEL_MAGIC[4] = { 'G', 'L', 'V', 'L' };
+	const uint64_t SECTION_ALIGNMENT = 16;
+	const uint32_t SECTION_COUNT = 4;
+
+	struct LevelHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t sectionCount;
+		uint32_t mazeWidth;
+		uint32_t mazeHeight;
+		uint32_t reserved[3];
+	};
+
+	struct LevelSectionEntry
+	{
+		uint32_t id;	 // LEVEL_SECTION
+		uint32_t stride; // Bytes per element
+		uint64_t count;	 // Elements
+		uint64_t offset; // From the start of the file
+	};
+
+	uint64_t align(uint64_t offset) { return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1); }
+
+	/**
+	 * @brief Locates a section in a mapped level, NULL if it is missing, has another stride or lies outside the file.
+	 */
+	const void* findSection(const unsigned char* data, size_t size, LEVEL_SECTION id, uint32_t stride, uint64_t& count)
+	{
+		LevelHeader header;
+		memcpy(&header, data, sizeof(header));
+
+		const LevelSectionEntry* sections = reinterpret_cast<const LevelSectionEntry*>(data + sizeof(LevelHeader));
+		for (uint32_t i = 0; i < header.sectionCount; i++)
+		{
+			const LevelSectionEntry& section = sections[i];
+			if (section.id != (uint32_t)id)
+				continue;
+
+			// Element counts are checked against the size before multiplying, so a corrupt count cannot wrap
+			if (section.stride != stride || section.offset % SECTION_ALIGNMENT != 0 || section.offset > size ||
+				section.count > (size - section.offset) / stride)
+				return NULL;
+
+			count = section.count;
+			return data + section.offset;
+		}
+		return NULL;
+	}
+
+	bool writeSection(FILE* file, uint64_t& position, uint64_t offset, const void* data, size_t bytes)
+	{
+		static const unsigned char zeros[SECTION_ALIGNMENT] = { 0 };
+		const size_t padding = (size_t)(offset - position);
+		position = offset + bytes;
+		return (padding == 0 || fwrite(zeros, 1, padding, file) == padding) &&
+			   (bytes == 0 || fwrite(data, 1, bytes, file) == bytes);
+	}
+}
+
+Level::Level()
+	: width(0), height(0), cells(NULL), types(NULL), typeCount(0), collectibles(NULL), collectibleCount(0),
+	  spawns(NULL), spawnCount(0)
+{
+}
+
+/**
+ * @brief Destructor for the Level class, unmaps the file.
+ */
+Level::~Level()
+{
+	close();
+}
+
+/**
+ * @brief Maps a level file, found in the pack or on disk, and locates its sections.
+ */
+bool Level::open(const std::string& filename, const AssetPack* pack)
+{
+	close();
+
+	AssetView view;
+	const unsigned char* data = NULL;
+	size_t size = 0;
+
+	if (pack != NULL && pack->find(filename, view))
+	{
+		data = view.data;
+		size = view.size;
+	}
+	else if (file.open(filename))
+	{
+		data = file.getData();
+		size = file.getSize();
+	}
+
+	if (data == NULL || size < sizeof(LevelHeader))
+	{
+		close();
+		return false;
+	}
+
+	LevelHeader header;
+	memcpy(&header, data, sizeof(header));
+	if (memcmp(header.magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC)) != 0 || header.version != VERSION ||
+		header.sectionCount > (size - sizeof(LevelHeader)) / sizeof(LevelSectionEntry))
+	{
+		close();
+		return false;
+	}
+
+	uint64_t cellCount = 0, types64 = 0, collectibles64 = 0, spawns64 = 0;
+	const void* cellData = findSection(data, size, LEVEL_SECTION::MAZE, 1, cellCount);
+	const void* typeData = findSection(data, size, LEVEL_SECTION::OBJECT_TYPES, sizeof(LevelObjectType), types64);
+	const void* collectibleData = findSection(data, size, LEVEL_SECTION::COLLECTIBLES, sizeof(LevelCollectible), collectibles64);
+	const void* spawnData = findSection(data, size, LEVEL_SECTION::SPAWNS, sizeof(LevelSpawn), spawns64);
+
+	if (cellData == NULL || typeData == NULL || collectibleData == NULL || spawnData == NULL ||
+		cellCount != (uint64_t)header.mazeWidth * header.mazeHeight)
+	{
+		close();
+		return false;
+	}
+
+	width = header.mazeWidth;
+	height = header.mazeHeight;
+	cells = static_cast<const uint8_t*>(cellData);
+	types = static_cast<const LevelObjectType*>(typeData);
+	typeCount = (size_t)types64;
+	collectibles = static_cast<const LevelCollectible*>(collectibleData);
+	collectibleCount = (size_t)collectibles64;
+	spawns = static_cast<const LevelSpawn*>(spawnData);
+	spawnCount = (size_t)spawns64;
+
+	// The only per-object pass: a bad type index would otherwise be read out of bounds later
+	uint32_t badTypes = 0;
+	for (size_t i = 0; i < collectibleCount; i++)
+		badTypes |= collectibles[i].type >= typeCount;
+	for (size_t i = 0; i < spawnCount; i++)
+		badTypes |= spawns[i].type >= typeCount;
+
+	if (badTypes != 0)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Unmaps the level.
+ */
+void Level::close()
+{
+	file.close();
+	width = 0;
+	height = 0;
+	cells = NULL;
+	types = NULL;
+	typeCount = 0;
+	collectibles = NULL;
+	collectibleCount = 0;
+	spawns = NULL;
+	spawnCount = 0;
+}
+
+bool Level::isOpen() const { return cells != NULL; }
+
+uint32_t Level::getMazeWidth() const { return width; }
+
+uint32_t Level::getMazeHeight() const { return height; }
+
+const uint8_t* Level::getCells() const { return cells; }
+
+const LevelObjectType* Level::getObjectTypes() const { return types; }
+
+size_t Level::getObjectTypeCount() const { return typeCount; }
+
+const LevelCollectible* Level::getCollectibles() const { return collectibles; }
+
+size_t Level::getCollectibleCount() const { return collectibleCount; }
+
+const LevelSpawn* Level::getSpawns() const { return spawns; }
+
+size_t Level::getSpawnCount() const { return spawnCount; }
+
+/**
+ * @brief Looks up an object type by name.
+ */
+int Level::findObjectType(const std::string& name) const
+{
+	for (size_t i = 0; i < typeCount; i++)
+		if (strncmp(types[i].name, name.c_str(), sizeof(types[i].name)) == 0)
+			return (int)i;
+	return -1;
+}
+
+/**
+ * @brief Looks up the first spawn of an object type.
+ */
+const LevelSpawn* Level::findSpawn(const std::string& name) const
+{
+	const int type = findObjectType(name);
+	for (size_t i = 0; type >= 0 && i < spawnCount; i++)
+		if (spawns[i].type == (uint32_t)type)
+			return &spawns[i];
+	return NULL;
+}
+
+/**
+ * @brief Writes a level file.
+ */
+bool Level::write(const std::string& filename, const LevelData& data)
+{
+	if (data.cells.size() != (size_t)data.width * data.height)
+		return false;
+
+	for (size_t i = 0; i < data.collectibles.size(); i++)
+		if (data.collectibles[i].type >= data.types.size())
+			return false;
+	for (size_t i = 0; i < data.spawns.size(); i++)
+		if (data.spawns[i].type >= data.types.size())
+			return false;
+
+	LevelHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC));
+	header.version = VERSION;
+	header.sectionCount = SECTION_COUNT;
+	header.mazeWidth = data.width;
+	header.mazeHeight = data.height;
+
+	const void* contents[SECTION_COUNT] = { data.cells.empty() ? NULL : &data.cells[0],
+											data.types.empty() ? NULL : &data.types[0],
+											data.collectibles.empty() ? NULL : &data.collectibles[0],
+											data.spawns.empty() ? NULL : &data.spawns[0] };
+
+	LevelSectionEntry sections[SECTION_COUNT];
+	memset(sections, 0, sizeof(sections));
+	sections[0].id = (uint32_t)LEVEL_SECTION::MAZE;
+	sections[0].stride = 1;
+	sections[0].count = data.cells.size();
+	sections[1].id = (uint32_t)LEVEL_SECTION::OBJECT_TYPES;
+	sections[1].stride = sizeof(LevelObjectType);
+	sections[1].count = data.types.size();
+	sections[2].id = (uint32_t)LEVEL_SECTION::COLLECTIBLES;
+	sections[2].stride = sizeof(LevelCollectible);
+	sections[2].count = data.collectibles.size();
+	sections[3].id = (uint32_t)LEVEL_SECTION::SPAWNS;
+	sections[3].stride = sizeof(LevelSpawn);
+	sections[3].count = data.spawns.size();
+
+	uint64_t offset = sizeof(header) + sizeof(sections);
+	for (uint32_t i = 0; i < SECTION_COUNT; i++)
+	{
+		sections[i].offset = align(offset);
+		offset = sections[i].offset + sections[i].count * sections[i].stride;
+	}
+
+	FILE* file = fopen(filename.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(sections, sizeof(sections), 1, file) == 1;
+	uint64_t position = sizeof(header) + sizeof(sections);
+	for (uint32_t i = 0; written && i < SECTION_COUNT; i++)
+		written = writeSection(file, position, sections[i].offset, contents[i], (size_t)(sections[i].count * sections[i].stride));
+
+	fclose(file);
+	return written;
+}
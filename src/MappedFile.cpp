@@ -0,0 +1,116 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Contains the implementation of the MappedFile class.
+ */
+
+#if defined(_WIN32)
+#include <windows.h> // CreateFileMapping, MapViewOfFile
+#else
+#include <fcntl.h>	  // open
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>	  // close
+#endif
+
+#include <./include/MappedFile.h>
+
+using namespace gpp; // GPP namespace
+
+MappedFile::MappedFile()
+	: data(NULL), size(0)
+#if defined(_WIN32)
+	, file(NULL), mapping(NULL)
+#endif
+{
+}
+
+/**
+ * @brief Destructor for the MappedFile class, unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/**
+ * @brief Maps a file, closing any file mapped before.
+ */
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+
+#if defined(_WIN32)
+	HANDLE handle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER length;
+	HANDLE view = NULL;
+	if (GetFileSizeEx(handle, &length) && length.QuadPart > 0)
+		view = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if (view == NULL)
+	{
+		CloseHandle(handle);
+		return false;
+	}
+
+	file = handle;
+	mapping = view;
+	data = (const unsigned char*)MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+	size = (size_t)length.QuadPart;
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	void* address = MAP_FAILED;
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+		address = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps the file alive
+	::close(fd);
+
+	if (address == MAP_FAILED)
+		return false;
+
+	data = (const unsigned char*)address;
+	size = (size_t)info.st_size;
+#endif
+
+	if (data == NULL)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Unmaps the file, pointers into it become invalid.
+ */
+void MappedFile::close()
+{
+#if defined(_WIN32)
+	if (data != NULL)
+		UnmapViewOfFile(data);
+	if (mapping != NULL)
+		CloseHandle((HANDLE)mapping);
+	if (file != NULL)
+		CloseHandle((HANDLE)file);
+	mapping = NULL;
+	file = NULL;
+#else
+	if (data != NULL)
+		munmap((void*)data, size);
+#endif
+	data = NULL;
+	size = 0;
+}
+
+bool MappedFile::isOpen() const { return data != NULL; }
+
+const unsigned char* MappedFile::getData() const { return data; }
+
+size_t MappedFile::getSize() const { return size; }
@@ -0,0 +1,256 @@
+/**
+ * @file MatrixBatch.cpp
+ * @brief Contains the implementation of the MatrixBatch class.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // SSE4, AVX2 and FMA intrinsics, enabled per function
+#define MATRIX_SIMD 1
+#endif
+
+#include <./include/MatrixBatch.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	// Transforms count vec4 (packed floats) by a column major matrix
+	typedef void (*TransformFunction)(const float* m, const float* v, float* out, size_t count);
+
+	// Multiplies count pairs of column major matrices
+	typedef void (*MultiplyFunction)(const float* a, const float* b, float* out, size_t count);
+
+	void transformScalar(const float* m, const float* v, float* out, size_t count)
+	{
+		const glm::mat4& matrix = *reinterpret_cast<const glm::mat4*>(m);
+		const glm::vec4* vectors = reinterpret_cast<const glm::vec4*>(v);
+		glm::vec4* results = reinterpret_cast<glm::vec4*>(out);
+
+		for (size_t i = 0; i < count; i++)
+			results[i] = matrix * vectors[i];
+	}
+
+	void multiplyScalar(const float* a, const float* b, float* out, size_t count)
+	{
+		const glm::mat4* left = reinterpret_cast<const glm::mat4*>(a);
+		const glm::mat4* right = reinterpret_cast<const glm::mat4*>(b);
+		glm::mat4* results = reinterpret_cast<glm::mat4*>(out);
+
+		for (size_t i = 0; i < count; i++)
+			results[i] = left[i] * right[i];
+	}
+
+#if defined(MATRIX_SIMD)
+	// A column (or vector) times the matrix is the matrix columns weighted by its four components
+
+	__attribute__((target("sse4.1"))) void transformSse4(const float* m, const float* v, float* out, size_t count)
+	{
+		const __m128 c0 = _mm_loadu_ps(m);
+		const __m128 c1 = _mm_loadu_ps(m + 4);
+		const __m128 c2 = _mm_loadu_ps(m + 8);
+		const __m128 c3 = _mm_loadu_ps(m + 12);
+
+		for (size_t i = 0; i < count; i++, v += 4, out += 4)
+		{
+			const __m128 x = _mm_loadu_ps(v);
+			__m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(x, x, 0x00));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(x, x, 0x55)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(x, x, 0xAA)));
+			r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(x, x, 0xFF)));
+			_mm_storeu_ps(out, r);
+		}
+	}
+
+	__attribute__((target("sse4.1"))) void multiplySse4(const float* a, const float* b, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++, a += 16, b += 16, out += 16)
+			transformSse4(a, b, out, 4);
+	}
+
+	// The AVX kernels work on two vectors at once, one per 128-bit lane, with the matrix columns
+	// repeated in both lanes; permutes broadcast a component within its own lane
+
+	__attribute__((target("avx2"))) void transformAvx2(const float* m, const float* v, float* out, size_t count)
+	{
+		const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+		const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+		const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+		const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2, v += 8, out += 8)
+		{
+			const __m256 x = _mm256_loadu_ps(v);
+			__m256 r = _mm256_mul_ps(c0, _mm256_permute_ps(x, 0x00));
+			r = _mm256_add_ps(r, _mm256_mul_ps(c1, _mm256_permute_ps(x, 0x55)));
+			r = _mm256_add_ps(r, _mm256_mul_ps(c2, _mm256_permute_ps(x, 0xAA)));
+			r = _mm256_add_ps(r, _mm256_mul_ps(c3, _mm256_permute_ps(x, 0xFF)));
+			_mm256_storeu_ps(out, r);
+		}
+		if (i < count)
+			transformSse4(m, v, out, count - i);
+	}
+
+	__attribute__((target("avx2"))) void multiplyAvx2(const float* a, const float* b, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++, a += 16, b += 16, out += 16)
+			transformAvx2(a, b, out, 4);
+	}
+
+	__attribute__((target("avx2,fma"))) void transformFma(const float* m, const float* v, float* out, size_t count)
+	{
+		const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+		const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+		const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+		const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2, v += 8, out += 8)
+		{
+			const __m256 x = _mm256_loadu_ps(v);
+			__m256 r = _mm256_mul_ps(c0, _mm256_permute_ps(x, 0x00));
+			r = _mm256_fmadd_ps(c1, _mm256_permute_ps(x, 0x55), r);
+			r = _mm256_fmadd_ps(c2, _mm256_permute_ps(x, 0xAA), r);
+			r = _mm256_fmadd_ps(c3, _mm256_permute_ps(x, 0xFF), r);
+			_mm256_storeu_ps(out, r);
+		}
+		if (i < count)
+			transformSse4(m, v, out, count - i);
+	}
+
+	__attribute__((target("avx2,fma"))) void multiplyFma(const float* a, const float* b, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++, a += 16, b += 16, out += 16)
+			transformFma(a, b, out, 4);
+	}
+#endif
+
+	/**
+	 * @brief Kernels for one instruction set.
+	 */
+	struct Kernels
+	{
+		TransformFunction transform;
+		MultiplyFunction multiply;
+		const char* name;
+	};
+
+	const Kernels table[] = {
+		{ transformScalar, multiplyScalar, "scalar" },
+#if defined(MATRIX_SIMD)
+		{ transformSse4, multiplySse4, "SSE4" },
+		{ transformAvx2, multiplyAvx2, "AVX2" },
+		{ transformFma, multiplyFma, "AVX2+FMA" },
+#else
+		{ transformScalar, multiplyScalar, "SSE4" },
+		{ transformScalar, multiplyScalar, "AVX2" },
+		{ transformScalar, multiplyScalar, "AVX2+FMA" },
+#endif
+	};
+
+	bool isSupported(MATRIX_KERNEL kernel)
+	{
+#if defined(MATRIX_SIMD)
+		__builtin_cpu_init();
+		switch (kernel)
+		{
+		case MATRIX_KERNEL::AVX2_FMA:
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+		case MATRIX_KERNEL::AVX2:
+			return __builtin_cpu_supports("avx2");
+		case MATRIX_KERNEL::SSE4:
+			return __builtin_cpu_supports("sse4.1");
+		default:
+			return true;
+		}
+#else
+		return kernel == MATRIX_KERNEL::SCALAR;
+#endif
+	}
+
+	MATRIX_KERNEL bestKernel()
+	{
+		if (isSupported(MATRIX_KERNEL::AVX2_FMA))
+			return MATRIX_KERNEL::AVX2_FMA;
+		if (isSupported(MATRIX_KERNEL::AVX2))
+			return MATRIX_KERNEL::AVX2;
+		if (isSupported(MATRIX_KERNEL::SSE4))
+			return MATRIX_KERNEL::SSE4;
+		return MATRIX_KERNEL::SCALAR;
+	}
+
+	// Kernels in use, chosen on first use
+	const Kernels*& kernels()
+	{
+		static const Kernels* selected = &table[(int)bestKernel()];
+		return selected;
+	}
+}
+
+/**
+ * @brief Multiplies one matrix by an array of matrices.
+ *
+ * Each column of b[i] is transformed by a, so the whole array goes through the vector kernel with a's
+ * columns loaded once.
+ */
+void MatrixBatch::multiply(const glm::mat4& a, const glm::mat4* b, glm::mat4* out, size_t count)
+{
+	if (count > 0)
+		kernels()->transform(&a[0][0], &b[0][0][0], &out[0][0][0], count * 4);
+}
+
+/**
+ * @brief Multiplies, in place, matrices spread through an array of structures.
+ *
+ * The matrices are not contiguous, so each goes through the vector kernel on its own, four columns at once.
+ */
+void MatrixBatch::multiply(const glm::mat4& a, glm::mat4* first, size_t stride, size_t count)
+{
+	const TransformFunction transform = kernels()->transform;
+	unsigned char* matrix = reinterpret_cast<unsigned char*>(first);
+	for (size_t i = 0; i < count; i++, matrix += stride)
+	{
+		float* columns = reinterpret_cast<float*>(matrix);
+		transform(&a[0][0], columns, columns, 4);
+	}
+}
+
+/**
+ * @brief Multiplies two arrays of matrices pairwise.
+ */
+void MatrixBatch::multiply(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+{
+	if (count > 0)
+		kernels()->multiply(&a[0][0][0], &b[0][0][0], &out[0][0][0], count);
+}
+
+/**
+ * @brief Transforms an array of vectors by one matrix.
+ */
+void MatrixBatch::transform(const glm::mat4& m, const glm::vec4* v, glm::vec4* out, size_t count)
+{
+	if (count > 0)
+		kernels()->transform(&m[0][0], &v[0][0], &out[0][0], count);
+}
+
+MATRIX_KERNEL MatrixBatch::getBestKernel()
+{
+	static const MATRIX_KERNEL best = bestKernel();
+	return best;
+}
+
+/**
+ * @brief Selects the kernel used from now on.
+ */
+bool MatrixBatch::setKernel(MATRIX_KERNEL kernel)
+{
+	if (!isSupported(kernel))
+		return false;
+
+	kernels() = &table[(int)kernel];
+	return true;
+}
+
+const char* MatrixBatch::getKernelName(MATRIX_KERNEL kernel) { return table[(int)kernel].name; }
+
+const char* MatrixBatch::getKernelName() { return kernels()->name; }
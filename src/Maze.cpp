@@ -1,10 +1,32 @@
 #include <./include/Maze.h>
 
+Maze::Maze()
+{
+}
+
 Maze::Maze(int width, int height)
 {
 	generateMaze(width, height);
 }
 
+void Maze::generate(int width, int height)
+{
+	mazeGrid.clear();
+	generateMaze(width, height);
+}
+
+void Maze::load(const unsigned char* cells, int width, int height)
+{
+    mazeGrid.assign(width, std::vector<int>(height, 0));
+    for (int x = 0; x < width; ++x)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            mazeGrid[x][y] = cells[x * height + y];
+        }
+    }
+}
+
 void Maze::generateMaze(int width, int height)
 {
     mazeGrid.resize(width, std::vector<int>(height, 0));
@@ -0,0 +1,173 @@
+/**
+ * @file Mesh.cpp
+ * @brief Contains the implementation of the Mesh class.
+ */
+
+#include <string.h> // For memset
+#include <iostream> // For debug output
+
+#include <glm/gtc/matrix_transform.hpp> // Matrix transformations
+
+#include <./include/Mesh.h>
+#include <./include/MappedFile.h>
+#include <./include/Debug.h>
+
+using namespace gpp; // GPP namespace
+
+Mesh::Mesh() : vbo(0), ibo(0)
+{
+	memset(&header, 0, sizeof(header));
+}
+
+/**
+ * @brief Destructor for the Mesh class, releases the buffers.
+ */
+Mesh::~Mesh()
+{
+	release();
+}
+
+void Mesh::release()
+{
+	if (vbo != 0)
+		glDeleteBuffers(1, &vbo);
+	if (ibo != 0)
+		glDeleteBuffers(1, &ibo);
+
+	vbo = 0;
+	ibo = 0;
+}
+
+/**
+ * @brief Loads a mesh file into GPU buffers.
+ *
+ * The streams are copied by the driver straight out of the mapping, which is released once they are.
+ */
+bool Mesh::load(const std::string& filename, const AssetPack* pack)
+{
+	release();
+
+	MappedFile file;
+	AssetView view;
+	const unsigned char* data = NULL;
+	size_t size = 0;
+
+	if (pack != NULL && pack->find(filename, view))
+	{
+		data = view.data;
+		size = view.size;
+	}
+	else if (file.open(filename))
+	{
+		data = file.getData();
+		size = file.getSize();
+	}
+
+	if (!upload(data, size))
+	{
+		DEBUG_MSG("ERROR: Mesh not loaded " + filename);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Quantizes a mesh built in code and loads it into GPU buffers.
+ */
+bool Mesh::create(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, uint32_t attributes)
+{
+	release();
+
+	std::vector<unsigned char> data;
+	return MeshFile::encode(vertices, indices, attributes, data) && upload(&data[0], data.size());
+}
+
+/**
+ * @brief Validates mesh file contents and copies their streams into new buffers.
+ */
+bool Mesh::upload(const unsigned char* data, size_t size)
+{
+	if (!MeshFile::validate(data, size, header))
+	{
+		memset(&header, 0, sizeof(header));
+		return false;
+	}
+
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)header.vertexStride * header.vertexCount, data + header.vertexOffset, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenBuffers(1, &ibo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)header.indexSize * header.indexCount, data + header.indexOffset, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	return true;
+}
+
+/**
+ * @brief Points an attribute location at one stream of the bound vertex buffer.
+ */
+void Mesh::enable(GLint location, MESH_ATTRIBUTE attribute, GLint size, GLenum type) const
+{
+	const int offset = MeshFile::getOffset(header.attributes, attribute);
+	if (location < 0 || offset < 0)
+		return;
+
+	glEnableVertexAttribArray(location);
+	glVertexAttribPointer(location, size, type, type == GL_HALF_FLOAT ? GL_FALSE : GL_TRUE, header.vertexStride,
+						  (const void*)(size_t)offset);
+}
+
+/**
+ * @brief Draws the mesh with the given attribute locations.
+ */
+void Mesh::draw(GLint positionID, GLint normalID, GLint uvID, GLint colourID) const
+{
+	if (vbo == 0)
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+	enable(positionID, MESH_ATTRIBUTE::POSITION, 3, GL_SHORT);
+	enable(normalID, MESH_ATTRIBUTE::NORMAL, 3, GL_BYTE);
+	enable(uvID, MESH_ATTRIBUTE::UV, 2, GL_HALF_FLOAT);
+	enable(colourID, MESH_ATTRIBUTE::COLOUR, 4, GL_UNSIGNED_BYTE);
+
+	glDrawElements(GL_TRIANGLES, header.indexCount, header.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)0);
+
+	const GLint locations[] = { positionID, normalID, uvID, colourID };
+	for (int i = 0; i < 4; i++)
+		if (locations[i] >= 0)
+			glDisableVertexAttribArray(locations[i]);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * @brief Getter method for the matrix mapping quantized positions to model space.
+ */
+glm::mat4 Mesh::getDequantizeMatrix() const
+{
+	const glm::vec3 centre = (getBoundsMin() + getBoundsMax()) * 0.5f;
+	glm::vec3 extent = (getBoundsMax() - getBoundsMin()) * 0.5f;
+	for (int c = 0; c < 3; c++)
+		extent[c] = extent[c] > 0.0f ? extent[c] : 1.0f; // As written by MeshFile::write()
+
+	return glm::scale(glm::translate(glm::mat4(1.0f), centre), extent);
+}
+
+bool Mesh::isLoaded() const { return vbo != 0; }
+
+bool Mesh::hasAttribute(MESH_ATTRIBUTE attribute) const { return (header.attributes & (uint32_t)attribute) != 0; }
+
+glm::vec3 Mesh::getBoundsMin() const { return glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]); }
+
+glm::vec3 Mesh::getBoundsMax() const { return glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]); }
+
+unsigned Mesh::getVertexCount() const { return header.vertexCount; }
+
+unsigned Mesh::getIndexCount() const { return header.indexCount; }
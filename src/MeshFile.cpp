@@ -0,0 +1,239 @@
+/**
+ * @file MeshFile.cpp
+ * @brief Contains the implementation of the MeshFile class.
+ */
+
+#include <math.h>	// For floor
+#include <stdio.h>	// For writing mesh files
+#include <string.h> // For memcpy, memcmp
+
+#include <./include/MeshFile.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const char MESH_MAGIC[4] = { 'G', 'M', 'S', 'H' };
+	const uint64_t STREAM_ALIGNMENT = 16;
+
+	uint64_t align(uint64_t offset) { return (offset + STREAM_ALIGNMENT - 1) & ~(STREAM_ALIGNMENT - 1); }
+
+	bool has(uint32_t attributes, MESH_ATTRIBUTE attribute) { return (attributes & (uint32_t)attribute) != 0; }
+
+	int quantize(float value, float scale)
+	{
+		value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+		return (int)floor(value * scale + 0.5f);
+	}
+}
+
+/**
+ * @brief Getter method for the bytes per vertex of a set of streams.
+ */
+uint32_t MeshFile::getStride(uint32_t attributes)
+{
+	return 8 + (has(attributes, MESH_ATTRIBUTE::NORMAL) ? 4 : 0) + (has(attributes, MESH_ATTRIBUTE::UV) ? 4 : 0) +
+		   (has(attributes, MESH_ATTRIBUTE::COLOUR) ? 4 : 0);
+}
+
+/**
+ * @brief Getter method for the offset of a stream within a vertex.
+ */
+int MeshFile::getOffset(uint32_t attributes, MESH_ATTRIBUTE attribute)
+{
+	if (!has(attributes | (uint32_t)MESH_ATTRIBUTE::POSITION, attribute))
+		return -1;
+
+	// Streams are interleaved in bit order, only those before this one count
+	return (int)getStride(attributes & ((uint32_t)attribute - 1)) - (attribute == MESH_ATTRIBUTE::POSITION ? 8 : 0);
+}
+
+/**
+ * @brief Converts a float to IEEE half precision, rounding to nearest even.
+ */
+uint16_t MeshFile::toHalf(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	const uint32_t sign = (bits >> 16) & 0x8000u;
+	const uint32_t biased = (bits >> 23) & 0xFFu;
+	uint32_t mantissa = bits & 0x7FFFFFu;
+	const int exponent = (int)biased - 127 + 15;
+
+	if (biased == 0xFFu)
+		return (uint16_t)(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u)); // Infinity or NaN
+	if (exponent >= 31)
+		return (uint16_t)(sign | 0x7C00u); // Too large, infinity
+
+	if (exponent <= 0)
+	{
+		// Subnormal half, or zero when too small
+		if (exponent < -10)
+			return (uint16_t)sign;
+
+		mantissa |= 0x800000u;
+		const int shift = 14 - exponent;
+		uint32_t half = mantissa >> shift;
+		const uint32_t rest = mantissa & ((1u << shift) - 1u);
+		const uint32_t halfway = 1u << (shift - 1);
+		if (rest > halfway || (rest == halfway && (half & 1u)))
+			half++;
+		return (uint16_t)(sign | half);
+	}
+
+	// A carry out of the mantissa correctly bumps the exponent
+	uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+	const uint32_t rest = mantissa & 0x1FFFu;
+	if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+		half++;
+	return (uint16_t)(sign | half);
+}
+
+/**
+ * @brief Quantizes and writes a mesh.
+ */
+bool MeshFile::write(const std::string& filename, const std::vector<MeshVertex>& vertices,
+					 const std::vector<uint32_t>& indices, uint32_t attributes)
+{
+	std::vector<unsigned char> data;
+	if (!encode(vertices, indices, attributes, data))
+		return false;
+
+	FILE* file = fopen(filename.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	bool written = fwrite(&data[0], 1, data.size(), file) == data.size();
+	fclose(file);
+	return written;
+}
+
+/**
+ * @brief Quantizes a mesh into the file layout, in memory.
+ */
+bool MeshFile::encode(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, uint32_t attributes,
+					  std::vector<unsigned char>& data)
+{
+	attributes |= (uint32_t)MESH_ATTRIBUTE::POSITION;
+
+	if (vertices.empty() || indices.empty() || indices.size() % 3 != 0)
+		return false;
+
+	for (size_t i = 0; i < indices.size(); i++)
+		if (indices[i] >= vertices.size())
+			return false;
+
+	glm::vec3 boundsMin = vertices[0].position;
+	glm::vec3 boundsMax = vertices[0].position;
+	for (size_t i = 1; i < vertices.size(); i++)
+	{
+		boundsMin = glm::min(boundsMin, vertices[i].position);
+		boundsMax = glm::max(boundsMax, vertices[i].position);
+	}
+
+	// Flat axes quantize to the centre
+	const glm::vec3 centre = (boundsMin + boundsMax) * 0.5f;
+	glm::vec3 extent = (boundsMax - boundsMin) * 0.5f;
+	for (int c = 0; c < 3; c++)
+		extent[c] = extent[c] > 0.0f ? extent[c] : 1.0f;
+
+	MeshHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MESH_MAGIC, sizeof(MESH_MAGIC));
+	header.version = VERSION;
+	header.attributes = attributes;
+	header.vertexStride = getStride(attributes);
+	header.vertexCount = (uint32_t)vertices.size();
+	header.indexCount = (uint32_t)indices.size();
+	header.indexSize = vertices.size() <= 65536 ? 2 : 4;
+	for (int c = 0; c < 3; c++)
+	{
+		header.boundsMin[c] = boundsMin[c];
+		header.boundsMax[c] = boundsMax[c];
+	}
+	header.vertexOffset = align(sizeof(header));
+	header.indexOffset = align(header.vertexOffset + (uint64_t)header.vertexStride * header.vertexCount);
+
+	// Padding between the streams stays zero
+	data.assign((size_t)(header.indexOffset + (uint64_t)header.indexSize * header.indexCount), 0);
+	memcpy(&data[0], &header, sizeof(header));
+
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const MeshVertex& vertex = vertices[i];
+		unsigned char* out = &data[(size_t)header.vertexOffset + i * header.vertexStride];
+
+		const glm::vec3 position = (vertex.position - centre) / extent;
+		int16_t quantized[4] = { (int16_t)quantize(position.x, 32767.0f), (int16_t)quantize(position.y, 32767.0f),
+								 (int16_t)quantize(position.z, 32767.0f), 0 };
+		memcpy(out, quantized, sizeof(quantized));
+		out += sizeof(quantized);
+
+		if (has(attributes, MESH_ATTRIBUTE::NORMAL))
+		{
+			const float length = glm::length(vertex.normal);
+			const glm::vec3 normal = length > 0.0f ? vertex.normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+			int8_t packed[4] = { (int8_t)quantize(normal.x, 127.0f), (int8_t)quantize(normal.y, 127.0f),
+								 (int8_t)quantize(normal.z, 127.0f), 0 };
+			memcpy(out, packed, sizeof(packed));
+			out += sizeof(packed);
+		}
+
+		if (has(attributes, MESH_ATTRIBUTE::UV))
+		{
+			uint16_t packed[2] = { toHalf(vertex.uv.x), toHalf(vertex.uv.y) };
+			memcpy(out, packed, sizeof(packed));
+			out += sizeof(packed);
+		}
+
+		if (has(attributes, MESH_ATTRIBUTE::COLOUR))
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				float channel = vertex.colour[c] < 0.0f ? 0.0f : (vertex.colour[c] > 1.0f ? 1.0f : vertex.colour[c]);
+				out[c] = (unsigned char)(channel * 255.0f + 0.5f);
+			}
+		}
+	}
+
+	unsigned char* indexData = &data[(size_t)header.indexOffset];
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if (header.indexSize == 2)
+		{
+			uint16_t index = (uint16_t)indices[i];
+			memcpy(&indexData[i * 2], &index, sizeof(index));
+		}
+		else
+		{
+			memcpy(&indexData[i * 4], &indices[i], sizeof(uint32_t));
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Checks a mapped mesh file.
+ */
+bool MeshFile::validate(const unsigned char* data, size_t size, MeshHeader& header)
+{
+	if (data == NULL || size < sizeof(header))
+		return false;
+
+	memcpy(&header, data, sizeof(header));
+
+	if (memcmp(header.magic, MESH_MAGIC, sizeof(MESH_MAGIC)) != 0 || header.version != VERSION ||
+		!has(header.attributes, MESH_ATTRIBUTE::POSITION) || header.attributes > 15 ||
+		header.vertexStride != getStride(header.attributes) ||
+		header.vertexCount == 0 || header.indexCount == 0 || header.indexCount % 3 != 0 ||
+		(header.indexSize != 2 && header.indexSize != 4) ||
+		header.vertexOffset % STREAM_ALIGNMENT != 0 || header.indexOffset % STREAM_ALIGNMENT != 0)
+		return false;
+
+	const uint64_t vertexEnd = header.vertexOffset + (uint64_t)header.vertexStride * header.vertexCount;
+	const uint64_t indexEnd = header.indexOffset + (uint64_t)header.indexSize * header.indexCount;
+
+	return header.vertexOffset >= sizeof(header) && vertexEnd <= header.indexOffset && indexEnd <= size;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file MeshLibrary.cpp
+ * @brief Contains the implementation of the MeshLibrary class.
+ */
+
+#include <./include/MeshLibrary.h>
+
+using namespace gpp; // GPP namespace
+
+MeshLibrary::MeshLibrary()
+{
+}
+
+/**
+ * @brief Getter method for a mesh file, loaded on first use.
+ */
+MeshRef MeshLibrary::load(const std::string& filename, const AssetPack* pack)
+{
+	MeshRef mesh = find(filename);
+	if (mesh)
+		return mesh;
+
+	std::shared_ptr<Mesh> loaded(new Mesh());
+	if (!loaded->load(filename, pack))
+		return MeshRef();
+
+	meshes[filename] = loaded;
+	return loaded;
+}
+
+/**
+ * @brief Getter method for a mesh built in code, created on first use.
+ */
+MeshRef MeshLibrary::create(const std::string& name, const std::vector<MeshVertex>& vertices,
+							const std::vector<uint32_t>& indices, uint32_t attributes)
+{
+	MeshRef mesh = find(name);
+	if (mesh)
+		return mesh;
+
+	std::shared_ptr<Mesh> created(new Mesh());
+	if (!created->create(vertices, indices, attributes))
+		return MeshRef();
+
+	meshes[name] = created;
+	return created;
+}
+
+/**
+ * @brief Getter method for a mesh already in use.
+ */
+MeshRef MeshLibrary::find(const std::string& name) const
+{
+	std::map<std::string, std::weak_ptr<const Mesh> >::const_iterator found = meshes.find(name);
+	return found != meshes.end() ? found->second.lock() : MeshRef();
+}
+
+/**
+ * @brief Getter method for the number of meshes in use, forgetting released ones.
+ */
+size_t MeshLibrary::getMeshCount()
+{
+	for (std::map<std::string, std::weak_ptr<const Mesh> >::iterator i = meshes.begin(); i != meshes.end();)
+	{
+		if (i->second.expired())
+			meshes.erase(i++);
+		else
+			++i;
+	}
+	return meshes.size();
+}
@@ -0,0 +1,162 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Contains the implementation of the RenderQueue class.
+ */
+
+#include <./include/RenderQueue.h>
+
+using namespace gpp; // GPP namespace
+
+/**
+ * @brief Builds a sort key from render state and quantized depth.
+ */
+uint64_t RenderQueue::makeKey(PASS pass, GLuint program, GLuint texture, MESH mesh, uint32_t depth)
+{
+	return ((uint64_t)pass << PASS_SHIFT) |
+		   ((uint64_t)(program & 0xFF) << PROGRAM_SHIFT) |
+		   ((uint64_t)(texture & 0xFFF) << TEXTURE_SHIFT) |
+		   ((uint64_t)((uint16_t)mesh & 0xFFF) << MESH_SHIFT) |
+		   ((uint64_t)(depth & DEPTH_MAX) << DEPTH_SHIFT);
+}
+
+/**
+ * @brief Quantizes a view space distance into the 24-bit depth field.
+ */
+uint32_t RenderQueue::quantizeDepth(PASS pass, float distance, float zNear, float zFar)
+{
+	float t = (distance - zNear) / (zFar - zNear);
+
+	if (t < 0.0f)
+		t = 0.0f;
+	if (t > 1.0f)
+		t = 1.0f;
+
+	uint32_t depth = (uint32_t)(t * (float)DEPTH_MAX);
+
+	// Blended geometry is drawn furthest first
+	if (pass == PASS::TRANSLUCENT)
+		depth = DEPTH_MAX - depth;
+
+	return depth;
+}
+
+RenderQueue::RenderQueue()
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+/**
+ * @brief Removes all packets, keeping the allocated storage for the next frame.
+ */
+void RenderQueue::clear()
+{
+	packets.clear();
+
+	for (size_t i = 0; i < buffers.size(); i++)
+		buffers[i].packets.clear();
+}
+
+/**
+ * @brief Adds a packet to the queue.
+ */
+void RenderQueue::submit(const DrawPacket& packet)
+{
+	packets.push_back(packet);
+}
+
+/**
+ * @brief Sets the number of per-worker command buffers.
+ */
+void RenderQueue::setBufferCount(unsigned count)
+{
+	buffers.resize(count);
+}
+
+/**
+ * @brief Getter method for a worker's command buffer.
+ */
+CommandBuffer& RenderQueue::getBuffer(unsigned worker) { return buffers[worker]; }
+
+/**
+ * @brief Appends every command buffer to the queue and empties the buffers.
+ *
+ * Buffers keep their capacity so recording does not allocate once the scene has been seen.
+ */
+void RenderQueue::merge()
+{
+	size_t total = packets.size();
+	for (size_t i = 0; i < buffers.size(); i++)
+		total += buffers[i].packets.size();
+
+	packets.reserve(total);
+
+	for (size_t i = 0; i < buffers.size(); i++)
+	{
+		packets.insert(packets.end(), buffers[i].packets.begin(), buffers[i].packets.end());
+		buffers[i].packets.clear();
+	}
+}
+
+/**
+ * @brief Sorts the packets by key with an LSD radix sort (8 bits per pass).
+ *
+ * Only the keys and packet indices move; the packets themselves stay where they were submitted.
+ */
+void RenderQueue::sort()
+{
+	const size_t count = packets.size();
+
+	keys.resize(count);
+	order.resize(count);
+	keysTemp.resize(count);
+	orderTemp.resize(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		keys[i] = packets[i].key;
+		order[i] = (uint32_t)i;
+	}
+
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		size_t histogram[256] = { 0 };
+
+		for (size_t i = 0; i < count; i++)
+			histogram[(keys[i] >> shift) & 0xFF]++;
+
+		// All keys share this byte, the pass would not change the order
+		if (count == 0 || histogram[(keys[0] >> shift) & 0xFF] == count)
+			continue;
+
+		size_t offset = 0;
+		for (int b = 0; b < 256; b++)
+		{
+			size_t n = histogram[b];
+			histogram[b] = offset;
+			offset += n;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			size_t slot = histogram[(keys[i] >> shift) & 0xFF]++;
+			keysTemp[slot] = keys[i];
+			orderTemp[slot] = order[i];
+		}
+
+		keys.swap(keysTemp);
+		order.swap(orderTemp);
+	}
+}
+
+/**
+ * @brief Getter method for the number of packets in the queue.
+ */
+size_t RenderQueue::size() const { return packets.size(); }
+
+/**
+ * @brief Access a packet in sorted order (valid after sort()).
+ */
+const DrawPacket& RenderQueue::operator[](size_t i) const { return packets[order[i]]; }
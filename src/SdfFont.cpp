@@ -0,0 +1,422 @@
+/**
+ * @file SdfFont.cpp
+ * @brief Contains the implementation of the SdfFont class.
+ */
+
+#include <math.h>	// For sqrt
+#include <stdio.h>	// For cache files
+#include <string.h> // For memcpy, memcmp
+#include <iostream> // For debug output
+
+#include <SFML/Graphics.hpp> // Glyph rasterisation, only used when baking
+
+#include <./include/SdfFont.h>
+#include <./include/Debug.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const char CACHE_MAGIC[4] = { 'G', 'S', 'D', 'F' };
+	const uint32_t CACHE_VERSION = 1;
+	const int ATLAS_WIDTH = 512;
+	const int GLYPH_GAP = 1; // Keeps bilinear filtering from bleeding between glyphs
+	const unsigned GLYPH_COUNT = SdfFont::LAST_GLYPH - SdfFont::FIRST_GLYPH + 1;
+
+	/**
+	 * @struct CacheHeader
+	 * @brief Header of a cached atlas, followed by the glyphs, the kerning pairs and the pixels.
+	 */
+	struct CacheHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t stamp; // Font stamp combined with the bake settings
+		int32_t baseSize;
+		int32_t spread;
+		int32_t width;
+		int32_t height;
+		int32_t glyphCount;
+		int32_t kerningCount;
+		float lineSpacing;
+		int32_t reserved;
+	};
+
+	struct KerningPair
+	{
+		uint16_t first, second; // Offsets from FIRST_GLYPH
+		float amount;
+	};
+
+	/**
+	 * @brief Computes the distance field of one glyph by searching the coverage for the nearest opposite texel.
+	 *
+	 * @param coverage Glyph coverage, 4 bytes per texel, alpha is used.
+	 * @param stride Texels per row of coverage.
+	 * @param glyphWidth Glyph width in texels.
+	 * @param glyphHeight Glyph height in texels.
+	 * @param spread Padding around the glyph and largest distance encoded.
+	 * @param out Destination, (glyphWidth + 2 * spread) by (glyphHeight + 2 * spread) texels.
+	 * @param outStride Texels per row of out.
+	 */
+	void computeDistanceField(const unsigned char* coverage, int stride, int glyphWidth, int glyphHeight, int spread,
+							  unsigned char* out, int outStride)
+	{
+		const int fieldWidth = glyphWidth + 2 * spread;
+		const int fieldHeight = glyphHeight + 2 * spread;
+
+		for (int y = 0; y < fieldHeight; y++)
+		{
+			for (int x = 0; x < fieldWidth; x++)
+			{
+				const int sx = x - spread, sy = y - spread;
+				const bool inside = sx >= 0 && sy >= 0 && sx < glyphWidth && sy < glyphHeight &&
+									coverage[((size_t)sy * stride + sx) * 4 + 3] >= 128;
+
+				int nearest = (spread + 1) * (spread + 1);
+				for (int dy = -spread; dy <= spread; dy++)
+				{
+					const int ty = sy + dy;
+					for (int dx = -spread; dx <= spread; dx++)
+					{
+						const int distance = dx * dx + dy * dy;
+						if (distance >= nearest)
+							continue;
+
+						const int tx = sx + dx;
+						const bool other = tx >= 0 && ty >= 0 && tx < glyphWidth && ty < glyphHeight &&
+										   coverage[((size_t)ty * stride + tx) * 4 + 3] >= 128;
+						if (other != inside)
+							nearest = distance;
+					}
+				}
+
+				// The outline lies half way between a texel and its nearest opposite
+				float distance = (float)sqrt((double)nearest) - 0.5f;
+				float value = 128.0f + (inside ? distance : -distance) * 127.0f / (float)spread;
+				value = value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value);
+				out[(size_t)y * outStride + x] = (unsigned char)(value + 0.5f);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Constructor for the SdfFont class.
+ */
+SdfFont::SdfFont(unsigned baseSize, unsigned spread)
+	: baseSize(baseSize), spread(spread), lineSpacing(0.0f), width(0), height(0), texture(0)
+{
+}
+
+/**
+ * @brief Destructor for the SdfFont class, releases the atlas texture.
+ */
+SdfFont::~SdfFont()
+{
+	if (texture != 0)
+		glDeleteTextures(1, &texture);
+}
+
+/**
+ * @brief Reads the cached atlas or bakes it from the font, then uploads it.
+ */
+bool SdfFont::load(const std::string& filename, const AssetPack* pack)
+{
+	if (!prepare(filename, pack))
+		return false;
+
+	upload();
+	return true;
+}
+
+/**
+ * @brief Reads the cached atlas or bakes it from the font, without touching the GL context.
+ *
+ * Sources are tried in order: the cache in the asset pack, the cache on disk, then baking (which
+ * writes the cache on disk for the next run).
+ */
+bool SdfFont::prepare(const std::string& filename, const AssetPack* pack)
+{
+	const std::string cache = filename + ".sdf";
+
+	// The cache is valid for this font file and these bake settings
+	AssetView font;
+	const bool packed = pack != NULL && pack->find(filename, font);
+	uint64_t stamp = packed ? font.stamp : AssetPack::getFileStamp(filename);
+	stamp = (stamp ^ ((uint64_t)baseSize << 32 | spread)) * 1099511628211ULL;
+
+	AssetView cached;
+	bool loaded = (pack != NULL && pack->find(cache, cached) && loadCache(cached.data, cached.size, stamp)) ||
+				  loadCache(cache, stamp);
+
+	if (!loaded)
+	{
+		DEBUG_MSG("Baking distance field atlas " + cache);
+		loaded = bake(filename, packed ? &font : NULL);
+		if (loaded && !saveCache(cache, stamp))
+			DEBUG_MSG("ERROR: Distance field atlas not cached " + cache);
+	}
+
+	if (!loaded)
+	{
+		DEBUG_MSG("ERROR: Distance field atlas not loaded " + filename);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Rasterises the glyphs at the base size and packs their distance fields into rows of the atlas.
+ */
+bool SdfFont::bake(const std::string& filename, const AssetView* packed)
+{
+	sf::Font font;
+	if (!(packed != NULL ? font.loadFromMemory(packed->data, packed->size) : font.loadFromFile(filename)))
+		return false;
+
+	// Rasterise every glyph first so the font texture is copied once
+	for (unsigned c = FIRST_GLYPH; c <= LAST_GLYPH; c++)
+		font.getGlyph(c, baseSize, false);
+
+	const sf::Image image = font.getTexture(baseSize).copyToImage();
+	const unsigned char* coverage = image.getPixelsPtr();
+	const int stride = (int)image.getSize().x;
+	const int padding = (int)spread;
+
+	// Shelf layout, rows as tall as their tallest glyph
+	glyphs.assign(GLYPH_COUNT, SdfGlyph());
+	std::vector<int> cellX(GLYPH_COUNT), cellY(GLYPH_COUNT);
+	int penX = 0, penY = 0, rowHeight = 0;
+
+	for (unsigned i = 0; i < GLYPH_COUNT; i++)
+	{
+		const sf::Glyph& glyph = font.getGlyph(FIRST_GLYPH + i, baseSize, false);
+		const int fieldWidth = glyph.textureRect.width + 2 * padding;
+		const int fieldHeight = glyph.textureRect.height + 2 * padding;
+
+		if (penX + fieldWidth > ATLAS_WIDTH)
+		{
+			penX = 0;
+			penY += rowHeight + GLYPH_GAP;
+			rowHeight = 0;
+		}
+
+		cellX[i] = penX;
+		cellY[i] = penY;
+		penX += fieldWidth + GLYPH_GAP;
+		rowHeight = fieldHeight > rowHeight ? fieldHeight : rowHeight;
+
+		SdfGlyph& baked = glyphs[i];
+		baked.advance = glyph.advance;
+		baked.left = glyph.bounds.left - (float)padding;
+		baked.top = glyph.bounds.top - (float)padding;
+		baked.width = (float)fieldWidth;
+		baked.height = (float)fieldHeight;
+	}
+
+	width = ATLAS_WIDTH;
+	height = 1;
+	while (height < penY + rowHeight)
+		height *= 2;
+
+	pixels.assign((size_t)width * height, 0);
+
+	for (unsigned i = 0; i < GLYPH_COUNT; i++)
+	{
+		const sf::Glyph& glyph = font.getGlyph(FIRST_GLYPH + i, baseSize, false);
+		const sf::IntRect& rect = glyph.textureRect;
+
+		computeDistanceField(coverage + ((size_t)rect.top * stride + rect.left) * 4, stride, rect.width, rect.height, padding,
+							 &pixels[(size_t)cellY[i] * width + cellX[i]], width);
+
+		SdfGlyph& baked = glyphs[i];
+		baked.u0 = (float)cellX[i] / (float)width;
+		baked.v0 = (float)cellY[i] / (float)height;
+		baked.u1 = ((float)cellX[i] + baked.width) / (float)width;
+		baked.v1 = ((float)cellY[i] + baked.height) / (float)height;
+	}
+
+	kerning.assign(GLYPH_COUNT * GLYPH_COUNT, 0.0f);
+	for (unsigned first = 0; first < GLYPH_COUNT; first++)
+		for (unsigned second = 0; second < GLYPH_COUNT; second++)
+			kerning[first * GLYPH_COUNT + second] = font.getKerning(FIRST_GLYPH + first, FIRST_GLYPH + second, baseSize);
+
+	lineSpacing = font.getLineSpacing(baseSize);
+	return true;
+}
+
+/**
+ * @brief Reads a cached atlas from memory.
+ */
+bool SdfFont::loadCache(const unsigned char* memory, size_t size, uint64_t stamp)
+{
+	CacheHeader header;
+	if (memory == NULL || size < sizeof(header))
+		return false;
+
+	memcpy(&header, memory, sizeof(header));
+	bool valid = memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+				 header.version == CACHE_VERSION &&
+				 header.stamp == stamp &&
+				 header.baseSize == (int32_t)baseSize && header.spread == (int32_t)spread &&
+				 header.width > 0 && header.height > 0 &&
+				 header.glyphCount == (int32_t)GLYPH_COUNT &&
+				 header.kerningCount >= 0 && header.kerningCount <= (int32_t)(GLYPH_COUNT * GLYPH_COUNT);
+
+	if (!valid)
+		return false;
+
+	const size_t glyphBytes = GLYPH_COUNT * sizeof(SdfGlyph);
+	const size_t kerningBytes = (size_t)header.kerningCount * sizeof(KerningPair);
+	const size_t pixelBytes = (size_t)header.width * header.height;
+	if (size != sizeof(header) + glyphBytes + kerningBytes + pixelBytes)
+		return false;
+
+	const unsigned char* read = memory + sizeof(header);
+
+	glyphs.resize(GLYPH_COUNT);
+	memcpy(&glyphs[0], read, glyphBytes);
+	read += glyphBytes;
+
+	kerning.assign(GLYPH_COUNT * GLYPH_COUNT, 0.0f);
+	for (int32_t i = 0; i < header.kerningCount; i++, read += sizeof(KerningPair))
+	{
+		KerningPair pair;
+		memcpy(&pair, read, sizeof(pair));
+		if (pair.first < GLYPH_COUNT && pair.second < GLYPH_COUNT)
+			kerning[pair.first * GLYPH_COUNT + pair.second] = pair.amount;
+	}
+
+	pixels.assign(read, read + pixelBytes);
+	width = header.width;
+	height = header.height;
+	lineSpacing = header.lineSpacing;
+	return true;
+}
+
+/**
+ * @brief Reads a cached atlas file.
+ */
+bool SdfFont::loadCache(const std::string& path, uint64_t stamp)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == NULL)
+		return false;
+
+	std::vector<unsigned char> data;
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	bool read = length > 0;
+	if (read)
+	{
+		data.resize((size_t)length);
+		read = fread(&data[0], 1, data.size(), file) == data.size();
+	}
+	fclose(file);
+
+	return read && loadCache(&data[0], data.size(), stamp);
+}
+
+/**
+ * @brief Writes the atlas, only kerning pairs that move the pen are stored.
+ */
+bool SdfFont::saveCache(const std::string& path, uint64_t stamp) const
+{
+	std::vector<KerningPair> pairs;
+	for (unsigned first = 0; first < GLYPH_COUNT; first++)
+	{
+		for (unsigned second = 0; second < GLYPH_COUNT; second++)
+		{
+			KerningPair pair;
+			pair.first = (uint16_t)first;
+			pair.second = (uint16_t)second;
+			pair.amount = kerning[first * GLYPH_COUNT + second];
+			if (pair.amount != 0.0f)
+				pairs.push_back(pair);
+		}
+	}
+
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	CacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = CACHE_VERSION;
+	header.stamp = stamp;
+	header.baseSize = (int32_t)baseSize;
+	header.spread = (int32_t)spread;
+	header.width = width;
+	header.height = height;
+	header.glyphCount = (int32_t)GLYPH_COUNT;
+	header.kerningCount = (int32_t)pairs.size();
+	header.lineSpacing = lineSpacing;
+
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+				   fwrite(&glyphs[0], sizeof(SdfGlyph), glyphs.size(), file) == glyphs.size() &&
+				   (pairs.empty() || fwrite(&pairs[0], sizeof(KerningPair), pairs.size(), file) == pairs.size()) &&
+				   fwrite(&pixels[0], 1, pixels.size(), file) == pixels.size();
+
+	fclose(file);
+	return written;
+}
+
+/**
+ * @brief Uploads the distance field as a single channel texture and releases the pixels.
+ */
+void SdfFont::upload()
+{
+	if (pixels.empty())
+		return;
+
+	if (texture == 0)
+		glGenTextures(1, &texture);
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, &pixels[0]);
+
+	// Distances interpolate linearly, so bilinear filtering keeps the outline sharp at any scale
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	std::vector<unsigned char>().swap(pixels);
+}
+
+bool SdfFont::isLoaded() const { return texture != 0; }
+
+/**
+ * @brief Getter method for the metrics of a glyph.
+ */
+const SdfGlyph* SdfFont::getGlyph(unsigned character) const
+{
+	if (character < FIRST_GLYPH || character > LAST_GLYPH || glyphs.empty())
+		return NULL;
+	return &glyphs[character - FIRST_GLYPH];
+}
+
+/**
+ * @brief Getter method for the kerning between two characters at the base size.
+ */
+float SdfFont::getKerning(unsigned first, unsigned second) const
+{
+	if (first < FIRST_GLYPH || first > LAST_GLYPH || second < FIRST_GLYPH || second > LAST_GLYPH || kerning.empty())
+		return 0.0f;
+	return kerning[(first - FIRST_GLYPH) * GLYPH_COUNT + (second - FIRST_GLYPH)];
+}
+
+unsigned SdfFont::getBaseSize() const { return baseSize; }
+
+unsigned SdfFont::getSpread() const { return spread; }
+
+float SdfFont::getLineSpacing() const { return lineSpacing; }
+
+GLuint SdfFont::getTexture() const { return texture; }
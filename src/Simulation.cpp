@@ -0,0 +1,201 @@
+/**
+ * @file Simulation.cpp
+ * @brief Contains the implementation of the Simulation class.
+ */
+
+#include <./include/Simulation.h>
+#include <./include/GridCollider.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const unsigned MAX_CATCH_UP_TICKS = 5; // Ticks run back to back before the backlog is dropped
+
+	bool held(uint32_t input, SIMULATION_INPUT key) { return (input & (uint32_t)key) != 0; }
+}
+
+Simulation::Simulation(double rate)
+	: step(1.0 / rate), stopping(false), input(0), grid(NULL), playerSpeed(0.0f), playerSize(0.0f), ticks(0), jobs(NULL)
+{
+	state.playerPosition = glm::vec3(0.0f);
+	state.points = 0;
+}
+
+/**
+ * @brief Destructor for the Simulation class, stops the thread.
+ */
+Simulation::~Simulation()
+{
+	stop();
+}
+
+CollectibleStore& Simulation::getCollectibles() { return collectibles; }
+
+Crowd& Simulation::getCrowd() { return crowd; }
+
+/**
+ * @brief Publishes the initial state and starts the simulation thread.
+ */
+void Simulation::start(const std::vector<std::vector<int>>& grid, const glm::vec3& playerPosition, float playerSpeed,
+					   float playerSize, JobSystem* jobs)
+{
+	stop();
+
+	this->grid = &grid;
+	this->playerSpeed = playerSpeed;
+	this->playerSize = playerSize;
+	this->jobs = jobs;
+	crowd.setGrid(grid);
+	state.playerPosition = playerPosition;
+	state.points = 0;
+	ticks = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		collected.clear();
+	}
+
+	SimulationSnapshot& snapshot = snapshots.write();
+	snapshot.previous = state;
+	snapshot.current = state;
+	snapshot.tick = 0;
+	snapshot.time = 0.0;
+	snapshot.agents.assign(crowd.getPositions(), crowd.getPositions() + crowd.size());
+	snapshot.previousAgents = snapshot.agents;
+	snapshots.publish();
+
+	epoch = std::chrono::steady_clock::now();
+	stopping = false;
+	thread = std::thread(&Simulation::simulationLoop, this);
+}
+
+/**
+ * @brief Stops the simulation thread.
+ */
+void Simulation::stop()
+{
+	stopping = true;
+	if (thread.joinable())
+		thread.join();
+}
+
+bool Simulation::isRunning() const { return thread.joinable(); }
+
+void Simulation::setInput(uint32_t input) { this->input.store(input, std::memory_order_relaxed); }
+
+/**
+ * @brief Getter method for the latest snapshot.
+ */
+const SimulationSnapshot& Simulation::getSnapshot()
+{
+	snapshots.update();
+	return snapshots.read();
+}
+
+/**
+ * @brief Takes the indices removed from the collectible store since the last call.
+ */
+size_t Simulation::takeCollected(std::vector<uint32_t>& indices)
+{
+	indices.clear();
+	std::lock_guard<std::mutex> lock(mutex);
+	indices.swap(collected);
+	return indices.size();
+}
+
+double Simulation::getTime() const
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+double Simulation::getStep() const { return step; }
+
+/**
+ * @brief Simulation thread body, runs the ticks due and publishes a snapshot until stop().
+ *
+ * Tick n belongs to n * step seconds after start() and runs once that time has come.
+ */
+void Simulation::simulationLoop()
+{
+	const std::chrono::steady_clock::duration length =
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(step));
+	std::chrono::steady_clock::time_point due = epoch + length;
+	uint64_t skipped = 0; // Ticks dropped, so tick times stay on the clock
+
+	while (!stopping)
+	{
+		std::this_thread::sleep_until(due);
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		SimulationState previous = state;
+		unsigned ran = 0;
+		while (due <= now && ran < MAX_CATCH_UP_TICKS)
+		{
+			previous = state;
+			tick();
+			due += length;
+			ran++;
+		}
+
+		// Too far behind, drop the backlog instead of catching up
+		while (due <= now)
+		{
+			due += length;
+			skipped++;
+		}
+
+		if (ran == 0)
+			continue;
+
+		SimulationSnapshot& snapshot = snapshots.write();
+		snapshot.previous = previous;
+		snapshot.current = state;
+		snapshot.tick = ticks;
+		snapshot.time = (double)(ticks + skipped) * step;
+		snapshot.previousAgents.assign(crowd.getPreviousPositions(), crowd.getPreviousPositions() + crowd.size());
+		snapshot.agents.assign(crowd.getPositions(), crowd.getPositions() + crowd.size());
+		snapshots.publish();
+	}
+}
+
+/**
+ * @brief Advances the gameplay by one step: moves the player against the walls, collects what it touches
+ * and moves the crowd after it.
+ */
+void Simulation::tick()
+{
+	const uint32_t keys = input.load(std::memory_order_relaxed);
+	const float distance = playerSpeed * (float)step;
+
+	glm::vec3 displacement(0.0f);
+	if (held(keys, SIMULATION_INPUT::FORWARD))
+		displacement.z -= distance;
+	if (held(keys, SIMULATION_INPUT::BACK))
+		displacement.z += distance;
+	if (held(keys, SIMULATION_INPUT::LEFT))
+		displacement.x -= distance;
+	if (held(keys, SIMULATION_INPUT::RIGHT))
+		displacement.x += distance;
+
+	// The player's cube is drawn playerSize wide
+	if (displacement != glm::vec3(0.0f))
+		state.playerPosition = GridCollider(*grid).move(state.playerPosition, glm::vec3(0.5f * playerSize), displacement);
+
+	removed.clear();
+	const size_t hits = collectibles.collect(state.playerPosition, playerSize, &removed);
+	if (hits > 0)
+	{
+		state.points += 10 * (int)hits;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		collected.insert(collected.end(), removed.begin(), removed.end());
+	}
+
+	if (!crowd.empty())
+	{
+		crowd.setGoal(state.playerPosition);
+		crowd.update((float)step, jobs);
+	}
+
+	ticks++;
+}
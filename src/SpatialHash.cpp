@@ -0,0 +1,168 @@
+/**
+ * @file SpatialHash.cpp
+ * @brief Contains the implementation of the SpatialHash class.
+ */
+
+#include <math.h> // For floorf
+
+#include <./include/SpatialHash.h>
+
+using namespace gpp; // GPP namespace
+
+SpatialHash::SpatialHash(float cellSize)
+	: cellSize(cellSize), largestSize(0.0f), starts(2, 0), counts(1, 0), mask(0), live(0)
+{
+}
+
+/**
+ * @brief Removes every object.
+ */
+void SpatialHash::clear()
+{
+	entries.clear();
+	starts.assign(2, 0);
+	counts.assign(1, 0);
+	mask = 0;
+	live = 0;
+	largestSize = 0.0f;
+}
+
+/**
+ * @brief Adds an object, found by queries after the next build().
+ */
+void SpatialHash::insert(uint32_t id, const glm::vec3& position, float size)
+{
+	Entry entry = { cellOf(position.x), cellOf(position.z), id };
+	entries.push_back(entry);
+	live++;
+	if (size > largestSize)
+		largestSize = size;
+}
+
+/**
+ * @brief Sorts the objects into their buckets, a counting sort over the bucket of each entry.
+ */
+void SpatialHash::build()
+{
+	// Live entries of the last build, then those inserted since
+	std::vector<Entry> pending;
+	pending.reserve(live);
+	for (size_t b = 0; b + 1 < starts.size(); b++)
+		pending.insert(pending.end(), entries.begin() + starts[b], entries.begin() + starts[b] + counts[b]);
+	pending.insert(pending.end(), entries.begin() + starts.back(), entries.end());
+	entries.swap(pending);
+
+	// About two buckets per object keeps collisions between cells rare
+	size_t buckets = 16;
+	while (buckets < entries.size() * 2)
+		buckets *= 2;
+	mask = buckets - 1;
+
+	starts.assign(buckets + 1, 0);
+	for (size_t i = 0; i < entries.size(); i++)
+		starts[bucketOf(entries[i].x, entries[i].z) + 1]++;
+	for (size_t b = 0; b < buckets; b++)
+		starts[b + 1] += starts[b];
+
+	std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+	std::vector<Entry> sorted(entries.size());
+	for (size_t i = 0; i < entries.size(); i++)
+		sorted[next[bucketOf(entries[i].x, entries[i].z)]++] = entries[i];
+	entries.swap(sorted);
+
+	counts.resize(buckets);
+	for (size_t b = 0; b < buckets; b++)
+		counts[b] = starts[b + 1] - starts[b];
+}
+
+/**
+ * @brief Finds the entry of a built object.
+ *
+ * @return Index of the entry, -1 if not found.
+ */
+int SpatialHash::find(uint32_t id, const glm::vec3& position) const
+{
+	const int32_t x = cellOf(position.x), z = cellOf(position.z);
+	const size_t bucket = bucketOf(x, z);
+	for (uint32_t i = starts[bucket]; i < starts[bucket] + counts[bucket]; i++)
+	{
+		if (entries[i].id == id && entries[i].x == x && entries[i].z == z)
+			return (int)i;
+	}
+	return -1;
+}
+
+/**
+ * @brief Removes a built object.
+ */
+bool SpatialHash::remove(uint32_t id, const glm::vec3& position)
+{
+	const int found = find(id, position);
+	if (found < 0)
+		return false;
+
+	const size_t bucket = bucketOf(entries[found].x, entries[found].z);
+	entries[found] = entries[starts[bucket] + counts[bucket] - 1];
+	counts[bucket]--;
+	live--;
+	return true;
+}
+
+/**
+ * @brief Changes the id of a built object.
+ */
+bool SpatialHash::rename(uint32_t id, uint32_t newId, const glm::vec3& position)
+{
+	const int found = find(id, position);
+	if (found < 0)
+		return false;
+
+	entries[found].id = newId;
+	return true;
+}
+
+/**
+ * @brief Finds the objects whose cell could hold an object overlapping a box on the ground plane.
+ */
+size_t SpatialHash::query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& ids) const
+{
+	// An object reaches up to largestSize outside its cell
+	const int32_t x0 = cellOf(min.x - largestSize), x1 = cellOf(max.x + largestSize);
+	const int32_t z0 = cellOf(min.z - largestSize), z1 = cellOf(max.z + largestSize);
+
+	const size_t found = ids.size();
+	for (int32_t x = x0; x <= x1; x++)
+	{
+		for (int32_t z = z0; z <= z1; z++)
+		{
+			const size_t bucket = bucketOf(x, z);
+			for (uint32_t i = starts[bucket]; i < starts[bucket] + counts[bucket]; i++)
+			{
+				// Buckets are shared by cells that hash alike
+				if (entries[i].x == x && entries[i].z == z)
+					ids.push_back(entries[i].id);
+			}
+		}
+	}
+
+	return ids.size() - found;
+}
+
+size_t SpatialHash::size() const { return live; }
+
+/**
+ * @brief Hashes a cell to a bucket.
+ */
+size_t SpatialHash::bucketOf(int32_t x, int32_t z) const
+{
+	const uint32_t hash = ((uint32_t)x * 73856093u) ^ ((uint32_t)z * 19349663u);
+	return hash & mask;
+}
+
+/**
+ * @brief Getter method for the cell a coordinate falls in.
+ */
+int32_t SpatialHash::cellOf(float coordinate) const
+{
+	return (int32_t)floorf(coordinate / cellSize);
+}
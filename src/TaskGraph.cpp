@@ -0,0 +1,234 @@
+/**
+ * @file TaskGraph.cpp
+ * @brief Contains the implementation of the TaskGraph class.
+ */
+
+#include <stdio.h>	   // For snprintf
+#include <algorithm>   // For std::sort
+#include <stdexcept>   // For runtime_error
+
+#include <./include/TaskGraph.h>
+
+using namespace gpp; // GPP namespace
+
+TaskGraph::TaskGraph() : jobs(NULL), outstanding(0), elapsed(0.0)
+{
+}
+
+/**
+ * @brief Adds a task.
+ */
+unsigned TaskGraph::add(const std::string& name, AFFINITY affinity, const TaskFunction& fn,
+						const std::vector<unsigned>& dependencies)
+{
+	const unsigned handle = (unsigned)tasks.size();
+
+	Task task;
+	task.name = name;
+	task.affinity = affinity;
+	task.fn = fn;
+	task.dependencies = (unsigned)dependencies.size();
+	task.remaining = 0;
+	task.timing.start = 0.0;
+	task.timing.end = 0.0;
+	task.timing.worker = 0;
+
+	for (size_t i = 0; i < dependencies.size(); i++)
+	{
+		if (dependencies[i] >= handle)
+			throw std::runtime_error("ERROR: Task " + name + " depends on a task added after it");
+		tasks[dependencies[i]].dependents.push_back(handle);
+	}
+
+	tasks.push_back(task);
+	return handle;
+}
+
+/**
+ * @brief Runs every task and blocks until all have finished.
+ */
+void TaskGraph::run(JobSystem& jobs)
+{
+	this->jobs = &jobs;
+	readyMain.clear();
+	outstanding = 0;
+	failure = std::exception_ptr();
+	started = TaskClock::now();
+
+	std::vector<unsigned> ready;
+	for (size_t i = 0; i < tasks.size(); i++)
+	{
+		Task& task = tasks[i];
+		task.remaining = task.dependencies;
+		task.timing.start = 0.0;
+		task.timing.end = 0.0;
+		task.timing.worker = 0;
+
+		if (task.remaining == 0)
+			ready.push_back((unsigned)i);
+	}
+
+	outstanding = ready.size();
+	schedule(ready);
+
+	// The calling thread (worker 0) takes the MAIN tasks and runs jobs in between. Ready tasks are only
+	// counted as done once their dependents are scheduled, so nothing is left over when the count hits 0
+	std::unique_lock<std::mutex> lock(mutex);
+	while (outstanding > 0)
+	{
+		if (!readyMain.empty())
+		{
+			const unsigned handle = readyMain.front();
+			readyMain.pop_front();
+			lock.unlock();
+			runTask(handle, 0);
+			lock.lock();
+			continue;
+		}
+
+		lock.unlock();
+		const bool ran = jobs.runPendingJob();
+		lock.lock();
+
+		// Nothing to help with, sleep until a task finishes
+		if (!ran && outstanding > 0 && readyMain.empty())
+			wake.wait_for(lock, std::chrono::milliseconds(1));
+	}
+	lock.unlock();
+
+	this->jobs = NULL;
+	elapsed = millisecondsSince(started);
+
+	if (failure)
+		std::rethrow_exception(failure);
+}
+
+/**
+ * @brief Hands ready tasks to the main thread or, for ANY tasks, to the workers as jobs.
+ *
+ * @param ready Tasks whose dependencies have finished, counted in outstanding.
+ */
+void TaskGraph::schedule(const std::vector<unsigned>& ready)
+{
+	bool main = false;
+	for (size_t i = 0; i < ready.size(); i++)
+	{
+		const unsigned handle = ready[i];
+		if (tasks[handle].affinity == AFFINITY::MAIN)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			readyMain.push_back(handle);
+			main = true;
+		}
+		else
+		{
+			jobs->run([this, handle](unsigned worker) { runTask(handle, worker); });
+		}
+	}
+
+	if (main)
+		wake.notify_all();
+}
+
+/**
+ * @brief Runs a task, unless another has failed, then schedules the dependents it was the last dependency of.
+ *
+ * @param handle Handle of the task.
+ * @param worker Worker running it.
+ */
+void TaskGraph::runTask(unsigned handle, unsigned worker)
+{
+	Task& task = tasks[handle];
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (failure)
+		{
+			outstanding--;
+			wake.notify_all();
+			return;
+		}
+		task.timing.worker = worker;
+		task.timing.start = millisecondsSince(started);
+	}
+
+	std::exception_ptr error;
+	try
+	{
+		task.fn();
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	std::vector<unsigned> ready;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task.timing.end = millisecondsSince(started);
+
+		if (error && !failure)
+			failure = error;
+
+		// Dependents of a failed run never start
+		if (!failure)
+		{
+			for (size_t i = 0; i < task.dependents.size(); i++)
+			{
+				if (--tasks[task.dependents[i]].remaining == 0)
+					ready.push_back(task.dependents[i]);
+			}
+		}
+		outstanding += ready.size();
+	}
+
+	schedule(ready);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	outstanding--;
+	wake.notify_all();
+}
+
+/**
+ * @brief Getter method for the number of tasks added.
+ */
+unsigned TaskGraph::getTaskCount() const { return (unsigned)tasks.size(); }
+
+/**
+ * @brief Getter method for the timing of a task in the last run().
+ */
+const TaskTiming& TaskGraph::getTiming(unsigned task) const { return tasks[task].timing; }
+
+/**
+ * @brief Getter method for the duration of the last run().
+ */
+double TaskGraph::getElapsed() const { return elapsed; }
+
+/**
+ * @brief Formats the timing of every task of the last run(), in start order.
+ */
+std::string TaskGraph::getReport() const
+{
+	std::vector<unsigned> order;
+	for (unsigned i = 0; i < tasks.size(); i++)
+		order.push_back(i);
+
+	std::sort(order.begin(), order.end(), [this](unsigned a, unsigned b)
+		{ return tasks[a].timing.start < tasks[b].timing.start; });
+
+	std::string report;
+	char line[128];
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const Task& task = tasks[order[i]];
+		snprintf(line, sizeof(line), "  %-20s %-9s start %8.2f ms  took %8.2f ms\n", task.name.c_str(),
+				 task.timing.worker == 0 ? "main" : ("worker " + std::to_string(task.timing.worker)).c_str(),
+				 task.timing.start, task.timing.end - task.timing.start);
+		report += line;
+	}
+	return report;
+}
+
+double TaskGraph::millisecondsSince(const TaskClock::time_point& time) const
+{
+	return std::chrono::duration<double, std::milli>(TaskClock::now() - time).count();
+}
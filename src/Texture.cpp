@@ -0,0 +1,635 @@
+/**
+ * @file Texture.cpp
+ * @brief Contains the implementation of the MipChain class.
+ */
+
+#include <math.h>	   // For pow, sin
+#include <stdio.h>	   // For cache file I/O
+#include <string.h>	   // For memcpy, memcmp
+#include <iostream>	   // For debug output
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h> // SSE2 intrinsics
+#define TEXTURE_SSE 1
+#endif
+
+#include <./include/Debug.h>
+#include <./include/Texture.h>
+#include <./include/AssetPack.h>
+#include <./include/MappedFile.h>
+#include <./include/TgaDecoder.h>
+#include <./include/BlockCompressor.h>
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const char CACHE_MAGIC[4] = { 'M', 'I', 'P', 'C' };
+	const uint32_t CACHE_VERSION = 2;
+
+	// Header of a cached mip chain, followed by the pixels of every level
+	struct CacheHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t stamp;
+		int32_t width;
+		int32_t height;
+		int32_t levels;
+		int32_t format; // TEXTURE_FORMAT
+	};
+
+	/**
+	 * @brief sRGB <-> linear conversion tables, built once.
+	 */
+	struct GammaTables
+	{
+		float toLinear[256];		 // sRGB byte to linear [0, 1]
+		unsigned char toSrgb[4096];	 // Linear [0, 1] in 1/4095 steps to sRGB byte
+
+		GammaTables()
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				float c = i / 255.0f;
+				toLinear[i] = c <= 0.04045f ? c / 12.92f : (float)pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+
+			for (int i = 0; i < 4096; i++)
+			{
+				float l = i / 4095.0f;
+				float c = l <= 0.0031308f ? l * 12.92f : 1.055f * (float)pow(l, 1.0f / 2.4f) - 0.055f;
+				toSrgb[i] = (unsigned char)(c * 255.0f + 0.5f);
+			}
+		}
+	};
+
+	const GammaTables& gamma()
+	{
+		static const GammaTables tables;
+		return tables;
+	}
+
+	inline int clampIndex(int i, int size)
+	{
+		return i < 0 ? 0 : (i >= size ? size - 1 : i);
+	}
+
+	/**
+	 * @brief Decodes RGBA8 into linear float RGBA.
+	 */
+	void decode(const unsigned char* src, size_t texels, float* dst)
+	{
+		const float* lut = gamma().toLinear;
+		for (size_t i = 0; i < texels; i++)
+		{
+			dst[i * 4 + 0] = lut[src[i * 4 + 0]];
+			dst[i * 4 + 1] = lut[src[i * 4 + 1]];
+			dst[i * 4 + 2] = lut[src[i * 4 + 2]];
+			dst[i * 4 + 3] = src[i * 4 + 3] / 255.0f;
+		}
+	}
+
+	/**
+	 * @brief Encodes linear float RGBA into RGBA8.
+	 */
+	void encode(const float* src, size_t texels, unsigned char* dst)
+	{
+		const unsigned char* lut = gamma().toSrgb;
+		for (size_t i = 0; i < texels; i++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				float v = src[i * 4 + c];
+				v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+				dst[i * 4 + c] = lut[(int)(v * 4095.0f + 0.5f)];
+			}
+			float a = src[i * 4 + 3];
+			a = a < 0.0f ? 0.0f : (a > 1.0f ? 1.0f : a);
+			dst[i * 4 + 3] = (unsigned char)(a * 255.0f + 0.5f);
+		}
+	}
+
+	/**
+	 * @brief 2x2 box filter, one RGBA texel per SIMD register.
+	 */
+	void downsampleBox(const float* src, int sw, int sh, float* dst, int dw, int dh)
+	{
+		for (int y = 0; y < dh; y++)
+		{
+			const float* row0 = src + (size_t)clampIndex(y * 2, sh) * sw * 4;
+			const float* row1 = src + (size_t)clampIndex(y * 2 + 1, sh) * sw * 4;
+			float* out = dst + (size_t)y * dw * 4;
+
+			for (int x = 0; x < dw; x++)
+			{
+				int x0 = clampIndex(x * 2, sw) * 4;
+				int x1 = clampIndex(x * 2 + 1, sw) * 4;
+#if defined(TEXTURE_SSE)
+				__m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)),
+										_mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+				_mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+				for (int c = 0; c < 4; c++)
+					out[x * 4 + c] = 0.25f * (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]);
+#endif
+			}
+		}
+	}
+
+	// Kaiser filter taps either side of the output texel centre
+	const int KAISER_TAPS = 6;
+
+	/**
+	 * @brief Zeroth order modified Bessel function of the first kind (series expansion).
+	 */
+	double besselI0(double x)
+	{
+		double sum = 1.0, term = 1.0;
+		for (int k = 1; k < 20; k++)
+		{
+			term *= (x / (2.0 * k)) * (x / (2.0 * k));
+			sum += term;
+		}
+		return sum;
+	}
+
+	/**
+	 * @brief Normalised weights of a Kaiser windowed sinc for a 2:1 reduction.
+	 *
+	 * Source texel centres sit at -2.5 .. 2.5 around the output centre.
+	 */
+	void kaiserWeights(float* weights)
+	{
+		const double alpha = 4.0;
+		const double radius = KAISER_TAPS / 2.0;
+		const double pi = 3.14159265358979323846;
+		double total = 0.0;
+		double w[KAISER_TAPS];
+
+		for (int i = 0; i < KAISER_TAPS; i++)
+		{
+			double d = i - (KAISER_TAPS - 1) / 2.0;
+			double x = d / 2.0; // Cut off at half the source frequency
+			double sinc = x == 0.0 ? 1.0 : sin(pi * x) / (pi * x);
+			double r = d / radius;
+			double window = besselI0(alpha * sqrt(1.0 - r * r)) / besselI0(alpha);
+			w[i] = sinc * window;
+			total += w[i];
+		}
+
+		for (int i = 0; i < KAISER_TAPS; i++)
+			weights[i] = (float)(w[i] / total);
+	}
+
+	/**
+	 * @brief Separable Kaiser filter, horizontal pass into scratch then vertical pass into dst.
+	 */
+	void downsampleKaiser(const float* src, int sw, int sh, float* dst, int dw, int dh, std::vector<float>& scratch)
+	{
+		float weights[KAISER_TAPS];
+		kaiserWeights(weights);
+
+		scratch.resize((size_t)dw * sh * 4);
+
+		for (int y = 0; y < sh; y++)
+		{
+			const float* row = src + (size_t)y * sw * 4;
+			float* out = &scratch[(size_t)y * dw * 4];
+
+			for (int x = 0; x < dw; x++)
+			{
+				int first = x * 2 - (KAISER_TAPS / 2 - 1);
+#if defined(TEXTURE_SSE)
+				__m128 sum = _mm_setzero_ps();
+				for (int t = 0; t < KAISER_TAPS; t++)
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(row + clampIndex(first + t, sw) * 4), _mm_set1_ps(weights[t])));
+				_mm_storeu_ps(out + x * 4, sum);
+#else
+				for (int c = 0; c < 4; c++)
+				{
+					float sum = 0.0f;
+					for (int t = 0; t < KAISER_TAPS; t++)
+						sum += row[clampIndex(first + t, sw) * 4 + c] * weights[t];
+					out[x * 4 + c] = sum;
+				}
+#endif
+			}
+		}
+
+		for (int y = 0; y < dh; y++)
+		{
+			int first = y * 2 - (KAISER_TAPS / 2 - 1);
+			float* out = dst + (size_t)y * dw * 4;
+
+			for (int x = 0; x < dw; x++)
+			{
+#if defined(TEXTURE_SSE)
+				__m128 sum = _mm_setzero_ps();
+				for (int t = 0; t < KAISER_TAPS; t++)
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&scratch[((size_t)clampIndex(first + t, sh) * dw + x) * 4]), _mm_set1_ps(weights[t])));
+				// Negative lobes can overshoot, keep the next level in range
+				sum = _mm_min_ps(_mm_max_ps(sum, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+				_mm_storeu_ps(out + x * 4, sum);
+#else
+				for (int c = 0; c < 4; c++)
+				{
+					float sum = 0.0f;
+					for (int t = 0; t < KAISER_TAPS; t++)
+						sum += scratch[((size_t)clampIndex(first + t, sh) * dw + x) * 4 + c] * weights[t];
+					out[x * 4 + c] = sum < 0.0f ? 0.0f : (sum > 1.0f ? 1.0f : sum);
+				}
+#endif
+			}
+		}
+	}
+}
+
+MipChain::MipChain()
+	: data(NULL), bytes(0), format(TEXTURE_FORMAT::RGBA8)
+{
+}
+
+/**
+ * @brief Size of a level in a storage format.
+ */
+size_t MipChain::getLevelSize(TEXTURE_FORMAT format, int width, int height)
+{
+	switch (format)
+	{
+	case TEXTURE_FORMAT::BC1:
+		return BlockCompressor::getEncodedSize(width, height, BlockCompressor::BC1_BLOCK_BYTES);
+	case TEXTURE_FORMAT::BC3:
+		return BlockCompressor::getEncodedSize(width, height, BlockCompressor::BC3_BLOCK_BYTES);
+	default:
+		return (size_t)width * height * 4;
+	}
+}
+
+/**
+ * @brief Identifies a version of a file by its modification time and size.
+ */
+uint64_t MipChain::getFileStamp(const std::string& filename)
+{
+	return AssetPack::getFileStamp(filename);
+}
+
+/**
+ * @brief Loads an image, from its cached chain if it is up to date, otherwise decodes and filters it.
+ */
+bool MipChain::load(const std::string& filename, MIP_FILTER filter)
+{
+	const uint64_t stamp = getFileStamp(filename);
+	const std::string cache = filename + ".mip";
+
+	if (stamp != 0 && loadCache(cache, stamp))
+	{
+		DEBUG_MSG("Texture mip chain loaded from cache " + cache);
+		return true;
+	}
+
+	// Decode straight into level 0 of the chain, the smaller levels are filtered from it in place
+	MappedFile file;
+	if (!file.open(filename))
+		return false;
+
+	int width = 0, height = 0;
+	if (TgaDecoder::readHeader(file.getData(), file.getSize(), width, height))
+	{
+		allocate(width, height, 0);
+		if (!TgaDecoder::decode(file.getData(), file.getSize(), &storage[0]))
+			width = 0;
+	}
+
+	if (width > 0)
+	{
+		filterLevels(filter);
+	}
+	else
+	{
+		// Not a format the fast path handles, or damaged: let stb decide
+		std::vector<unsigned char> image;
+		if (!TgaDecoder::load(file.getData(), file.getSize(), image, width, height))
+			return false;
+		build(&image[0], width, height, filter);
+	}
+
+	if (!saveCache(cache, stamp))
+	{
+		DEBUG_MSG("Texture mip chain cache not written " + cache);
+	}
+	return true;
+}
+
+/**
+ * @brief Builds the full chain from a level 0 image.
+ *
+ * Level 0 is copied as is, see filterLevels() for the others.
+ */
+void MipChain::build(const unsigned char* rgba, int width, int height, MIP_FILTER filter, int maxLevels)
+{
+	allocate(width, height, maxLevels);
+	memcpy(&storage[0], rgba, (size_t)width * height * 4);
+	filterLevels(filter);
+}
+
+/**
+ * @brief Lays out an RGBA8 chain and sizes the owned storage for it, leaving the pixels undefined.
+ *
+ * @param width Width of level 0.
+ * @param height Height of level 0.
+ * @param maxLevels Maximum number of levels including level 0, 0 lays out down to 1x1.
+ */
+void MipChain::allocate(int width, int height, int maxLevels)
+{
+	levels.clear();
+
+	size_t total = 0;
+	int w = width, h = height;
+	for (;;)
+	{
+		Level level = { w, h, total, (size_t)w * h * 4 };
+		levels.push_back(level);
+		total += level.size;
+
+		if ((w == 1 && h == 1) || (int)levels.size() == maxLevels)
+			break;
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
+	}
+
+	storage.resize(total);
+	data = &storage[0];
+	bytes = total;
+	format = TEXTURE_FORMAT::RGBA8;
+}
+
+/**
+ * @brief Fills every level below level 0 from level 0, already in storage.
+ *
+ * Every smaller level is filtered from the previous one in linear float and only quantized back to
+ * sRGB bytes for storage, so rounding error does not accumulate.
+ *
+ * @param filter Downsampling filter.
+ */
+void MipChain::filterLevels(MIP_FILTER filter)
+{
+	std::vector<float> current((size_t)levels[0].width * levels[0].height * 4);
+	std::vector<float> next;
+	std::vector<float> scratch;
+	decode(&storage[0], (size_t)levels[0].width * levels[0].height, &current[0]);
+
+	for (size_t i = 1; i < levels.size(); i++)
+	{
+		const Level& src = levels[i - 1];
+		const Level& dst = levels[i];
+		next.resize((size_t)dst.width * dst.height * 4);
+
+		if (filter == MIP_FILTER::KAISER)
+			downsampleKaiser(&current[0], src.width, src.height, &next[0], dst.width, dst.height, scratch);
+		else
+			downsampleBox(&current[0], src.width, src.height, &next[0], dst.width, dst.height);
+
+		encode(&next[0], (size_t)dst.width * dst.height, &storage[dst.offset]);
+		current.swap(next);
+	}
+}
+
+/**
+ * @brief Block compresses every level of an RGBA8 chain.
+ */
+bool MipChain::compress(TEXTURE_FORMAT target)
+{
+	if (levels.empty() || format != TEXTURE_FORMAT::RGBA8 || target == TEXTURE_FORMAT::RGBA8)
+		return false;
+
+	std::vector<Level> compressed(levels.size());
+	size_t total = 0;
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		Level level = { levels[i].width, levels[i].height, total, getLevelSize(target, levels[i].width, levels[i].height) };
+		compressed[i] = level;
+		total += level.size;
+	}
+
+	std::vector<unsigned char> encoded(total);
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		if (target == TEXTURE_FORMAT::BC1)
+			BlockCompressor::encodeBC1(data + levels[i].offset, levels[i].width, levels[i].height, &encoded[compressed[i].offset]);
+		else
+			BlockCompressor::encodeBC3(data + levels[i].offset, levels[i].width, levels[i].height, &encoded[compressed[i].offset]);
+	}
+
+	levels.swap(compressed);
+	storage.swap(encoded);
+	data = &storage[0];
+	bytes = total;
+	format = target;
+	return true;
+}
+
+/**
+ * @brief Checks level 0 of an RGBA8 chain for pixels that are not fully opaque.
+ */
+bool MipChain::hasAlpha() const
+{
+	if (levels.empty() || format != TEXTURE_FORMAT::RGBA8)
+		return format == TEXTURE_FORMAT::BC3;
+
+	const size_t texels = (size_t)levels[0].width * levels[0].height;
+	for (size_t i = 0; i < texels; i++)
+	{
+		if (data[i * 4 + 3] != 255)
+			return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Reads a cached chain from a file into owned storage.
+ */
+bool MipChain::loadCache(const std::string& path, uint64_t stamp)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == NULL)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	std::vector<unsigned char> contents(length > 0 ? (size_t)length : 0);
+	bool read = !contents.empty() && fread(&contents[0], 1, contents.size(), file) == contents.size();
+	fclose(file);
+
+	if (!read || !loadCache(&contents[0], contents.size(), stamp))
+		return false;
+
+	// Keep the file contents alive and point at them
+	size_t offset = data - &contents[0];
+	storage.swap(contents);
+	data = &storage[offset];
+	return true;
+}
+
+/**
+ * @brief Reads a cached chain in place, the levels point into the given memory.
+ */
+bool MipChain::loadCache(const unsigned char* memory, size_t size, uint64_t stamp)
+{
+	CacheHeader header;
+	if (memory == NULL || size < sizeof(header))
+		return false;
+
+	memcpy(&header, memory, sizeof(header));
+	bool valid = memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+				 header.version == CACHE_VERSION &&
+				 header.stamp == stamp &&
+				 header.width > 0 && header.height > 0 && header.levels > 0 && header.levels <= 32 &&
+				 (header.format == (int32_t)TEXTURE_FORMAT::RGBA8 ||
+				  header.format == (int32_t)TEXTURE_FORMAT::BC1 ||
+				  header.format == (int32_t)TEXTURE_FORMAT::BC3);
+
+	if (!valid)
+		return false;
+
+	const TEXTURE_FORMAT cachedFormat = (TEXTURE_FORMAT)header.format;
+	std::vector<Level> cached;
+	size_t total = 0;
+	int w = header.width, h = header.height;
+	for (int i = 0; i < header.levels; i++)
+	{
+		Level level = { w, h, total, getLevelSize(cachedFormat, w, h) };
+		cached.push_back(level);
+		total += level.size;
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
+	}
+
+	if (sizeof(header) + total > size)
+		return false;
+
+	levels.swap(cached);
+	storage.clear();
+	data = memory + sizeof(header);
+	bytes = total;
+	format = cachedFormat;
+	return true;
+}
+
+/**
+ * @brief Writes the chain to a cache file.
+ */
+bool MipChain::saveCache(const std::string& path, uint64_t stamp) const
+{
+	if (levels.empty())
+		return false;
+
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	CacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = CACHE_VERSION;
+	header.stamp = stamp;
+	header.width = levels[0].width;
+	header.height = levels[0].height;
+	header.levels = (int32_t)levels.size();
+	header.format = (int32_t)format;
+
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+				   fwrite(data, 1, bytes, file) == bytes;
+
+	fclose(file);
+	return written;
+}
+
+/**
+ * @brief Uploads every level into a texture object and enables trilinear filtering.
+ */
+void MipChain::upload(GLuint texture) const
+{
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		if (format == TEXTURE_FORMAT::RGBA8)
+		{
+			glTexImage2D(GL_TEXTURE_2D, (GLint)i, GL_RGBA, levels[i].width, levels[i].height, 0,
+						 GL_RGBA, GL_UNSIGNED_BYTE, data + levels[i].offset);
+		}
+		else
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, getInternalFormat(), levels[i].width, levels[i].height, 0,
+								   (GLsizei)levels[i].size, data + levels[i].offset);
+		}
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+/**
+ * @brief Releases every level.
+ */
+void MipChain::clear()
+{
+	std::vector<Level>().swap(levels);
+	std::vector<unsigned char>().swap(storage);
+	data = NULL;
+	bytes = 0;
+	format = TEXTURE_FORMAT::RGBA8;
+}
+
+int MipChain::getLevelCount() const { return (int)levels.size(); }
+
+int MipChain::getWidth(int level) const { return levels[level].width; }
+
+int MipChain::getHeight(int level) const { return levels[level].height; }
+
+const unsigned char* MipChain::getLevel(int level) const { return data + levels[level].offset; }
+
+size_t MipChain::getLevelSize(int level) const { return levels[level].size; }
+
+TEXTURE_FORMAT MipChain::getFormat() const { return format; }
+
+/**
+ * @brief Getter method for the GL internal format of the levels.
+ */
+GLenum MipChain::getInternalFormat() const
+{
+	switch (format)
+	{
+	case TEXTURE_FORMAT::BC1:
+		return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case TEXTURE_FORMAT::BC3:
+		return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	default:
+		return GL_RGBA;
+	}
+}
+
+/**
+ * @brief Getter method for the number of pixel rows stored together (1, or 4 for block formats).
+ */
+int MipChain::getRowHeight() const { return format == TEXTURE_FORMAT::RGBA8 ? 1 : 4; }
+
+/**
+ * @brief Getter method for the size of one row of pixels, or of blocks for block formats.
+ */
+size_t MipChain::getRowBytes(int level) const
+{
+	const int rowHeight = getRowHeight();
+	return getLevelSize(format, levels[level].width, rowHeight);
+}
+
+/**
+ * @brief Getter method for the total size of all levels in bytes.
+ */
+size_t MipChain::getByteSize() const { return bytes; }
@@ -0,0 +1,211 @@
+/**
+ * @file TextureAtlas.cpp
+ * @brief Contains the implementation of the TextureAtlas class.
+ */
+
+#include <math.h>	// For sqrt, floor
+#include <iostream> // For debug output
+
+#include <./include/Debug.h>
+#include <./include/TextureAtlas.h>
+#include <./include/TgaDecoder.h>
+
+using namespace gpp; // GPP namespace
+
+/**
+ * @brief Constructor for the TextureAtlas class.
+ */
+TextureAtlas::TextureAtlas(int cellSize, int gutter)
+	: cellSize(cellSize), gutter(gutter), columns(0), rows(0)
+{
+}
+
+/**
+ * @brief Resamples an image (bilinear) into a cell, repeating its edge texels into the gutter.
+ *
+ * @param rgba Source pixels.
+ * @param width Source width.
+ * @param height Source height.
+ * @param cell First texel of the cell in the atlas.
+ * @param cellSize Cell size in texels.
+ * @param gutter Gutter in texels.
+ * @param stride Atlas row length in bytes.
+ */
+void TextureAtlas::pack(const unsigned char* rgba, int width, int height, unsigned char* cell, int cellSize, int gutter, int stride)
+{
+	const int content = cellSize - 2 * gutter;
+	const float scaleX = (float)width / content;
+	const float scaleY = (float)height / content;
+
+	for (int j = 0; j < cellSize; j++)
+	{
+		int cj = j - gutter;
+		cj = cj < 0 ? 0 : (cj >= content ? content - 1 : cj);
+
+		float sy = (cj + 0.5f) * scaleY - 0.5f;
+		sy = sy < 0.0f ? 0.0f : sy;
+		int y0 = (int)sy;
+		int y1 = y0 + 1 < height ? y0 + 1 : height - 1;
+		float fy = sy - y0;
+
+		unsigned char* out = cell + (size_t)j * stride;
+
+		for (int i = 0; i < cellSize; i++)
+		{
+			int ci = i - gutter;
+			ci = ci < 0 ? 0 : (ci >= content ? content - 1 : ci);
+
+			float sx = (ci + 0.5f) * scaleX - 0.5f;
+			sx = sx < 0.0f ? 0.0f : sx;
+			int x0 = (int)sx;
+			int x1 = x0 + 1 < width ? x0 + 1 : width - 1;
+			float fx = sx - x0;
+
+			const unsigned char* p00 = rgba + ((size_t)y0 * width + x0) * 4;
+			const unsigned char* p10 = rgba + ((size_t)y0 * width + x1) * 4;
+			const unsigned char* p01 = rgba + ((size_t)y1 * width + x0) * 4;
+			const unsigned char* p11 = rgba + ((size_t)y1 * width + x1) * 4;
+
+			for (int c = 0; c < 4; c++)
+			{
+				float top = p00[c] + (p10[c] - p00[c]) * fx;
+				float bottom = p01[c] + (p11[c] - p01[c]) * fx;
+				out[i * 4 + c] = (unsigned char)(top + (bottom - top) * fy + 0.5f);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Assigns layers to images in the order given and lays out the cells.
+ */
+void TextureAtlas::setLayers(const std::vector<std::string>& filenames)
+{
+	names = filenames;
+
+	const int layers = (int)names.size();
+	columns = layers > 0 ? (int)ceil(sqrt((double)layers)) : 0;
+	rows = layers > 0 ? (layers + columns - 1) / columns : 0;
+}
+
+/**
+ * @brief Builds the atlas mip chain, or loads it from the cache when every image is unchanged.
+ */
+bool TextureAtlas::build(const std::string& cache, const AssetPack* assets, MipChain& mips, bool compress) const
+{
+	const int layers = (int)names.size();
+	if (layers == 0)
+		return false;
+
+	const int width = columns * cellSize;
+	const int height = rows * cellSize;
+
+	// Keep levels down to a one texel gutter
+	int maxLevels = 1;
+	for (int g = gutter; g > 1; g /= 2)
+		maxLevels++;
+
+	// Identify this set of images (FNV-1a over names, file stamps and layout)
+	uint64_t stamp = 14695981039346656037ULL;
+	for (int i = 0; i < layers; i++)
+	{
+		AssetView view;
+		uint64_t fileStamp = assets != NULL && assets->find(names[i], view) ? view.stamp : MipChain::getFileStamp(names[i]);
+		for (size_t c = 0; c < names[i].size(); c++)
+			stamp = (stamp ^ (unsigned char)names[i][c]) * 1099511628211ULL;
+		stamp = (stamp ^ fileStamp) * 1099511628211ULL;
+	}
+	stamp = (stamp ^ (uint64_t)(cellSize * 65536 + gutter)) * 1099511628211ULL;
+
+	// A cache inside the pack is used in place, otherwise try the loose file
+	AssetView cached;
+	if (assets != NULL && assets->find(cache, cached) && mips.loadCache(cached.data, cached.size, stamp) &&
+		mips.getWidth(0) == width && mips.getHeight(0) == height)
+	{
+		DEBUG_MSG("Texture atlas mapped from asset pack " + cache);
+		return true;
+	}
+
+	if (mips.loadCache(cache, stamp) && mips.getWidth(0) == width && mips.getHeight(0) == height)
+	{
+		DEBUG_MSG("Texture atlas loaded from cache " + cache);
+		return true;
+	}
+
+	std::vector<unsigned char> pixels((size_t)width * height * 4);
+	std::vector<unsigned char> image; // Decoded layer, reused between layers
+	const int stride = width * 4;
+	int packed = 0;
+
+	for (int i = 0; i < layers; i++)
+	{
+		unsigned char* cell = &pixels[(size_t)(i / columns) * cellSize * stride + (size_t)(i % columns) * cellSize * 4];
+
+		int w = 0, h = 0;
+		bool loaded = false;
+		AssetView view;
+		if (assets != NULL && assets->find(names[i], view))
+			loaded = TgaDecoder::load(view.data, view.size, image, w, h);
+		else
+			loaded = TgaDecoder::load(names[i], image, w, h);
+
+		if (!loaded)
+		{
+			DEBUG_MSG("ERROR: Texture not packed " + names[i]);
+			const unsigned char magenta[4] = { 255, 0, 255, 255 };
+			pack(magenta, 1, 1, cell, cellSize, gutter, stride);
+			continue;
+		}
+
+		pack(&image[0], w, h, cell, cellSize, gutter, stride);
+		packed++;
+	}
+
+	if (packed == 0)
+		return false;
+
+	mips.build(&pixels[0], width, height, MIP_FILTER::BOX, maxLevels);
+
+	// Cells stay a multiple of 4 texels down to the last level kept (cellSize / gutter >= 4),
+	// so blocks never straddle layers
+	if (compress)
+		mips.compress(mips.hasAlpha() ? TEXTURE_FORMAT::BC3 : TEXTURE_FORMAT::BC1);
+
+	if (!mips.saveCache(cache, stamp))
+	{
+		DEBUG_MSG("Texture atlas cache not written " + cache);
+	}
+	return true;
+}
+
+/**
+ * @brief Finds the layer of an image.
+ */
+int TextureAtlas::find(const std::string& filename) const
+{
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		if (names[i] == filename)
+			return (int)i;
+	}
+	return -1;
+}
+
+/**
+ * @brief Getter method for the UV rectangle of a layer.
+ */
+glm::vec4 TextureAtlas::getRect(int layer) const
+{
+	if (layer < 0 || layer >= (int)names.size())
+		return glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+
+	const float width = (float)(columns * cellSize);
+	const float height = (float)(rows * cellSize);
+	const float x = (float)((layer % columns) * cellSize + gutter);
+	const float y = (float)((layer / columns) * cellSize + gutter);
+	const float content = (float)(cellSize - 2 * gutter);
+
+	return glm::vec4(x / width, y / height, (x + content) / width, (y + content) / height);
+}
+
+int TextureAtlas::getLayerCount() const { return (int)names.size(); }
@@ -0,0 +1,497 @@
+/**
+ * @file TextureStreamer.cpp
+ * @brief Contains the implementation of the TextureStreamer class.
+ */
+
+#include <string.h> // For memcpy
+#include <iostream> // For debug output
+
+#include <./include/Debug.h>
+#include <./include/TextureStreamer.h>
+
+using namespace gpp; // GPP namespace
+
+/**
+ * @brief Constructor for the TextureStreamer class.
+ */
+TextureStreamer::TextureStreamer(unsigned count, size_t uploadBudget, size_t memoryBudget)
+	: stopping(false), uploadBudget(uploadBudget), memoryBudget(memoryBudget), residentBytes(0), frame(0),
+	  placeholder(0), nextPbo(0)
+{
+	stats = TextureStats();
+
+	for (int i = 0; i < PBO_COUNT; i++)
+		pbos[i] = 0;
+
+	for (unsigned i = 0; i < count; i++)
+		threads.push_back(std::thread(&TextureStreamer::decodeLoop, this));
+}
+
+/**
+ * @brief Destructor for the TextureStreamer class, abandons queued work and releases the textures.
+ */
+TextureStreamer::~TextureStreamer()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (entries[i]->texture != 0)
+			glDeleteTextures(1, &entries[i]->texture);
+		if (entries[i]->uploading != 0)
+			glDeleteTextures(1, &entries[i]->uploading);
+	}
+
+	if (placeholder != 0)
+		glDeleteTextures(1, &placeholder);
+
+	if (pbos[0] != 0)
+		glDeleteBuffers(PBO_COUNT, pbos);
+}
+
+/**
+ * @brief Creates the placeholder texture and the pixel buffer objects, needs a GL context.
+ */
+void TextureStreamer::initialise()
+{
+	// Mid grey checker, visible but unobtrusive while the real texture streams in
+	const unsigned char checker[2 * 2 * 4] = {
+		96, 96, 96, 255, 160, 160, 160, 255,
+		160, 160, 160, 255, 96, 96, 96, 255,
+	};
+
+	glGenTextures(1, &placeholder);
+	glBindTexture(GL_TEXTURE_2D, placeholder);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, checker);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object)
+	{
+		glGenBuffers(PBO_COUNT, pbos);
+	}
+	else
+	{
+		DEBUG_MSG("Pixel buffer objects unsupported, textures are transferred from client memory");
+	}
+}
+
+/**
+ * @brief Queues a texture whose mip chain is produced by a decode function.
+ */
+unsigned TextureStreamer::request(const DecodeFunction& decode, GLint wrap)
+{
+	std::unique_ptr<Entry> entry(new Entry());
+	entry->decode = decode;
+	entry->wrap = wrap;
+	entry->texture = 0;
+	entry->textureBytes = 0;
+	entry->uploading = 0;
+	entry->uploadingBytes = 0;
+	entry->levelCount = 0;
+	entry->skipLevels = 0;
+	entry->lastUsed = frame;
+
+	Entry& queued = *entry;
+	entries.push_back(std::move(entry));
+	queue(queued);
+
+	return (unsigned)(entries.size() - 1);
+}
+
+/**
+ * @brief Hands an entry to the decode threads.
+ *
+ * @param entry Entry to decode, its resident texture (if any) stays in use meanwhile.
+ */
+void TextureStreamer::queue(Entry& entry)
+{
+	entry.state = STATE::QUEUED;
+	entry.decoded = false;
+	entry.reloadPending = false;
+	entry.level = 0;
+	entry.row = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		decodeQueue.push_back(&entry);
+	}
+	wake.notify_one();
+}
+
+/**
+ * @brief Queues an image file, see MipChain::load().
+ */
+unsigned TextureStreamer::request(const std::string& filename, MIP_FILTER filter)
+{
+	return request([filename, filter](MipChain& mips) { return mips.load(filename, filter); });
+}
+
+/**
+ * @brief Decode thread body, runs queued decode functions until the streamer is destroyed.
+ */
+void TextureStreamer::decodeLoop()
+{
+	for (;;)
+	{
+		Entry* entry = NULL;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this] { return stopping || !decodeQueue.empty(); });
+			if (stopping)
+				return;
+			entry = decodeQueue.front();
+			decodeQueue.pop_front();
+		}
+
+		bool decoded = entry->decode(entry->mips) && entry->mips.getLevelCount() > 0;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		entry->decoded = decoded;
+		decodedQueue.push_back(entry);
+	}
+}
+
+/**
+ * @brief Transfers decoded textures within the upload budget and enforces the memory budget.
+ */
+void TextureStreamer::update()
+{
+	frame++;
+	stats.uploadedBytes = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		while (!decodedQueue.empty())
+		{
+			uploadQueue.push_back(decodedQueue.front());
+			decodedQueue.pop_front();
+		}
+	}
+
+	if (!uploadQueue.empty())
+	{
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		size_t budget = uploadBudget;
+		while (!uploadQueue.empty() && budget > 0)
+		{
+			Entry& entry = *uploadQueue.front();
+
+			if (entry.uploading == 0)
+			{
+				if (!entry.decoded)
+				{
+					// Keep whatever is resident, the placeholder otherwise
+					DEBUG_MSG("ERROR: Texture not streamed");
+					entry.mips.clear();
+					entry.state = entry.texture != 0 ? STATE::RESIDENT : STATE::FAILED;
+					uploadQueue.pop_front();
+					if (entry.reloadPending)
+						queue(entry);
+					continue;
+				}
+				beginUpload(entry);
+			}
+
+			size_t sent = uploadBand(entry, budget);
+			stats.uploadedBytes += sent;
+			budget = sent < budget ? budget - sent : 0;
+
+			if (entry.level == entry.levelCount)
+			{
+				finishUpload(entry);
+				uploadQueue.pop_front();
+				if (entry.reloadPending)
+					queue(entry);
+			}
+		}
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	enforceBudget();
+}
+
+/**
+ * @brief Allocates the texture a decoded entry is transferred into, leaving out skipped top levels.
+ *
+ * @param entry Decoded entry.
+ */
+void TextureStreamer::beginUpload(Entry& entry)
+{
+	entry.levelCount = entry.mips.getLevelCount();
+	if (entry.skipLevels > entry.levelCount - 1)
+		entry.skipLevels = entry.levelCount - 1;
+
+	entry.state = STATE::UPLOADING;
+	entry.level = entry.skipLevels;
+	entry.row = 0;
+
+	glGenTextures(1, &entry.uploading);
+	glBindTexture(GL_TEXTURE_2D, entry.uploading);
+
+	// S3TC formats may be allocated through glTexImage2D, the blocks are sent compressed
+	size_t bytes = 0;
+	for (int i = entry.skipLevels; i < entry.levelCount; i++)
+	{
+		glTexImage2D(GL_TEXTURE_2D, i - entry.skipLevels, entry.mips.getInternalFormat(), entry.mips.getWidth(i), entry.mips.getHeight(i), 0,
+					 GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		bytes += entry.mips.getLevelSize(i);
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, entry.levelCount - 1 - entry.skipLevels);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, entry.wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, entry.wrap);
+
+	entry.uploadingBytes = bytes;
+	residentBytes += bytes;
+}
+
+/**
+ * @brief Swaps a fully transferred texture in, releasing the one it replaces.
+ *
+ * @param entry Entry whose last level was transferred.
+ */
+void TextureStreamer::finishUpload(Entry& entry)
+{
+	if (entry.texture != 0)
+	{
+		glDeleteTextures(1, &entry.texture);
+		residentBytes -= entry.textureBytes;
+	}
+
+	entry.texture = entry.uploading;
+	entry.textureBytes = entry.uploadingBytes;
+	entry.uploading = 0;
+	entry.uploadingBytes = 0;
+	entry.state = STATE::RESIDENT;
+	entry.mips.clear();
+}
+
+/**
+ * @brief Releases or shrinks textures while over the memory budget, grows them back when there is room.
+ *
+ * Textures not drawn in the last frame are released, least recently used first. If every resident
+ * texture is in use, the largest loses its top level. Only one texture is resized at a time, as the
+ * replacement is counted against the budget once it starts uploading.
+ */
+void TextureStreamer::enforceBudget()
+{
+	while (residentBytes > memoryBudget)
+	{
+		Entry* victim = NULL;
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			Entry* entry = entries[i].get();
+			if (entry->state == STATE::RESIDENT && entry->lastUsed + 1 < frame &&
+				(victim == NULL || entry->lastUsed < victim->lastUsed))
+				victim = entry;
+		}
+
+		if (victim == NULL)
+			break;
+
+		glDeleteTextures(1, &victim->texture);
+		residentBytes -= victim->textureBytes;
+		victim->texture = 0;
+		victim->textureBytes = 0;
+		victim->state = STATE::EVICTED;
+		stats.evictions++;
+	}
+
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		const Entry& entry = *entries[i];
+		if (entry.texture != 0 && (entry.state == STATE::QUEUED || entry.state == STATE::UPLOADING))
+			return;
+	}
+
+	Entry* resize = NULL;
+	if (residentBytes > memoryBudget)
+	{
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			Entry* entry = entries[i].get();
+			if (entry->state == STATE::RESIDENT && entry->skipLevels + 1 < entry->levelCount &&
+				(resize == NULL || entry->textureBytes > resize->textureBytes))
+				resize = entry;
+		}
+
+		if (resize != NULL)
+		{
+			resize->skipLevels++;
+			stats.mipDrops++;
+			queue(*resize);
+		}
+		return;
+	}
+
+	// The restored chain is about 4 times the size, and both are resident until the swap
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		Entry* entry = entries[i].get();
+		if (entry->state == STATE::RESIDENT && entry->skipLevels > 0 &&
+			(resize == NULL || entry->lastUsed > resize->lastUsed))
+			resize = entry;
+	}
+
+	if (resize != NULL && residentBytes + resize->textureBytes * 4 <= memoryBudget)
+	{
+		resize->skipLevels--;
+		queue(*resize);
+	}
+}
+
+/**
+ * @brief Transfers the next band of rows of an entry, at least one row (of blocks for block formats).
+ *
+ * @param entry Entry being uploaded.
+ * @param budget Bytes left for this frame.
+ * @return Bytes transferred.
+ */
+size_t TextureStreamer::uploadBand(Entry& entry, size_t budget)
+{
+	const int width = entry.mips.getWidth(entry.level);
+	const int height = entry.mips.getHeight(entry.level);
+	const int rowHeight = entry.mips.getRowHeight();
+	const int rowCount = (height + rowHeight - 1) / rowHeight;
+	const size_t rowBytes = entry.mips.getRowBytes(entry.level);
+	const bool compressed = entry.mips.getFormat() != TEXTURE_FORMAT::RGBA8;
+
+	size_t rows = budget / rowBytes;
+	if (rows == 0)
+		rows = 1;
+	if (rows > (size_t)(rowCount - entry.row))
+		rows = (size_t)(rowCount - entry.row);
+
+	const size_t bytes = rows * rowBytes;
+	const unsigned char* source = entry.mips.getLevel(entry.level) + (size_t)entry.row * rowBytes;
+
+	// Pixel rows covered, the last block row may overhang the level
+	const int y = entry.row * rowHeight;
+	const int bandHeight = y + (int)rows * rowHeight < height ? (int)rows * rowHeight : height - y;
+
+	glBindTexture(GL_TEXTURE_2D, entry.uploading);
+
+	void* mapped = NULL;
+	if (pbos[0] != 0)
+	{
+		// Orphan the buffer so the driver never stalls on a transfer still in flight
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos[nextPbo]);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)bytes, NULL, GL_STREAM_DRAW);
+		mapped = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+		nextPbo = (nextPbo + 1) % PBO_COUNT;
+	}
+
+	const void* pixels = source;
+	if (mapped != NULL)
+	{
+		memcpy(mapped, source, bytes);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		pixels = NULL; // Offset into the bound buffer
+	}
+	else
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	const GLint target = entry.level - entry.skipLevels;
+	if (compressed)
+		glCompressedTexSubImage2D(GL_TEXTURE_2D, target, 0, y, width, bandHeight, entry.mips.getInternalFormat(), (GLsizei)bytes, pixels);
+	else
+		glTexSubImage2D(GL_TEXTURE_2D, target, 0, y, width, bandHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+	entry.row += (int)rows;
+	if (entry.row == rowCount)
+	{
+		entry.row = 0;
+		entry.level++;
+	}
+	return bytes;
+}
+
+/**
+ * @brief Getter method for the texture object to bind for a handle, marks the texture as used.
+ */
+GLuint TextureStreamer::getTexture(unsigned handle)
+{
+	if (handle >= entries.size())
+		return placeholder;
+
+	Entry& entry = *entries[handle];
+	entry.lastUsed = frame;
+
+	if (entry.state == STATE::EVICTED)
+	{
+		stats.reloads++;
+		queue(entry);
+	}
+
+	return entry.texture != 0 ? entry.texture : placeholder;
+}
+
+/**
+ * @brief Decodes and uploads a texture again, keeping the resident one meanwhile.
+ */
+void TextureStreamer::reload(unsigned handle)
+{
+	if (handle >= entries.size())
+		return;
+
+	Entry& entry = *entries[handle];
+	if (entry.state == STATE::QUEUED || entry.state == STATE::UPLOADING)
+		entry.reloadPending = true; // May have read the old file already
+	else if (entry.state != STATE::EVICTED)
+		queue(entry);
+}
+
+bool TextureStreamer::isReady(unsigned handle) const
+{
+	return handle < entries.size() && entries[handle]->texture != 0;
+}
+
+/**
+ * @brief Setter method for the GPU storage budget, applied by the next update().
+ */
+void TextureStreamer::setMemoryBudget(size_t bytes) { memoryBudget = bytes; }
+
+/**
+ * @brief Getter method for the number of textures still being decoded or uploaded.
+ */
+size_t TextureStreamer::getPendingCount() const { return getStats().pending; }
+
+/**
+ * @brief Getter method for the residency counters.
+ */
+TextureStats TextureStreamer::getStats() const
+{
+	TextureStats current = stats;
+	current.textures = entries.size();
+	current.resident = 0;
+	current.pending = 0;
+	current.residentBytes = residentBytes;
+	current.budgetBytes = memoryBudget;
+
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (entries[i]->texture != 0)
+			current.resident++;
+		if (entries[i]->state == STATE::QUEUED || entries[i]->state == STATE::UPLOADING)
+			current.pending++;
+	}
+	return current;
+}
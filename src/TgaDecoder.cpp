@@ -0,0 +1,319 @@
+/**
+ * @file TgaDecoder.cpp
+ * @brief Contains the implementation of the TgaDecoder class.
+ */
+
+#include <string.h> // For memcpy
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // SSSE3 and AVX2 intrinsics, enabled per function
+#define TGA_SIMD 1
+#endif
+
+#include <./include/TgaDecoder.h>
+#include <./include/MappedFile.h>
+#include <./include/stb_image.h> // Declarations only, implementation lives in Game.cpp
+
+using namespace gpp; // GPP namespace
+
+namespace
+{
+	const size_t HEADER_SIZE = 18;
+
+	enum
+	{
+		TYPE_TRUE_COLOUR = 2,
+		TYPE_TRUE_COLOUR_RLE = 10,
+		ORIGIN_RIGHT = 0x10, // Descriptor bit, columns stored right to left
+		ORIGIN_TOP = 0x20,	 // Descriptor bit, rows stored top to bottom
+	};
+
+	// Converts count BGR(A) pixels to RGBA
+	typedef void (*ConvertFunction)(const unsigned char* src, unsigned char* dst, size_t count);
+
+	void convert24(const unsigned char* src, unsigned char* dst, size_t count)
+	{
+		for (size_t i = 0; i < count; i++, src += 3, dst += 4)
+		{
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			dst[3] = 255;
+		}
+	}
+
+	void convert32(const unsigned char* src, unsigned char* dst, size_t count)
+	{
+		for (size_t i = 0; i < count; i++, src += 4, dst += 4)
+		{
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			dst[3] = src[3];
+		}
+	}
+
+#if defined(TGA_SIMD)
+	__attribute__((target("ssse3"))) void convert24Ssse3(const unsigned char* src, unsigned char* dst, size_t count)
+	{
+		const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128);
+		const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+
+		// Each 16 byte load uses 12 bytes, stop while the load stays inside the source
+		size_t i = 0;
+		for (; i + 6 <= count; i += 4)
+		{
+			__m128i bgr = _mm_loadu_si128((const __m128i*)(src + i * 3));
+			_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(bgr, shuffle), alpha));
+		}
+		convert24(src + i * 3, dst + i * 4, count - i);
+	}
+
+	__attribute__((target("ssse3"))) void convert32Ssse3(const unsigned char* src, unsigned char* dst, size_t count)
+	{
+		const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i bgra = _mm_loadu_si128((const __m128i*)(src + i * 4));
+			_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_shuffle_epi8(bgra, shuffle));
+		}
+		convert32(src + i * 4, dst + i * 4, count - i);
+	}
+
+	__attribute__((target("avx2"))) void convert24Avx2(const unsigned char* src, unsigned char* dst, size_t count)
+	{
+		// The shuffle works within 128-bit lanes, so each lane is loaded with its own 4 pixels
+		const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128,
+												 2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128);
+		const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+
+		size_t i = 0;
+		for (; i + 10 <= count; i += 8)
+		{
+			__m128i low = _mm_loadu_si128((const __m128i*)(src + i * 3));
+			__m128i high = _mm_loadu_si128((const __m128i*)(src + i * 3 + 12));
+			__m256i bgr = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+			_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(bgr, shuffle), alpha));
+		}
+		convert24Ssse3(src + i * 3, dst + i * 4, count - i);
+	}
+
+	__attribute__((target("avx2"))) void convert32Avx2(const unsigned char* src, unsigned char* dst, size_t count)
+	{
+		const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+												 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i bgra = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+			_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_shuffle_epi8(bgra, shuffle));
+		}
+		convert32Ssse3(src + i * 4, dst + i * 4, count - i);
+	}
+#endif
+
+	/**
+	 * @brief Conversion kernels for this CPU, chosen once.
+	 */
+	struct Kernels
+	{
+		ConvertFunction from24;
+		ConvertFunction from32;
+		const char* name;
+
+		Kernels()
+			: from24(convert24), from32(convert32), name("scalar")
+		{
+#if defined(TGA_SIMD)
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2"))
+			{
+				from24 = convert24Avx2;
+				from32 = convert32Avx2;
+				name = "AVX2";
+			}
+			else if (__builtin_cpu_supports("ssse3"))
+			{
+				from24 = convert24Ssse3;
+				from32 = convert32Ssse3;
+				name = "SSSE3";
+			}
+#endif
+		}
+	};
+
+	const Kernels& kernels()
+	{
+		static const Kernels selected;
+		return selected;
+	}
+
+	inline int readShort(const unsigned char* p)
+	{
+		return p[0] | (p[1] << 8);
+	}
+}
+
+/**
+ * @brief Reads the header of an image the fast path can decode.
+ */
+bool TgaDecoder::readHeader(const unsigned char* file, size_t size, int& width, int& height)
+{
+	if (file == NULL || size < HEADER_SIZE)
+		return false;
+
+	const int colourMapType = file[1];
+	const int imageType = file[2];
+	const int bitsPerPixel = file[16];
+	const int descriptor = file[17];
+
+	if (colourMapType != 0 ||
+		(imageType != TYPE_TRUE_COLOUR && imageType != TYPE_TRUE_COLOUR_RLE) ||
+		(bitsPerPixel != 24 && bitsPerPixel != 32) ||
+		(descriptor & ORIGIN_RIGHT) != 0)
+		return false;
+
+	width = readShort(file + 12);
+	height = readShort(file + 14);
+	return width > 0 && height > 0;
+}
+
+/**
+ * @brief Decodes an image accepted by readHeader().
+ *
+ * Raw runs of pixels go through the SIMD conversion a row segment at a time, RLE repeats are
+ * converted once and replicated. Packets may cross rows, as the format allows.
+ */
+bool TgaDecoder::decode(const unsigned char* file, size_t size, unsigned char* rgba)
+{
+	int width = 0, height = 0;
+	if (rgba == NULL || !readHeader(file, size, width, height))
+		return false;
+
+	const bool rle = file[2] == TYPE_TRUE_COLOUR_RLE;
+	const size_t bytesPerPixel = file[16] / 8;
+	const bool flip = (file[17] & ORIGIN_TOP) == 0;
+	const ConvertFunction convert = bytesPerPixel == 4 ? kernels().from32 : kernels().from24;
+
+	const unsigned char* in = file + HEADER_SIZE + file[0];
+	const unsigned char* end = file + size;
+	if (in > end)
+		return false;
+
+	const size_t rowBytes = (size_t)width * 4;
+
+	if (!rle)
+	{
+		if ((size_t)(end - in) < (size_t)width * height * bytesPerPixel)
+			return false;
+
+		for (int y = 0; y < height; y++, in += width * bytesPerPixel)
+			convert(in, rgba + (size_t)(flip ? height - 1 - y : y) * rowBytes, (size_t)width);
+		return true;
+	}
+
+	const size_t total = (size_t)width * height;
+	size_t pixel = 0;
+
+	while (pixel < total)
+	{
+		if (in >= end)
+			return false;
+
+		const unsigned header = *in++;
+		size_t count = (header & 0x7F) + 1;
+		if (count > total - pixel)
+			count = total - pixel;
+
+		if (header & 0x80)
+		{
+			// Repeat packet, one pixel
+			if ((size_t)(end - in) < bytesPerPixel)
+				return false;
+
+			unsigned char value[4];
+			value[0] = in[2];
+			value[1] = in[1];
+			value[2] = in[0];
+			value[3] = bytesPerPixel == 4 ? in[3] : 255;
+			in += bytesPerPixel;
+
+			while (count > 0)
+			{
+				const size_t y = pixel / width;
+				const size_t x = pixel % width;
+				const size_t span = count < width - x ? count : width - x;
+				unsigned char* out = rgba + (flip ? height - 1 - y : y) * rowBytes + x * 4;
+
+				for (size_t i = 0; i < span; i++)
+					memcpy(out + i * 4, value, 4);
+
+				pixel += span;
+				count -= span;
+			}
+		}
+		else
+		{
+			// Raw packet, count pixels
+			if ((size_t)(end - in) < count * bytesPerPixel)
+				return false;
+
+			while (count > 0)
+			{
+				const size_t y = pixel / width;
+				const size_t x = pixel % width;
+				const size_t span = count < width - x ? count : width - x;
+
+				convert(in, rgba + (flip ? height - 1 - y : y) * rowBytes + x * 4, span);
+
+				in += span * bytesPerPixel;
+				pixel += span;
+				count -= span;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Decodes any image in memory to RGBA8, through the fast path when possible.
+ */
+bool TgaDecoder::load(const unsigned char* file, size_t size, std::vector<unsigned char>& rgba, int& width, int& height)
+{
+	if (readHeader(file, size, width, height))
+	{
+		rgba.resize((size_t)width * height * 4);
+		if (decode(file, size, &rgba[0]))
+			return true;
+	}
+
+	// Not a format the fast path handles, or damaged: let stb decide
+	int components = 0;
+	unsigned char* pixels = stbi_load_from_memory(file, (int)size, &width, &height, &components, 4);
+	if (pixels == NULL)
+		return false;
+
+	rgba.assign(pixels, pixels + (size_t)width * height * 4);
+	stbi_image_free(pixels);
+	return true;
+}
+
+/**
+ * @brief Maps an image file and decodes it to RGBA8, through the fast path when possible.
+ */
+bool TgaDecoder::load(const std::string& filename, std::vector<unsigned char>& rgba, int& width, int& height)
+{
+	MappedFile file;
+	if (!file.open(filename))
+		return false;
+
+	return load(file.getData(), file.getSize(), rgba, width, height);
+}
+
+/**
+ * @brief Getter method for the name of the conversion kernel in use.
+ */
+const char* TgaDecoder::getKernelName() { return kernels().name; }
@@ -0,0 +1,157 @@
+/**
+ * @file cooker.cpp
+ * @brief Command line tool cooking textures into GPU-ready mip chains.
+ *
+ * Usage: cooker [-bc] [-kaiser] <texture directory>
+ * Every image in the directory is written next to itself as image + ".mip" with its full mip chain, and
+ * the scene atlas is cooked to its cache. With -bc the chains are block compressed (BC1, or BC3 for
+ * images with alpha). The game picks cooked chains up automatically while their source is unchanged.
+ */
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <./include/stb_image.h>
+
+#include <ctype.h>	  // tolower
+#include <dirent.h>	  // Directory listing
+#include <stdio.h>	  // remove
+#include <string.h>	  // strcmp
+#include <sys/stat.h> // File type
+#include <algorithm>  // std::sort
+#include <iostream>	  // Console output
+#include <string>
+#include <vector>
+
+#include <./include/AssetPack.h>
+#include <./include/SceneTextures.h>
+#include <./include/Texture.h>
+#include <./include/TextureAtlas.h>
+#include <./include/TgaDecoder.h>
+
+using namespace std;
+using namespace gpp;
+
+/**
+ * @brief Recursively lists the images under a directory, skipping hidden entries and cooked files.
+ */
+static void listImages(const string& directory, vector<string>& files)
+{
+	DIR* dir = opendir(directory.c_str());
+	if (dir == NULL)
+		return;
+
+	while (struct dirent* entry = readdir(dir))
+	{
+		string name = entry->d_name;
+		if (name.empty() || name[0] == '.')
+			continue;
+
+		string path = directory + "/" + name;
+		struct stat info;
+		if (stat(path.c_str(), &info) != 0)
+			continue;
+
+		if (S_ISDIR(info.st_mode))
+		{
+			listImages(path, files);
+			continue;
+		}
+
+		size_t dot = name.find_last_of('.');
+		string extension = dot == string::npos ? "" : name.substr(dot);
+		for (size_t i = 0; i < extension.size(); i++)
+			extension[i] = (char)tolower(extension[i]);
+
+		if (extension == ".tga" || extension == ".png" || extension == ".jpg" || extension == ".bmp")
+			files.push_back(path);
+	}
+	closedir(dir);
+}
+
+static const char* formatName(TEXTURE_FORMAT format)
+{
+	switch (format)
+	{
+	case TEXTURE_FORMAT::BC1:
+		return "BC1";
+	case TEXTURE_FORMAT::BC3:
+		return "BC3";
+	default:
+		return "RGBA8";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool compress = false;
+	MIP_FILTER filter = MIP_FILTER::BOX;
+	string directory;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-bc") == 0)
+			compress = true;
+		else if (strcmp(argv[i], "-kaiser") == 0)
+			filter = MIP_FILTER::KAISER;
+		else
+			directory = argv[i];
+	}
+
+	if (directory.empty())
+	{
+		cerr << "Usage: cooker [-bc] [-kaiser] <texture directory>" << endl;
+		return 1;
+	}
+
+	vector<string> images;
+	listImages(directory, images);
+	sort(images.begin(), images.end());
+
+	int failed = 0;
+	vector<unsigned char> rgba;
+
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		int width = 0, height = 0;
+		if (!TgaDecoder::load(images[i], rgba, width, height))
+		{
+			cerr << "Not decoded: " << images[i] << endl;
+			failed++;
+			continue;
+		}
+
+		MipChain mips;
+		mips.build(&rgba[0], width, height, filter);
+		if (compress)
+			mips.compress(mips.hasAlpha() ? TEXTURE_FORMAT::BC3 : TEXTURE_FORMAT::BC1);
+
+		const string cooked = images[i] + ".mip";
+		if (!mips.saveCache(cooked, AssetPack::getFileStamp(images[i])))
+		{
+			cerr << "Not written: " << cooked << endl;
+			failed++;
+			continue;
+		}
+
+		cout << cooked << " " << width << "x" << height << " " << mips.getLevelCount() << " levels "
+			 << formatName(mips.getFormat()) << " " << mips.getByteSize() << " bytes" << endl;
+	}
+
+	// The scene atlas, rebuilt from scratch so the requested format is used
+	TextureAtlas atlas;
+	atlas.setLayers(vector<string>(SCENE_TEXTURES, SCENE_TEXTURES + SCENE_TEXTURE_COUNT));
+	remove(ATLAS_CACHE);
+
+	MipChain mips;
+	if (atlas.build(ATLAS_CACHE, NULL, mips, compress))
+	{
+		cout << ATLAS_CACHE << " " << mips.getWidth(0) << "x" << mips.getHeight(0) << " " << mips.getLevelCount() << " levels "
+			 << formatName(mips.getFormat()) << " " << mips.getByteSize() << " bytes" << endl;
+	}
+	else
+	{
+		cerr << "Not cooked: " << ATLAS_CACHE << endl;
+		failed++;
+	}
+
+	return failed == 0 ? 0 : 1;
+}
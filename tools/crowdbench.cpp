@@ -0,0 +1,96 @@
+/**
+ * @file crowdbench.cpp
+ * @brief Benchmark of the Crowd update throughput.
+ *
+ * Usage: crowdbench [max workers] [updates]
+ * Scatters 10k to 100k agents over a generated 201 x 201 maze, sends them to its centre and times the
+ * updates at 60 Hz with 1, 2, 4, ... workers up to the hardware thread count (or the given maximum).
+ * Reports the time per update and the agents updated per millisecond.
+ */
+
+#include <chrono>	// Timing
+#include <iomanip>	// Output formatting
+#include <iostream> // Console output
+#include <stdlib.h> // atoi
+#include <thread>	// hardware_concurrency
+#include <vector>
+
+#include <./include/CollectibleStore.h>
+#include <./include/Crowd.h>
+#include <./include/Maze.h>
+
+using namespace std;
+using namespace gpp;
+
+typedef chrono::high_resolution_clock BenchClock;
+
+static double millisecondsSince(const BenchClock::time_point& start)
+{
+	return chrono::duration<double, milli>(BenchClock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	const unsigned hardware = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+	unsigned maxWorkers = argc > 1 ? (unsigned)atoi(argv[1]) : hardware;
+	int updates = argc > 2 ? atoi(argv[2]) : 60;
+	if (maxWorkers < 1)
+		maxWorkers = 1;
+	if (updates < 1)
+		updates = 1;
+
+	const int MAZE_SIZE = 201;
+	const int WARM_UP = 10; // Updates before timing, so agents have left their spawn points
+	const float STEP = 1.0f / 60.0f;
+	const size_t counts[] = { 10000, 50000, 100000 };
+
+	Maze maze;
+	maze.generate(MAZE_SIZE, MAZE_SIZE);
+	const vector<vector<int>>& grid = maze.getMaze();
+	const glm::vec3 goal(MAZE_SIZE / 2 + 0.5f, 0.0f, MAZE_SIZE / 2 + 0.5f);
+
+	cout << hardware << " hardware threads, " << MAZE_SIZE << " x " << MAZE_SIZE << " maze, " << updates << " updates" << endl;
+	cout << left << setw(10) << "agents" << right << setw(9) << "workers" << setw(14) << "ms/update" << setw(14) << "agents/ms"
+		 << setw(10) << "speedup" << endl;
+
+	for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+	{
+		vector<glm::vec3> positions;
+		CollectibleStore::scatter(grid, counts[c], 0.2f, 1, positions);
+
+		double baseline = 0.0;
+		for (unsigned workers = 1;; workers = workers * 2 < maxWorkers ? workers * 2 : maxWorkers)
+		{
+			JobSystem jobs(workers > 1 ? workers - 1 : 1); // Unused with one worker
+
+			// Every fiftieth agent is a boss
+			Crowd crowd;
+			crowd.setGrid(grid);
+			crowd.reserve(positions.size());
+			for (size_t i = 0; i < positions.size(); i++)
+				crowd.add(positions[i], i % 50 == 0 ? TYPE::BOSS : TYPE::NPC, i % 50 == 0 ? 1.0f : 1.5f);
+			crowd.setGoal(goal);
+
+			JobSystem* workerJobs = workers > 1 ? &jobs : NULL;
+			for (int i = 0; i < WARM_UP; i++)
+				crowd.update(STEP, workerJobs);
+
+			BenchClock::time_point start = BenchClock::now();
+			for (int i = 0; i < updates; i++)
+				crowd.update(STEP, workerJobs);
+			const double perUpdate = millisecondsSince(start) / updates;
+
+			if (workers == 1)
+				baseline = perUpdate;
+
+			cout << left << setw(10) << crowd.size() << right << setw(9) << workers << fixed << setprecision(3) << setw(14)
+				 << perUpdate << setw(14) << setprecision(0) << crowd.size() / perUpdate << setw(10) << setprecision(2)
+				 << baseline / perUpdate << endl;
+
+			if (workers == maxWorkers)
+				break;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file jobbench.cpp
+ * @brief Benchmark of the JobSystem scaling with the number of workers.
+ *
+ * Usage: jobbench [max workers] [iterations]
+ * Runs three parallelFor() loops with 1, 2, 4, ... workers up to the hardware thread count (or the
+ * given maximum): a compute bound loop, the MVP update of 1M matrices (memory bound) and 1M empty
+ * single item ranges (scheduling overhead). Reports the best time of each and the speedup over one
+ * worker, which calls the range function for each range in turn without the scheduler.
+ */
+
+#include <chrono>	// Timing
+#include <iomanip>	// Output formatting
+#include <iostream> // Console output
+#include <math.h>	// sqrtf
+#include <stdlib.h> // atoi
+#include <thread>	// hardware_concurrency
+#include <vector>
+
+#include <./include/JobSystem.h>
+#include <./include/MatrixBatch.h>
+
+using namespace std;
+using namespace gpp;
+
+typedef chrono::high_resolution_clock BenchClock;
+
+static double millisecondsSince(const BenchClock::time_point& start)
+{
+	return chrono::duration<double, milli>(BenchClock::now() - start).count();
+}
+
+struct Workload
+{
+	const char* name;
+	size_t count;
+	size_t grain;
+	JobSystem::RangeFunction fn;
+};
+
+int main(int argc, char** argv)
+{
+	const unsigned hardware = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+	unsigned maxWorkers = argc > 1 ? (unsigned)atoi(argv[1]) : hardware;
+	int iterations = argc > 2 ? atoi(argv[2]) : 5;
+	if (maxWorkers < 1)
+		maxWorkers = 1;
+	if (iterations < 1)
+		iterations = 1;
+
+	// Compute bound: a short iteration per item, no shared memory traffic
+	const size_t computeCount = 1 << 22;
+	vector<float> computeResults(computeCount);
+
+	// Memory bound: the MVP update
+	const size_t matrixCount = 1000000;
+	vector<glm::mat4> models(matrixCount, glm::mat4(1.0f)), mvps(matrixCount);
+	const glm::mat4 viewProjection(2.0f);
+
+	vector<Workload> workloads;
+	Workload compute = { "compute", computeCount, 4096, [&](size_t begin, size_t end, unsigned)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				float x = (float)i;
+				for (int k = 0; k < 32; k++)
+					x = sqrtf(x * 0.5f + (float)k);
+				computeResults[i] = x;
+			}
+		} };
+	Workload matrices = { "mvp", matrixCount, 4096, [&](size_t begin, size_t end, unsigned)
+		{ MatrixBatch::multiply(viewProjection, &models[begin], &mvps[begin], end - begin); } };
+	Workload empty = { "empty", 1000000, 1, [](size_t, size_t, unsigned) {} };
+	workloads.push_back(compute);
+	workloads.push_back(matrices);
+	workloads.push_back(empty);
+
+	cout << hardware << " hardware threads, best of " << iterations << " runs" << endl;
+	cout << left << setw(10) << "workload" << right << setw(9) << "workers" << setw(12) << "ms" << setw(10) << "speedup"
+		 << setw(12) << "efficiency" << endl;
+
+	vector<double> baseline(workloads.size(), 0.0);
+	for (unsigned workers = 1;; workers = workers * 2 < maxWorkers ? workers * 2 : maxWorkers)
+	{
+		const bool serial = workers == 1;
+		JobSystem jobs(serial ? 1 : workers - 1); // Unused with one worker
+
+		for (size_t w = 0; w < workloads.size(); w++)
+		{
+			const Workload& workload = workloads[w];
+			double best = 1e30;
+			for (int i = 0; i < iterations; i++)
+			{
+				BenchClock::time_point start = BenchClock::now();
+				if (serial)
+				{
+					for (size_t begin = 0; begin < workload.count; begin += workload.grain)
+						workload.fn(begin, min(begin + workload.grain, workload.count), 0);
+				}
+				else
+				{
+					jobs.parallelFor(workload.count, workload.grain, workload.fn);
+				}
+				best = min(best, millisecondsSince(start));
+			}
+
+			if (serial)
+				baseline[w] = best;
+
+			const double speedup = baseline[w] / best;
+			cout << left << setw(10) << workload.name << right << setw(9) << workers << fixed << setprecision(3) << setw(12)
+				 << best << setw(10) << setprecision(2) << speedup << setw(11) << setprecision(0) << speedup / workers * 100.0
+				 << "%" << endl;
+		}
+
+		if (workers == maxWorkers)
+			break;
+	}
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file levelbuild.cpp
+ * @brief Command line tool writing a level file: a generated maze, its collectibles and the player spawn.
+ *
+ * Usage: levelbuild <level file> [width height [collectibles]]
+ * Without a collectible count the four points of the original scene are placed, otherwise that many
+ * points are scattered over the free cells with a Poisson-disk distribution (same seed, same level). The written level is opened again
+ * and the time it takes is printed.
+ */
+
+#include <stdlib.h> // strtol
+#include <string.h> // strncpy
+#include <chrono>	// Open timing
+#include <iostream> // Console output
+#include <string>
+#include <vector>
+
+#include <./include/CollectibleStore.h>
+#include <./include/Level.h>
+#include <./include/Maze.h>
+
+using namespace std;
+using namespace gpp;
+
+/**
+ * @brief Adds an object type to a level.
+ *
+ * @return Index of the type.
+ */
+static uint32_t addType(LevelData& level, const char* name, float size)
+{
+	LevelObjectType type = {};
+	strncpy(type.name, name, sizeof(type.name) - 1);
+	type.size = size;
+	level.types.push_back(type);
+	return (uint32_t)level.types.size() - 1;
+}
+
+static void addCollectible(LevelData& level, uint32_t type, float x, float y, float z)
+{
+	LevelCollectible collectible = { { x, y, z }, type };
+	level.collectibles.push_back(collectible);
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 2 && argc != 4 && argc != 5)
+	{
+		cerr << "Usage: levelbuild <level file> [width height [collectibles]]" << endl;
+		return 1;
+	}
+
+	const int width = argc >= 4 ? (int)strtol(argv[2], NULL, 10) : 10;
+	const int height = argc >= 4 ? (int)strtol(argv[3], NULL, 10) : 10;
+	const long count = argc == 5 ? strtol(argv[4], NULL, 10) : -1;
+	if (width < 3 || height < 3)
+	{
+		cerr << "Maze must be at least 3 x 3" << endl;
+		return 1;
+	}
+
+	LevelData level;
+	level.width = (uint32_t)width;
+	level.height = (uint32_t)height;
+
+	Maze maze(width, height);
+	const vector<vector<int>>& grid = maze.getMaze();
+	level.cells.resize((size_t)width * height);
+	for (int x = 0; x < width; x++)
+	{
+		for (int y = 0; y < height; y++)
+			level.cells[(size_t)x * height + y] = (uint8_t)grid[x][y];
+	}
+
+	const uint32_t player = addType(level, "player", 0.5f);
+	const uint32_t point = addType(level, "point", 0.5f);
+
+	LevelSpawn spawn = { { 1.0f, 0.0f, 1.0f }, player };
+	level.spawns.push_back(spawn);
+
+	if (count < 0)
+	{
+		addCollectible(level, point, 1.0f, 0.0f, -5.0f);
+		addCollectible(level, point, -2.0f, 1.0f, -3.0f);
+		addCollectible(level, point, 0.0f, -1.0f, -7.0f);
+		addCollectible(level, point, 2.0f, 2.0f, -4.0f);
+	}
+	else
+	{
+		vector<glm::vec3> positions;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		CollectibleStore::scatter(grid, (size_t)count, 0.25f, 1, positions);
+		const double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		cout << positions.size() << " collectibles placed in " << milliseconds << " ms" << endl;
+
+		level.collectibles.reserve(positions.size());
+		for (size_t i = 0; i < positions.size(); i++)
+			addCollectible(level, point, positions[i].x, positions[i].y, positions[i].z);
+	}
+
+	if (!Level::write(argv[1], level))
+	{
+		cerr << "Not written: " << argv[1] << endl;
+		return 1;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Level written;
+	const bool opened = written.open(argv[1]);
+	const double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	if (!opened)
+	{
+		cerr << "Not readable: " << argv[1] << endl;
+		return 1;
+	}
+
+	cout << argv[1] << " " << width << "x" << height << " maze, " << written.getCollectibleCount() << " collectibles, "
+		 << written.getSpawnCount() << " spawns, opened in " << milliseconds << " ms" << endl;
+	return 0;
+}
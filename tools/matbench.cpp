@@ -0,0 +1,110 @@
+/**
+ * @file matbench.cpp
+ * @brief Benchmark of the MatrixBatch kernels against plain glm.
+ *
+ * Usage: matbench [iterations]
+ * Multiplies a view projection by 1k to 1M model matrices (the MVP update) with a glm loop and with
+ * every kernel the CPU supports, checks the results agree and reports the best time of each.
+ */
+
+#include <chrono>	// Timing
+#include <iomanip>	// Output formatting
+#include <iostream> // Console output
+#include <math.h>	// fabs
+#include <stdlib.h> // atoi, rand
+#include <vector>
+
+#include <./include/MatrixBatch.h>
+
+using namespace std;
+using namespace gpp;
+
+typedef chrono::high_resolution_clock BenchClock;
+
+static double millisecondsSince(const BenchClock::time_point& start)
+{
+	return chrono::duration<double, milli>(BenchClock::now() - start).count();
+}
+
+static float randomFloat()
+{
+	return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static glm::mat4 randomMatrix()
+{
+	glm::mat4 m;
+	for (int c = 0; c < 4; c++)
+		for (int r = 0; r < 4; r++)
+			m[c][r] = randomFloat();
+	return m;
+}
+
+// Largest difference between two arrays of matrices
+static float maximumError(const vector<glm::mat4>& a, const vector<glm::mat4>& b)
+{
+	float error = 0.0f;
+	for (size_t i = 0; i < a.size(); i++)
+		for (int c = 0; c < 4; c++)
+			for (int r = 0; r < 4; r++)
+				error = max(error, (float)fabs(a[i][c][r] - b[i][c][r]));
+	return error;
+}
+
+int main(int argc, char** argv)
+{
+	int iterations = argc > 1 ? atoi(argv[1]) : 10;
+	if (iterations < 1)
+		iterations = 1;
+
+	const MATRIX_KERNEL kernels[] = { MATRIX_KERNEL::SSE4, MATRIX_KERNEL::AVX2, MATRIX_KERNEL::AVX2_FMA };
+	const size_t counts[] = { 1000, 10000, 100000, 1000000 };
+
+	cout << "Best kernel: " << MatrixBatch::getKernelName(MatrixBatch::getBestKernel()) << ", best of " << iterations << " runs" << endl;
+	cout << left << setw(10) << "matrices" << setw(10) << "kernel" << right << setw(12) << "ms" << setw(14) << "Mmatrix/s"
+		 << setw(10) << "speedup" << setw(12) << "max error" << endl;
+
+	const glm::mat4 viewProjection = randomMatrix();
+
+	for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+	{
+		const size_t count = counts[c];
+		vector<glm::mat4> models(count), expected(count), results(count);
+		for (size_t i = 0; i < count; i++)
+			models[i] = randomMatrix();
+
+		// Plain glm, as the MVP update did before
+		double glmBest = 1e30;
+		for (int i = 0; i < iterations; i++)
+		{
+			BenchClock::time_point start = BenchClock::now();
+			for (size_t m = 0; m < count; m++)
+				expected[m] = viewProjection * models[m];
+			glmBest = min(glmBest, millisecondsSince(start));
+		}
+
+		cout << left << setw(10) << count << setw(10) << "glm" << right << fixed << setprecision(3) << setw(12) << glmBest
+			 << setw(14) << count / glmBest / 1000.0 << setw(10) << "1.00" << setw(12) << "-" << endl;
+
+		for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+		{
+			if (!MatrixBatch::setKernel(kernels[k]))
+				continue;
+
+			double best = 1e30;
+			for (int i = 0; i < iterations; i++)
+			{
+				BenchClock::time_point start = BenchClock::now();
+				MatrixBatch::multiply(viewProjection, &models[0], &results[0], count);
+				best = min(best, millisecondsSince(start));
+			}
+
+			cout << left << setw(10) << count << setw(10) << MatrixBatch::getKernelName() << right << setprecision(3) << setw(12) << best
+				 << setw(14) << count / best / 1000.0 << setw(10) << setprecision(2) << glmBest / best
+				 << setw(12) << scientific << setprecision(1) << maximumError(expected, results) << fixed << endl;
+		}
+	}
+
+	MatrixBatch::setKernel(MatrixBatch::getBestKernel());
+	return 0;
+}
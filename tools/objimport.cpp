@@ -0,0 +1,193 @@
+/**
+ * @file objimport.cpp
+ * @brief Command line tool converting Wavefront OBJ models into the binary mesh format.
+ *
+ * Usage: objimport <model.obj> <model.mesh>
+ * Polygons are triangulated as fans and identical position/uv/normal corners are shared. Missing normals
+ * are generated from the faces, vertex colours ("v x y z r g b") are kept when present. Texture v is
+ * flipped, as images are uploaded top row first.
+ */
+
+#include <stdlib.h> // strtol
+#include <fstream>	// Reading the model
+#include <iostream> // Console output
+#include <map>		// Corner sharing
+#include <sstream>	// Line parsing
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <./include/MeshFile.h>
+
+using namespace std;
+using namespace gpp;
+
+typedef tuple<int, int, int> Corner; // Position, uv, normal (0 based, -1 if absent)
+
+/**
+ * @brief Resolves a 1 based (or negative, relative) OBJ index.
+ *
+ * @return The 0 based index, -1 if absent or out of range.
+ */
+static int resolve(const string& token, size_t count)
+{
+	if (token.empty())
+		return -1;
+
+	long index = strtol(token.c_str(), NULL, 10);
+	long resolved = index < 0 ? (long)count + index : index - 1;
+	return resolved >= 0 && resolved < (long)count ? (int)resolved : -1;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		cerr << "Usage: objimport <model.obj> <model.mesh>" << endl;
+		return 1;
+	}
+
+	ifstream input(argv[1]);
+	if (!input)
+	{
+		cerr << "Not read: " << argv[1] << endl;
+		return 1;
+	}
+
+	vector<glm::vec3> positions;
+	vector<glm::vec4> colours;
+	vector<glm::vec2> uvs;
+	vector<glm::vec3> normals;
+	bool hasColours = false;
+
+	vector<MeshVertex> vertices;
+	vector<uint32_t> indices;
+	map<Corner, uint32_t> corners;
+	bool hasUVs = false, hasNormals = true;
+
+	string line;
+	size_t lineNumber = 0;
+	while (getline(input, line))
+	{
+		lineNumber++;
+		istringstream stream(line);
+		string keyword;
+		stream >> keyword;
+
+		if (keyword == "v")
+		{
+			glm::vec3 position(0.0f);
+			glm::vec4 colour(1.0f);
+			stream >> position.x >> position.y >> position.z;
+			if (stream >> colour.x >> colour.y >> colour.z)
+				hasColours = true;
+			positions.push_back(position);
+			colours.push_back(colour);
+		}
+		else if (keyword == "vt")
+		{
+			glm::vec2 uv(0.0f);
+			stream >> uv.x >> uv.y;
+			uvs.push_back(glm::vec2(uv.x, 1.0f - uv.y));
+		}
+		else if (keyword == "vn")
+		{
+			glm::vec3 normal(0.0f);
+			stream >> normal.x >> normal.y >> normal.z;
+			normals.push_back(normal);
+		}
+		else if (keyword == "f")
+		{
+			vector<uint32_t> polygon;
+			string token;
+			while (stream >> token)
+			{
+				// p, p/t, p//n or p/t/n
+				string parts[3];
+				size_t part = 0;
+				for (size_t i = 0; i < token.size(); i++)
+				{
+					if (token[i] == '/')
+						part = part < 2 ? part + 1 : part;
+					else
+						parts[part] += token[i];
+				}
+
+				Corner corner(resolve(parts[0], positions.size()), resolve(parts[1], uvs.size()), resolve(parts[2], normals.size()));
+				if (get<0>(corner) < 0)
+				{
+					cerr << argv[1] << ":" << lineNumber << ": bad face index " << token << endl;
+					return 1;
+				}
+
+				map<Corner, uint32_t>::iterator shared = corners.find(corner);
+				if (shared == corners.end())
+				{
+					MeshVertex vertex;
+					vertex.position = positions[get<0>(corner)];
+					vertex.colour = colours[get<0>(corner)];
+					vertex.uv = get<1>(corner) >= 0 ? uvs[get<1>(corner)] : glm::vec2(0.0f);
+					vertex.normal = get<2>(corner) >= 0 ? normals[get<2>(corner)] : glm::vec3(0.0f);
+
+					hasUVs = hasUVs || get<1>(corner) >= 0;
+					hasNormals = hasNormals && get<2>(corner) >= 0;
+
+					shared = corners.insert(make_pair(corner, (uint32_t)vertices.size())).first;
+					vertices.push_back(vertex);
+				}
+				polygon.push_back(shared->second);
+			}
+
+			for (size_t i = 2; i < polygon.size(); i++)
+			{
+				indices.push_back(polygon[0]);
+				indices.push_back(polygon[i - 1]);
+				indices.push_back(polygon[i]);
+			}
+		}
+	}
+
+	if (indices.empty())
+	{
+		cerr << "No faces: " << argv[1] << endl;
+		return 1;
+	}
+
+	// Area weighted face normals, summed over the triangles sharing each vertex (normalised when written)
+	if (!hasNormals)
+	{
+		for (size_t i = 0; i < vertices.size(); i++)
+			vertices[i].normal = glm::vec3(0.0f);
+
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			MeshVertex& a = vertices[indices[i]];
+			MeshVertex& b = vertices[indices[i + 1]];
+			MeshVertex& c = vertices[indices[i + 2]];
+			glm::vec3 normal = glm::cross(b.position - a.position, c.position - a.position);
+			a.normal += normal;
+			b.normal += normal;
+			c.normal += normal;
+		}
+	}
+
+	uint32_t attributes = (uint32_t)MESH_ATTRIBUTE::POSITION | (uint32_t)MESH_ATTRIBUTE::NORMAL;
+	if (hasUVs)
+		attributes |= (uint32_t)MESH_ATTRIBUTE::UV;
+	if (hasColours)
+		attributes |= (uint32_t)MESH_ATTRIBUTE::COLOUR;
+
+	if (!MeshFile::write(argv[2], vertices, indices, attributes))
+	{
+		cerr << "Not written: " << argv[2] << endl;
+		return 1;
+	}
+
+	const size_t stride = MeshFile::getStride(attributes);
+	const size_t indexSize = vertices.size() <= 65536 ? 2 : 4;
+	const size_t floatStride = sizeof(float) * (3 + 3 + (hasUVs ? 2 : 0) + (hasColours ? 4 : 0));
+	cout << argv[2] << " " << vertices.size() << " vertices " << indices.size() / 3 << " triangles, "
+		 << stride << " bytes per vertex (" << floatStride << " as floats), " << indexSize * 8 << " bit indices" << endl;
+
+	return 0;
+}
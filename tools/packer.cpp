@@ -0,0 +1,71 @@
+/**
+ * @file packer.cpp
+ * @brief Command line tool combining a directory of assets into a single pack file.
+ *
+ * Usage: packer <asset directory> <pack file>
+ * Assets are stored under their path as given, e.g. "assets/textures/grid.tga".
+ */
+
+#include <dirent.h>	  // Directory listing
+#include <sys/stat.h> // File type
+#include <algorithm>  // std::sort
+#include <iostream>	  // Console output
+#include <string>
+#include <vector>
+
+#include <./include/AssetPack.h>
+
+using namespace std;
+using namespace gpp;
+
+/**
+ * @brief Recursively lists the regular files under a directory, skipping hidden entries.
+ */
+static void listFiles(const string& directory, vector<string>& files)
+{
+	DIR* dir = opendir(directory.c_str());
+	if (dir == NULL)
+		return;
+
+	while (struct dirent* entry = readdir(dir))
+	{
+		string name = entry->d_name;
+		if (name.empty() || name[0] == '.')
+			continue;
+
+		string path = directory + "/" + name;
+		struct stat info;
+		if (stat(path.c_str(), &info) != 0)
+			continue;
+
+		if (S_ISDIR(info.st_mode))
+			listFiles(path, files);
+		else if (S_ISREG(info.st_mode))
+			files.push_back(path);
+	}
+	closedir(dir);
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		cerr << "Usage: " << argv[0] << " <asset directory> <pack file>" << endl;
+		return -1;
+	}
+
+	vector<string> files;
+	listFiles(argv[1], files);
+	sort(files.begin(), files.end());
+
+	if (!AssetPack::write(argv[2], files))
+	{
+		cerr << "ERROR: pack not written " << argv[2] << endl;
+		return -1;
+	}
+
+	for (size_t i = 0; i < files.size(); i++)
+		cout << files[i] << endl;
+	cout << files.size() << " assets packed into " << argv[2] << endl;
+	return 0;
+}
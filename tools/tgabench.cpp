@@ -0,0 +1,104 @@
+/**
+ * @file tgabench.cpp
+ * @brief Benchmark of the TGA fast path against stbi_load.
+ *
+ * Usage: tgabench [iterations] [image ...]
+ * Defaults to the scene textures. Each image is decoded with both loaders, the outputs are compared
+ * and the best time of each loader is reported.
+ */
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <./include/stb_image.h>
+
+#include <chrono>	// Timing
+#include <iomanip>	// Output formatting
+#include <iostream> // Console output
+#include <stdlib.h> // atoi
+#include <string.h> // memcmp
+#include <string>
+#include <vector>
+
+#include <./include/TgaDecoder.h>
+
+using namespace std;
+using namespace gpp;
+
+static const char* defaultImages[] = {
+	"./assets/textures/grid.tga",
+	"./assets/textures/coordinates.tga",
+	"./assets/textures/cube.tga",
+	"./assets/textures/grid_wip.tga",
+	"./assets/textures/minecraft.tga",
+	"./assets/textures/texture.tga",
+	"./assets/textures/texture_2.tga",
+	"./assets/textures/uvtemplate.tga",
+};
+
+typedef chrono::high_resolution_clock BenchClock;
+
+static double millisecondsSince(const BenchClock::time_point& start)
+{
+	return chrono::duration<double, milli>(BenchClock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	int iterations = argc > 1 ? atoi(argv[1]) : 20;
+	if (iterations < 1)
+		iterations = 1;
+
+	vector<string> images;
+	for (int i = 2; i < argc; i++)
+		images.push_back(argv[i]);
+	if (images.empty())
+		images.assign(defaultImages, defaultImages + sizeof(defaultImages) / sizeof(defaultImages[0]));
+
+	cout << "Kernel: " << TgaDecoder::getKernelName() << ", best of " << iterations << " runs" << endl;
+	cout << left << setw(36) << "image" << right << setw(12) << "stbi_load" << setw(12) << "fast path" << setw(10) << "speedup" << endl;
+
+	double stbTotal = 0.0, fastTotal = 0.0;
+	bool identical = true;
+	vector<unsigned char> rgba;
+
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		double stbBest = 1e30, fastBest = 1e30;
+		int width = 0, height = 0, components = 0;
+
+		for (int run = 0; run < iterations; run++)
+		{
+			BenchClock::time_point start = BenchClock::now();
+			unsigned char* pixels = stbi_load(images[i].c_str(), &width, &height, &components, 4);
+			double elapsed = millisecondsSince(start);
+			stbBest = elapsed < stbBest ? elapsed : stbBest;
+
+			start = BenchClock::now();
+			int fastWidth = 0, fastHeight = 0;
+			bool loaded = TgaDecoder::load(images[i], rgba, fastWidth, fastHeight);
+			elapsed = millisecondsSince(start);
+			fastBest = elapsed < fastBest ? elapsed : fastBest;
+
+			if (run == 0)
+			{
+				bool same = pixels != NULL && loaded && fastWidth == width && fastHeight == height &&
+							memcmp(pixels, &rgba[0], (size_t)width * height * 4) == 0;
+				if (!same)
+				{
+					cout << "MISMATCH: " << images[i] << endl;
+					identical = false;
+				}
+			}
+			stbi_image_free(pixels);
+		}
+
+		stbTotal += stbBest;
+		fastTotal += fastBest;
+		cout << left << setw(36) << images[i] << right << fixed << setprecision(3)
+			 << setw(10) << stbBest << "ms" << setw(10) << fastBest << "ms" << setw(9) << stbBest / fastBest << "x" << endl;
+	}
+
+	cout << left << setw(36) << "total" << right << fixed << setprecision(3)
+		 << setw(10) << stbTotal << "ms" << setw(10) << fastTotal << "ms" << setw(9) << stbTotal / fastTotal << "x" << endl;
+
+	return identical ? 0 : 1;
+}